@@ -1,215 +1,433 @@
-#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include "animations.h"
+#include "ssd1306_gfx.h"
+#include "trig.h"
+#include "particles.h"
 #include "esp_log.h"
 #include "esp_random.h"
 
 static const char *TAG = "ANIMATIONS";
 
-static animation_type_t current_anim = ANIM_BOUNCING_BALL;
-
-// Bouncing ball state
+// Bouncing ball
 typedef struct {
     float x, y;
     float vx, vy;
-} ball_t;
+} ball_state_t;
 
-static ball_t ball;
+static const uint8_t ball_sprite_data[] = {0x07, 0x07, 0x07};
+static const ssd1306_bitmap_t ball_sprite = {
+    .width = 3,
+    .height = 3,
+    .data = ball_sprite_data,
+};
 
-// Starfield state
-#define MAX_STARS 20
-typedef struct {
-    int x, y;
-    int speed;
-} star_t;
+static void ball_init(void *state)
+{
+    ball_state_t *ball = state;
+    
+    ball->x = 64;
+    ball->y = 32;
+    ball->vx = 2.5;
+    ball->vy = 1.8;
+}
 
-static star_t stars[MAX_STARS];
+static void ball_step(void *state)
+{
+    ball_state_t *ball = state;
+    
+    // Update position
+    ball->x += ball->vx;
+    ball->y += ball->vy;
+    
+    // Bounce off walls
+    if (ball->x <= 2 || ball->x >= 125) {
+        ball->vx = -ball->vx;
+        ball->x = (ball->x <= 2) ? 2 : 125;
+    }
+    if (ball->y <= 2 || ball->y >= 61) {
+        ball->vy = -ball->vy;
+        ball->y = (ball->y <= 2) ? 2 : 61;
+    }
+}
 
-// Matrix rain state
-#define MAX_DROPS 15
-typedef struct {
-    int x, y;
-    int length;
-    char chars[10];
-} matrix_drop_t;
+static void ball_render(const void *prev, const void *state, uint8_t alpha,
+                        ssd1306_handle_t display, uint32_t time_ms)
+{
+    const ball_state_t *from = prev;
+    const ball_state_t *to = state;
+    float t = alpha / 256.0f;
+    float x = from->x + (to->x - from->x) * t;
+    float y = from->y + (to->y - from->y) * t;
+    
+    // Draw ball (3x3 pixels) centred on its position
+    ssd1306_blit(display, (int)x - 1, (int)y - 1, &ball_sprite, SSD1306_ROP_OR);
+    
+    // Draw walls
+    ssd1306_draw_rectangle(display, 0, 0, 127, 63, 1);
+}
+
+static const animation_def_t ball_animation = {
+    .name = "Bouncing Ball",
+    .state_size = sizeof(ball_state_t),
+    .init = ball_init,
+    .step = ball_step,
+    .render = ball_render,
+};
+
+// Starfield: a particle pool kept at MAX_STARS, drawn with a trail for the fastest stars
+#define MAX_STARS 20
 
-static matrix_drop_t drops[MAX_DROPS];
+static const uint8_t star_glyph_data[] = {0x01, 0x01};
+static const ssd1306_bitmap_t star_glyphs[] = {
+    { .width = 1, .height = 1, .data = star_glyph_data },
+    { .width = 2, .height = 1, .data = star_glyph_data },
+};
 
-esp_err_t animations_init(void)
+static void starfield_spawn(particle_pool_t *pool, int x)
 {
-    animations_reset();
-    ESP_LOGI(TAG, "Animations initialized");
-    return ESP_OK;
+    int i = particles_spawn(pool);
+    if (i < 0) {
+        return;
+    }
+    
+    int speed = (particles_rand(&pool->rng) % 3) + 1;
+    particles_x(pool)[i] = x * PARTICLE_ONE;
+    particles_y(pool)[i] = (particles_rand(&pool->rng) % 64) * PARTICLE_ONE;
+    particles_vx(pool)[i] = -speed * PARTICLE_ONE;
+    particles_glyph(pool)[i] = (speed > 2) ? 1 : 0;
 }
 
-void animations_reset(void)
+static void starfield_init(void *state)
 {
-    // Initialize bouncing ball
-    ball.x = 64;
-    ball.y = 32;
-    ball.vx = 2.5;
-    ball.vy = 1.8;
+    particle_pool_t *pool = state;
     
-    // Initialize starfield
+    particles_init(pool, MAX_STARS, esp_random());
     for (int i = 0; i < MAX_STARS; i++) {
-        stars[i].x = esp_random() % 128;
-        stars[i].y = esp_random() % 64;
-        stars[i].speed = (esp_random() % 3) + 1;
+        starfield_spawn(pool, particles_rand(&pool->rng) % 128);
     }
+}
+
+static void starfield_step(void *state)
+{
+    particle_pool_t *pool = state;
     
-    // Initialize matrix rain
-    for (int i = 0; i < MAX_DROPS; i++) {
-        drops[i].x = esp_random() % 128;
-        drops[i].y = -(esp_random() % 64);
-        drops[i].length = (esp_random() % 5) + 3;
-        
-        for (int j = 0; j < 10; j++) {
-            drops[i].chars[j] = '!' + (esp_random() % 94); // Random ASCII
-        }
+    // Stars that left the screen are culled and replaced at the right edge
+    particles_step(pool);
+    while (pool->count < MAX_STARS) {
+        starfield_spawn(pool, 128);
     }
 }
 
-void animations_set_type(animation_type_t type)
+static void starfield_render(const void *prev, const void *state, uint8_t alpha,
+                             ssd1306_handle_t display, uint32_t time_ms)
 {
-    current_anim = type;
-    animations_reset();
+    particles_render_glyphs(state, display, alpha, star_glyphs, SSD1306_ROP_OR);
 }
 
-static void animate_bouncing_ball(ssd1306_handle_t display, uint32_t frame)
+static const animation_def_t starfield_animation = {
+    .name = "Starfield",
+    .state_size = PARTICLE_POOL_SIZE(MAX_STARS),
+    .init = starfield_init,
+    .step = starfield_step,
+    .render = starfield_render,
+};
+
+// Matrix rain
+#define MAX_DROPS 15
+typedef struct {
+    int x, y;
+    int length;
+    char chars[10];
+} matrix_drop_t;
+
+typedef struct {
+    matrix_drop_t drops[MAX_DROPS];
+    uint32_t rng;
+} matrix_state_t;
+
+static void matrix_init(void *state)
 {
-    // Update position
-    ball.x += ball.vx;
-    ball.y += ball.vy;
-    
-    // Bounce off walls
-    if (ball.x <= 2 || ball.x >= 125) {
-        ball.vx = -ball.vx;
-        ball.x = (ball.x <= 2) ? 2 : 125;
-    }
-    if (ball.y <= 2 || ball.y >= 61) {
-        ball.vy = -ball.vy;
-        ball.y = (ball.y <= 2) ? 2 : 61;
-    }
+    matrix_state_t *matrix = state;
     
-    // Draw ball (3x3 pixels)
-    for (int dx = -1; dx <= 1; dx++) {
-        for (int dy = -1; dy <= 1; dy++) {
-            ssd1306_draw_point(display, (int)ball.x + dx, (int)ball.y + dy, 1);
+    matrix->rng = esp_random() | 1;
+    for (int i = 0; i < MAX_DROPS; i++) {
+        matrix_drop_t *drop = &matrix->drops[i];
+        drop->x = particles_rand(&matrix->rng) % 128;
+        drop->y = -(particles_rand(&matrix->rng) % 64);
+        drop->length = (particles_rand(&matrix->rng) % 5) + 3;
+        
+        for (int j = 0; j < 10; j++) {
+            drop->chars[j] = '!' + (particles_rand(&matrix->rng) % 94); // Random ASCII
         }
     }
-    
-    // Draw walls
-    ssd1306_draw_rectangle(display, 0, 0, 127, 63, 1);
 }
 
-static void animate_starfield(ssd1306_handle_t display, uint32_t frame)
+static void matrix_step(void *state)
 {
-    for (int i = 0; i < MAX_STARS; i++) {
-        // Move star
-        stars[i].x -= stars[i].speed;
-        
-        // Reset star if it goes off screen
-        if (stars[i].x < 0) {
-            stars[i].x = 128;
-            stars[i].y = esp_random() % 64;
-            stars[i].speed = (esp_random() % 3) + 1;
-        }
+    matrix_state_t *matrix = state;
+    
+    for (int i = 0; i < MAX_DROPS; i++) {
+        matrix_drop_t *drop = &matrix->drops[i];
         
-        // Draw star
-        ssd1306_draw_point(display, stars[i].x, stars[i].y, 1);
+        // Move drop down
+        drop->y++;
         
-        // Draw trail for faster stars
-        if (stars[i].speed > 2) {
-            ssd1306_draw_point(display, stars[i].x + 1, stars[i].y, 1);
+        // Reset drop if it goes off screen
+        if (drop->y > 64 + drop->length * 8) {
+            drop->x = particles_rand(&matrix->rng) % 120; // Leave room for characters
+            drop->y = -(particles_rand(&matrix->rng) % 32);
+            drop->length = (particles_rand(&matrix->rng) % 4) + 2;
         }
     }
 }
 
-static void animate_matrix_rain(ssd1306_handle_t display, uint32_t frame)
+static void matrix_render(const void *prev, const void *state, uint8_t alpha,
+                          ssd1306_handle_t display, uint32_t time_ms)
 {
+    const matrix_state_t *matrix = state;
+    
+    // Drops move one pixel per step, so they are drawn at the stepped position.
+    // The flicker is a hash of the step and the cell rather than a random draw,
+    // so it changes at the step rate whatever the frame rate.
+    uint32_t step = time_ms / ANIMATION_STEP_MS;
+    
     for (int i = 0; i < MAX_DROPS; i++) {
-        // Move drop down
-        drops[i].y++;
-        
-        // Reset drop if it goes off screen
-        if (drops[i].y > 64 + drops[i].length * 8) {
-            drops[i].x = esp_random() % 120; // Leave room for characters
-            drops[i].y = -(esp_random() % 32);
-            drops[i].length = (esp_random() % 4) + 2;
-        }
+        const matrix_drop_t *drop = &matrix->drops[i];
         
         // Draw characters in the drop
-        for (int j = 0; j < drops[i].length; j++) {
-            int char_y = drops[i].y - j * 8;
+        for (int j = 0; j < drop->length; j++) {
+            int char_y = drop->y - j * 8;
             if (char_y >= 0 && char_y < 64) {
                 // Brightest character at the head, dimmer towards tail
-                int brightness = (j == 0) ? 1 : (esp_random() % 3 == 0 ? 1 : 0);
+                uint32_t hash = (step * 2654435761u) ^ ((i * 10 + j) * 40503u);
+                int brightness = (j == 0) ? 1 : ((hash >> 16) % 3 == 0 ? 1 : 0);
                 if (brightness) {
-                    char c = drops[i].chars[j % 10];
-                    ssd1306_show_char(display, drops[i].x, char_y, c, 16, 1);
+                    char c = drop->chars[j % 10];
+                    ssd1306_show_char(display, drop->x, char_y, c, 16, 1);
                 }
             }
         }
     }
 }
 
-static void animate_wave(ssd1306_handle_t display, uint32_t frame)
+static const animation_def_t matrix_animation = {
+    .name = "Matrix Rain",
+    .state_size = sizeof(matrix_state_t),
+    .init = matrix_init,
+    .step = matrix_step,
+    .render = matrix_render,
+};
+
+// Fountain: a few hundred particles under gravity, rendered as one batch of points
+#define FOUNTAIN_PARTICLES  192
+#define FOUNTAIN_RATE       7               // Particles emitted per step
+
+static const particle_emitter_t fountain_emitter = {
+    .x = 64 * PARTICLE_ONE,
+    .y = 63 * PARTICLE_ONE,
+    .spread_x = PARTICLE_ONE,
+    .vy = -6 * PARTICLE_ONE,
+    .spread_vx = PARTICLE_ONE + PARTICLE_ONE / 4,
+    .spread_vy = PARTICLE_ONE + PARTICLE_ONE / 2,
+    .life = PARTICLE_LIFE_FOREVER,
+};
+
+static void fountain_init(void *state)
+{
+    particle_pool_t *pool = state;
+    
+    particles_init(pool, FOUNTAIN_PARTICLES, esp_random());
+    pool->ay = PARTICLE_ONE / 2;
+}
+
+static void fountain_step(void *state)
 {
+    particle_pool_t *pool = state;
+    
+    particles_step(pool);
+    particles_emit(pool, &fountain_emitter, FOUNTAIN_RATE);
+}
+
+static void fountain_render(const void *prev, const void *state, uint8_t alpha,
+                            ssd1306_handle_t display, uint32_t time_ms)
+{
+    particles_render_points(state, display, alpha);
+}
+
+static const animation_def_t fountain_animation = {
+    .name = "Fountain",
+    .state_size = PARTICLE_POOL_SIZE(FOUNTAIN_PARTICLES),
+    .init = fountain_init,
+    .step = fountain_step,
+    .render = fountain_render,
+};
+
+// Wave and spiral are pure functions of time and keep no state.
+// Phase steps per column, and phase speeds per millisecond (see trig.h)
+#define WAVE1_STEP          TRIG_PHASE(0.1)
+#define WAVE1_SPEED         TRIG_PHASE(0.002)   // Two columns per 100 ms
+#define WAVE2_STEP          TRIG_PHASE(0.08)
+#define WAVE2_SPEED         TRIG_PHASE(0.0024)  // Three columns per 100 ms
+#define WAVE2_OFFSET        TRIG_PHASE(1.0)
+#define PARTICLE_STEP       TRIG_PHASE(0.15)
+#define PARTICLE_SPEED      TRIG_PHASE(0.0015)  // One column per 100 ms
+#define PARTICLE_OFFSET     TRIG_PHASE(1.0)
+#define SPIRAL_STEP         TRIG_PHASE(0.2)
+#define SPIRAL_STEPS        95              // 0.2 rad steps below three turns
+
+static void wave_render(const void *prev, const void *state, uint8_t alpha,
+                        ssd1306_handle_t display, uint32_t time_ms)
+{
+    uint32_t phase1 = time_ms * WAVE1_SPEED;
+    uint32_t phase2 = time_ms * WAVE2_SPEED + WAVE2_OFFSET;
+    
     for (int x = 0; x < 128; x++) {
-        int y1 = 32 + 20 * sin((x + frame * 2) * 0.1);
-        int y2 = 32 + 15 * sin((x + frame * 3) * 0.08 + 1);
+        int y1 = 32 + trig_mul(20, trig_sin(phase1 >> 16));
+        int y2 = 32 + trig_mul(15, trig_sin(phase2 >> 16));
         
         ssd1306_draw_point(display, x, y1, 1);
         ssd1306_draw_point(display, x, y2, 1);
+        
+        phase1 += WAVE1_STEP;
+        phase2 += WAVE2_STEP;
     }
     
     // Add some floating particles
     for (int i = 0; i < 5; i++) {
-        int x = (frame * 2 + i * 25) % 128;
-        int y = 32 + 10 * sin((x + frame) * 0.15 + i);
+        int x = (time_ms / 50 + i * 25) % 128;
+        uint32_t phase = x * PARTICLE_STEP + time_ms * PARTICLE_SPEED + i * PARTICLE_OFFSET;
+        int y = 32 + trig_mul(10, trig_sin(phase >> 16));
         ssd1306_draw_point(display, x, y, 1);
     }
 }
 
-static void animate_spiral(ssd1306_handle_t display, uint32_t frame)
+static const animation_def_t wave_animation = {
+    .name = "Wave",
+    .render = wave_render,
+};
+
+static void spiral_render(const void *prev, const void *state, uint8_t alpha,
+                          ssd1306_handle_t display, uint32_t time_ms)
 {
-    float center_x = 64;
-    float center_y = 32;
+    // Radius in tenths of a pixel: 0.6 per step plus 0.5 per 100 ms
+    int32_t radius = time_ms / 20;
+    uint32_t phase = 0;
     
-    for (float angle = 0; angle < 6.28 * 3; angle += 0.2) {
-        float radius = angle * 3 + frame * 0.5;
-        if (radius > 40) continue;
-        
-        int x = center_x + radius * cos(angle);
-        int y = center_y + radius * sin(angle);
+    for (int i = 0; i < SPIRAL_STEPS && radius <= 400; i++) {
+        // Centre + radius * cos/sin, truncated towards zero like the old float conversion
+        int x = (640 * 32768 + radius * trig_cos(phase >> 16)) / (10 * 32768);
+        int y = (320 * 32768 + radius * trig_sin(phase >> 16)) / (10 * 32768);
         
         if (x >= 0 && x < 128 && y >= 0 && y < 64) {
             ssd1306_draw_point(display, x, y, 1);
         }
+        
+        radius += 6;
+        phase += SPIRAL_STEP;
     }
 }
 
-void animations_update(ssd1306_handle_t display, uint32_t frame)
-{
-    switch (current_anim) {
-        case ANIM_BOUNCING_BALL:
-            animate_bouncing_ball(display, frame);
-            break;
-        case ANIM_STARFIELD:
-            animate_starfield(display, frame);
-            break;
-        case ANIM_MATRIX_RAIN:
-            animate_matrix_rain(display, frame);
-            break;
-        case ANIM_WAVE:
-            animate_wave(display, frame);
-            break;
-        case ANIM_SPIRAL:
-            animate_spiral(display, frame);
-            break;
-        default:
-            ssd1306_show_string(display, 20, 28, "No Animation", 16, 1);
-            break;
+static const animation_def_t spiral_animation = {
+    .name = "Spiral",
+    .render = spiral_render,
+};
+
+// Registry: a new effect only needs a definition and an entry here
+static const animation_def_t *const registry[ANIM_MAX] = {
+    [ANIM_BOUNCING_BALL]    = &ball_animation,
+    [ANIM_STARFIELD]        = &starfield_animation,
+    [ANIM_MATRIX_RAIN]      = &matrix_animation,
+    [ANIM_WAVE]             = &wave_animation,
+    [ANIM_SPIRAL]           = &spiral_animation,
+    [ANIM_FOUNTAIN]         = &fountain_animation,
+};
+
+const animation_def_t* animations_get(animation_type_t type)
+{
+    return (type < ANIM_MAX) ? registry[type] : NULL;
+}
+
+size_t animations_arena_size(void)
+{
+    size_t size = 0;
+    
+    for (int i = 0; i < ANIM_MAX; i++) {
+        if (registry[i] && ANIMATION_ARENA_SIZE(registry[i]->state_size) > size) {
+            size = ANIMATION_ARENA_SIZE(registry[i]->state_size);
+        }
+    }
+    return size;
+}
+
+esp_err_t animation_start(animation_t *anim, animation_type_t type, void *arena, size_t arena_size)
+{
+    if (anim == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    const animation_def_t *def = animations_get(type);
+    if (def == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    size_t needed = ANIMATION_ARENA_SIZE(def->state_size);
+    if (needed > arena_size || (def->state_size && arena == NULL)) {
+        ESP_LOGE(TAG, "%s needs %u bytes of arena, got %u",
+                 def->name, (unsigned)needed, (unsigned)arena_size);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    anim->def = def;
+    anim->state = arena;
+    // The state size need not be a multiple of the alignment, e.g. an odd particle pool
+    anim->prev = (uint8_t *)arena + (needed - def->state_size);
+    anim->steps = 0;
+    anim->acc_us = 0;
+    if (def->init) {
+        def->init(anim->state);
+    }
+    if (def->state_size) {
+        memcpy(anim->prev, anim->state, def->state_size);
+    }
+    
+    ESP_LOGD(TAG, "Started %s", def->name);
+    return ESP_OK;
+}
+
+uint32_t animation_time_ms(const animation_t *anim)
+{
+    return anim ? anim->steps * ANIMATION_STEP_MS + anim->acc_us / 1000 : 0;
+}
+
+void animation_update(animation_t *anim, ssd1306_handle_t display, uint32_t elapsed_us)
+{
+    const uint32_t step_us = ANIMATION_STEP_MS * 1000;
+    
+    if (anim == NULL || anim->def == NULL) {
+        ssd1306_show_string(display, 20, 28, "No Animation", 16, 1);
+        return;
+    }
+    
+    // After a long stall resume from where it stopped rather than fast-forwarding
+    if (elapsed_us > ANIMATION_MAX_CATCHUP_STEPS * step_us) {
+        elapsed_us = ANIMATION_MAX_CATCHUP_STEPS * step_us;
+    }
+    
+    // Consume the elapsed time in fixed steps, so the state at a given
+    // animation time does not depend on how often frames were drawn
+    anim->acc_us += elapsed_us;
+    while (anim->acc_us >= step_us) {
+        if (anim->def->step) {
+            memcpy(anim->prev, anim->state, anim->def->state_size);
+            anim->def->step(anim->state);
+        }
+        anim->steps++;
+        anim->acc_us -= step_us;
+    }
+    
+    // Draw between the last two states by the fraction of a step left over
+    if (anim->def->render) {
+        uint8_t alpha = (uint64_t)anim->acc_us * 256 / step_us;
+        anim->def->render(anim->prev, anim->state, alpha, display, animation_time_ms(anim));
     }
 }
@@ -1,13 +1,66 @@
 #ifndef ANIMATIONS_H
 #define ANIMATIONS_H
 
+#include <stddef.h>
 #include "ssd1306.h"
 #include "app_config.h"
 
-// Animation API
-esp_err_t animations_init(void);
-void animations_reset(void);
-void animations_set_type(animation_type_t type);
-void animations_update(ssd1306_handle_t display, uint32_t frame);
+/**
+ * @brief Animation definition
+ *
+ * An animation keeps all of its state in an arena supplied by the caller, so
+ * only the running animation occupies memory. step() advances the state by
+ * ANIMATION_STEP_MS of animation time, however often frames are drawn.
+ * render() draws the state alpha/256 of the way from prev to state; stateless
+ * animations use time_ms instead. Any callback may be NULL.
+ */
+typedef struct {
+    const char *name;
+    size_t state_size;
+    void (*init)(void *state);
+    void (*step)(void *state);
+    void (*render)(const void *prev, const void *state, uint8_t alpha,
+                   ssd1306_handle_t display, uint32_t time_ms);
+} animation_def_t;
+
+// A running animation
+typedef struct {
+    const animation_def_t *def;
+    void *state;                // State after the latest step
+    void *prev;                 // State one step earlier
+    uint32_t steps;             // Steps taken since animation_start()
+    uint32_t acc_us;            // Elapsed time not yet consumed by a step
+} animation_t;
+
+// Arena for one animation: its state, padded so the previous state after it
+// is aligned for any type, then the previous state
+#define ANIMATION_STATE_ALIGN   _Alignof(max_align_t)
+#define ANIMATION_ARENA_SIZE(state_size) \
+    ((((state_size) + ANIMATION_STATE_ALIGN - 1) & ~(ANIMATION_STATE_ALIGN - 1)) + (state_size))
+
+// Registry
+const animation_def_t* animations_get(animation_type_t type);
+size_t animations_arena_size(void);     // Fits any registered animation
+
+/**
+ * @brief Start an animation with its state in a caller-provided arena
+ * @param anim Instance to (re)initialize
+ * @param type Registered animation type
+ * @param arena Memory for two copies of the state, aligned for any type (e.g. from malloc)
+ * @param arena_size Arena size, at least ANIMATION_ARENA_SIZE(state_size)
+ * @return ESP_OK, ESP_ERR_NOT_FOUND for an unregistered type, ESP_ERR_NO_MEM if the arena is too small
+ */
+esp_err_t animation_start(animation_t *anim, animation_type_t type, void *arena, size_t arena_size);
+
+/**
+ * @brief Advance by the elapsed time and draw one frame
+ * @param anim Running animation
+ * @param display Display to draw on
+ * @param elapsed_us Time since the previous update; capped at ANIMATION_MAX_CATCHUP_STEPS steps
+ */
+void animation_update(animation_t *anim, ssd1306_handle_t display, uint32_t elapsed_us);
+
+// Animation time since animation_start()
+uint32_t animation_time_ms(const animation_t *anim);
 
 #endif // ANIMATIONS_H
@@ -0,0 +1,73 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+#include "ssd1306_gfx.h"
+
+#define PARTICLE_FRAC_BITS          4       // Positions and velocities in 1/16 pixel
+#define PARTICLE_ONE                (1 << PARTICLE_FRAC_BITS)
+#define PARTICLE_MARGIN             8       // Pixels off screen before a particle is culled
+#define PARTICLE_LIFE_FOREVER       0       // Lives until it leaves the screen
+
+/**
+ * @brief Fixed-capacity particle pool in structure-of-arrays layout
+ *
+ * The pool is one self-contained block of PARTICLE_POOL_SIZE(capacity) bytes
+ * with no pointers, so it can live in an animation state arena and be copied.
+ * Live particles occupy indices 0..count-1: a dying particle is replaced by the
+ * last live one, so the free slots are always the tail of the arrays and every
+ * pass touches live particles only.
+ */
+typedef struct {
+    uint16_t capacity;
+    uint16_t count;
+    int16_t ax, ay;             // Acceleration applied every step, 1/16 pixel per step^2
+    uint32_t rng;               // xorshift32 state
+    int16_t data[];             // x, y, vx, vy arrays, then life and glyph bytes
+} particle_pool_t;
+
+#define PARTICLE_POOL_SIZE(capacity) \
+    (sizeof(particle_pool_t) + (capacity) * (4 * sizeof(int16_t) + 2 * sizeof(uint8_t)))
+
+// Field arrays, indexed 0..count-1
+static inline int16_t* particles_x(const particle_pool_t *pool) { return (int16_t *)pool->data; }
+static inline int16_t* particles_y(const particle_pool_t *pool) { return (int16_t *)pool->data + pool->capacity; }
+static inline int16_t* particles_vx(const particle_pool_t *pool) { return (int16_t *)pool->data + 2 * pool->capacity; }
+static inline int16_t* particles_vy(const particle_pool_t *pool) { return (int16_t *)pool->data + 3 * pool->capacity; }
+static inline uint8_t* particles_life(const particle_pool_t *pool) { return (uint8_t *)(pool->data + 4 * pool->capacity); }
+static inline uint8_t* particles_glyph(const particle_pool_t *pool) { return particles_life(pool) + pool->capacity; }
+
+/**
+ * @brief Spawn description; every value is a base plus a uniform random spread of +/- spread
+ */
+typedef struct {
+    int16_t x, y;               // Spawn point, 1/16 pixel
+    int16_t spread_x, spread_y;
+    int16_t vx, vy;             // Velocity, 1/16 pixel per step
+    int16_t spread_vx, spread_vy;
+    uint8_t life;               // Steps, or PARTICLE_LIFE_FOREVER
+    uint8_t spread_life;
+    uint8_t glyph;              // Index into the glyph table used for rendering
+} particle_emitter_t;
+
+// Particle pool API
+void particles_init(particle_pool_t *pool, uint16_t capacity, uint32_t seed);
+uint32_t particles_rand(uint32_t *state);       // xorshift32; state must not be zero
+int particles_spawn(particle_pool_t *pool);     // Zeroed particle index, -1 if full
+uint16_t particles_emit(particle_pool_t *pool, const particle_emitter_t *emitter, uint16_t n);
+void particles_step(particle_pool_t *pool);
+
+/**
+ * @brief Draw every particle as a point
+ * @param alpha Fraction of the last step to show, out of 256 (see animation_def_t)
+ */
+void particles_render_points(const particle_pool_t *pool, ssd1306_handle_t display, uint8_t alpha);
+
+/**
+ * @brief Draw every particle as glyphs[glyph], top-left corner at its position
+ */
+void particles_render_glyphs(const particle_pool_t *pool, ssd1306_handle_t display, uint8_t alpha,
+                             const ssd1306_bitmap_t *glyphs, ssd1306_rop_t rop);
+
+#endif // PARTICLES_H
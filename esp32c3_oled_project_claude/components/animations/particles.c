@@ -0,0 +1,163 @@
+#include "particles.h"
+
+#define PARTICLE_BATCH              64      // Points converted per ssd1306_gfx_points() call
+
+void particles_init(particle_pool_t *pool, uint16_t capacity, uint32_t seed)
+{
+    pool->capacity = capacity;
+    pool->count = 0;
+    pool->ax = 0;
+    pool->ay = 0;
+    pool->rng = seed ? seed : 0x9E3779B9;    // xorshift32 must not start at zero
+}
+
+uint32_t particles_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+int particles_spawn(particle_pool_t *pool)
+{
+    if (pool->count >= pool->capacity) {
+        return -1;
+    }
+    
+    int i = pool->count++;
+    particles_x(pool)[i] = 0;
+    particles_y(pool)[i] = 0;
+    particles_vx(pool)[i] = 0;
+    particles_vy(pool)[i] = 0;
+    particles_life(pool)[i] = PARTICLE_LIFE_FOREVER;
+    particles_glyph(pool)[i] = 0;
+    return i;
+}
+
+// base +/- spread, uniformly
+static int16_t particles_jitter(particle_pool_t *pool, int16_t base, int16_t spread)
+{
+    if (spread <= 0) {
+        return base;
+    }
+    return base + (int16_t)(particles_rand(&pool->rng) % (2 * spread + 1)) - spread;
+}
+
+uint16_t particles_emit(particle_pool_t *pool, const particle_emitter_t *emitter, uint16_t n)
+{
+    uint16_t emitted = 0;
+    
+    for (; emitted < n; emitted++) {
+        int i = particles_spawn(pool);
+        if (i < 0) {
+            break;
+        }
+        
+        particles_x(pool)[i] = particles_jitter(pool, emitter->x, emitter->spread_x);
+        particles_y(pool)[i] = particles_jitter(pool, emitter->y, emitter->spread_y);
+        particles_vx(pool)[i] = particles_jitter(pool, emitter->vx, emitter->spread_vx);
+        particles_vy(pool)[i] = particles_jitter(pool, emitter->vy, emitter->spread_vy);
+        particles_glyph(pool)[i] = emitter->glyph;
+        
+        int16_t life = particles_jitter(pool, emitter->life, emitter->spread_life);
+        if (emitter->life != PARTICLE_LIFE_FOREVER) {
+            life = (life < 1) ? 1 : (life > 255) ? 255 : life;
+        }
+        particles_life(pool)[i] = life;
+    }
+    
+    return emitted;
+}
+
+// Replace particle i by the last live one
+static void particles_kill(particle_pool_t *pool, uint16_t i)
+{
+    uint16_t last = --pool->count;
+    
+    particles_x(pool)[i] = particles_x(pool)[last];
+    particles_y(pool)[i] = particles_y(pool)[last];
+    particles_vx(pool)[i] = particles_vx(pool)[last];
+    particles_vy(pool)[i] = particles_vy(pool)[last];
+    particles_life(pool)[i] = particles_life(pool)[last];
+    particles_glyph(pool)[i] = particles_glyph(pool)[last];
+}
+
+void particles_step(particle_pool_t *pool)
+{
+    int16_t *x = particles_x(pool);
+    int16_t *y = particles_y(pool);
+    int16_t *vx = particles_vx(pool);
+    int16_t *vy = particles_vy(pool);
+    uint8_t *life = particles_life(pool);
+    
+    // Velocity first, then position, so the previous position is always
+    // position - velocity and rendering can interpolate without a second copy
+    for (uint16_t i = 0; i < pool->count; i++) {
+        vx[i] += pool->ax;
+        vy[i] += pool->ay;
+        x[i] += vx[i];
+        y[i] += vy[i];
+    }
+    
+    // Cull expired particles and those off screen; above the screen only
+    // while nothing pulls them back down
+    const int16_t min_x = -PARTICLE_MARGIN * PARTICLE_ONE;
+    const int16_t max_x = (SSD1306_WIDTH + PARTICLE_MARGIN) * PARTICLE_ONE;
+    const int16_t min_y = (pool->ay > 0) ? INT16_MIN : -PARTICLE_MARGIN * PARTICLE_ONE;
+    const int16_t max_y = (SSD1306_HEIGHT + PARTICLE_MARGIN) * PARTICLE_ONE;
+    
+    for (uint16_t i = 0; i < pool->count; ) {
+        bool expired = life[i] != PARTICLE_LIFE_FOREVER && --life[i] == 0;
+        if (expired || x[i] < min_x || x[i] >= max_x || y[i] < min_y || y[i] >= max_y) {
+            particles_kill(pool, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+// Position alpha/256 of the way through the last step
+static inline int16_t particles_lerp(int16_t pos, int16_t vel, uint8_t alpha)
+{
+    return pos - ((vel * (256 - alpha)) >> 8);
+}
+
+void particles_render_points(const particle_pool_t *pool, ssd1306_handle_t display, uint8_t alpha)
+{
+    const int16_t *x = particles_x(pool);
+    const int16_t *y = particles_y(pool);
+    const int16_t *vx = particles_vx(pool);
+    const int16_t *vy = particles_vy(pool);
+    int16_t bx[PARTICLE_BATCH];
+    int16_t by[PARTICLE_BATCH];
+    
+    for (uint16_t base = 0; base < pool->count; base += PARTICLE_BATCH) {
+        uint16_t n = pool->count - base;
+        if (n > PARTICLE_BATCH) n = PARTICLE_BATCH;
+        
+        for (uint16_t k = 0; k < n; k++) {
+            bx[k] = particles_lerp(x[base + k], vx[base + k], alpha);
+            by[k] = particles_lerp(y[base + k], vy[base + k], alpha);
+        }
+        ssd1306_gfx_points(display, bx, by, n, PARTICLE_FRAC_BITS, 1);
+    }
+}
+
+void particles_render_glyphs(const particle_pool_t *pool, ssd1306_handle_t display, uint8_t alpha,
+                             const ssd1306_bitmap_t *glyphs, ssd1306_rop_t rop)
+{
+    const int16_t *x = particles_x(pool);
+    const int16_t *y = particles_y(pool);
+    const int16_t *vx = particles_vx(pool);
+    const int16_t *vy = particles_vy(pool);
+    const uint8_t *glyph = particles_glyph(pool);
+    
+    for (uint16_t i = 0; i < pool->count; i++) {
+        int16_t px = particles_lerp(x[i], vx[i], alpha) >> PARTICLE_FRAC_BITS;
+        int16_t py = particles_lerp(y[i], vy[i], alpha) >> PARTICLE_FRAC_BITS;
+        ssd1306_blit(display, px, py, &glyphs[glyph[i]], rop);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INPUT_MAX_BUTTONS       8
+#define INPUT_EDGE_QUEUE_SIZE   32      // Edges buffered between the ISR and the input task, power of two
+#define INPUT_EVENT_QUEUE_SIZE  16      // Events waiting for input_get_event()
+
+typedef enum {
+    INPUT_EVENT_PRESS = 0,
+    INPUT_EVENT_RELEASE,
+    INPUT_EVENT_LONG_PRESS,     // Held for long_press_ms
+    INPUT_EVENT_REPEAT,         // Still held, every repeat_ms after the long press
+} input_event_type_t;
+
+typedef struct {
+    input_event_type_t type;
+    uint8_t button;             // Index into input_config_t::buttons
+    uint32_t time_us;           // Edge or timer time on the esp_timer clock (wraps)
+    uint32_t held_us;           // Time since the press; 0 for PRESS
+} input_event_t;
+
+typedef struct {
+    int gpio;
+    bool active_low;            // Pressed pulls the pin low; enables the pull-up
+} input_button_t;
+
+/**
+ * @brief Input configuration
+ *
+ * Both edges of every button are timestamped in the ISR and queued for the
+ * input task, which debounces them and queues the resulting events.
+ */
+typedef struct {
+    const input_button_t *buttons;
+    uint8_t button_count;
+    uint32_t debounce_ms;
+    uint32_t long_press_ms;     // 0 disables long press and repeat
+    uint32_t repeat_ms;         // 0 disables repeat
+    uint32_t task_priority;
+    void (*notify)(void *arg);  // Called from the input task after queueing events, may be NULL
+    void *notify_arg;
+} input_config_t;
+
+/**
+ * @brief Configure the buttons, install their ISRs and start the input task
+ * @param config Configuration; buttons is copied
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE if already started, ESP_ERR_NO_MEM
+ */
+esp_err_t input_init(const input_config_t *config);
+
+/**
+ * @brief Take the oldest pending event
+ * @param event Output event
+ * @param timeout_ms Time to wait for one, 0 to poll
+ * @return ESP_OK, ESP_ERR_TIMEOUT if none arrived, ESP_ERR_INVALID_STATE before input_init()
+ */
+esp_err_t input_get_event(input_event_t *event, uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INPUT_H
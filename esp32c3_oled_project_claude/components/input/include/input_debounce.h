@@ -0,0 +1,87 @@
+#ifndef INPUT_DEBOUNCE_H
+#define INPUT_DEBOUNCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "input.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Button timing, in microseconds
+ */
+typedef struct {
+    uint32_t debounce_us;       // Edges this soon after a change are bounce
+    uint32_t long_press_us;     // Hold time before LONG_PRESS, 0 disables
+    uint32_t repeat_us;         // REPEAT period after LONG_PRESS, 0 disables
+} input_timing_t;
+
+/**
+ * @brief Receives the events of a debouncer, in time order
+ */
+typedef void (*input_emit_t)(const input_event_t *event, void *arg);
+
+/**
+ * @brief Debouncing state machine of one button
+ *
+ * Driven by timestamped edges and by the passage of time only, so it runs
+ * outside the ISR and can be replayed against recorded timelines. The first
+ * edge of a change is reported at once with its own timestamp; edges during
+ * the following debounce_us are bounce. If the level at the end of that
+ * window differs from the reported one, the change is reported once the
+ * contact has been quiet for debounce_us.
+ */
+typedef struct {
+    uint8_t button;             // Index reported in events
+    bool raw;                   // Last level seen, true = pressed
+    bool pressed;               // Debounced level
+    bool settling;              // Inside a debounce window
+    bool timer;                 // Long press or repeat pending
+    bool long_sent;             // LONG_PRESS reported for this press
+    uint32_t settle_until;      // End of the debounce window
+    uint32_t last_edge;         // Time of the latest edge
+    uint32_t next_timer;        // Time of the pending long press or repeat
+    uint32_t pressed_at;        // Time of the current press
+} input_debouncer_t;
+
+/**
+ * @brief Reset a debouncer to a known level without reporting it
+ * @param db Debouncer
+ * @param button Index reported in its events
+ * @param pressed Current level
+ */
+void input_debounce_init(input_debouncer_t *db, uint8_t button, bool pressed);
+
+/**
+ * @brief Feed one edge; timers due before it are run first
+ * @param db Debouncer
+ * @param timing Button timing
+ * @param pressed Level after the edge
+ * @param time_us Edge timestamp (wrapping microsecond clock)
+ * @param emit Event receiver
+ * @param arg Argument for emit
+ */
+void input_debounce_edge(input_debouncer_t *db, const input_timing_t *timing, bool pressed, uint32_t time_us,
+                         input_emit_t emit, void *arg);
+
+/**
+ * @brief Run the debounce, long press and repeat timers due at now_us
+ */
+void input_debounce_poll(input_debouncer_t *db, const input_timing_t *timing, uint32_t now_us,
+                         input_emit_t emit, void *arg);
+
+/**
+ * @brief Next time input_debounce_poll() has work
+ * @param db Debouncer
+ * @param deadline_us Set to the deadline
+ * @return false if nothing is pending until the next edge
+ */
+bool input_debounce_next(const input_debouncer_t *db, uint32_t *deadline_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INPUT_DEBOUNCE_H
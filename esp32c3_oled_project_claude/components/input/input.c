@@ -0,0 +1,239 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "input.h"
+#include "input_debounce.h"
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+static const char *TAG = "INPUT";
+
+// A GPIO edge as seen by the ISR
+typedef struct {
+    uint32_t time_us;
+    uint8_t button;
+    bool pressed;
+} input_edge_t;
+
+// Single-producer ring: the ISR only advances head, the input task only tail
+static input_edge_t s_edges[INPUT_EDGE_QUEUE_SIZE];
+static atomic_uint s_head;
+static atomic_uint s_tail;
+static atomic_uint s_overflows;
+
+static input_button_t s_buttons[INPUT_MAX_BUTTONS];
+static uint8_t s_button_count;
+static input_debouncer_t s_debouncers[INPUT_MAX_BUTTONS];
+static input_timing_t s_timing;
+static void (*s_notify)(void *arg);
+static void *s_notify_arg;
+static TaskHandle_t s_task;
+static QueueHandle_t s_events;
+
+static bool IRAM_ATTR input_read_level(uint8_t button)
+{
+    return gpio_get_level(s_buttons[button].gpio) == (s_buttons[button].active_low ? 0 : 1);
+}
+
+// Only timestamps the edge and wakes the input task; debouncing happens there
+static void IRAM_ATTR input_isr(void *arg)
+{
+    uint8_t button = (uintptr_t)arg;
+    uint32_t now = esp_timer_get_time();
+    unsigned int head = atomic_load_explicit(&s_head, memory_order_relaxed);
+    
+    if (head - atomic_load_explicit(&s_tail, memory_order_acquire) < INPUT_EDGE_QUEUE_SIZE) {
+        input_edge_t *edge = &s_edges[head % INPUT_EDGE_QUEUE_SIZE];
+        edge->time_us = now;
+        edge->button = button;
+        edge->pressed = input_read_level(button);
+        atomic_store_explicit(&s_head, head + 1, memory_order_release);
+    } else {
+        atomic_fetch_add_explicit(&s_overflows, 1, memory_order_relaxed);
+    }
+    
+    BaseType_t higher_prio_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_task, &higher_prio_woken);
+    portYIELD_FROM_ISR(higher_prio_woken);
+}
+
+static void input_emit(const input_event_t *event, void *arg)
+{
+    bool *queued = arg;
+    
+    if (xQueueSend(s_events, event, 0) == pdTRUE) {
+        *queued = true;
+    } else {
+        ESP_LOGW(TAG, "Event queue full, dropped event %d of button %u", event->type, event->button);
+    }
+}
+
+// Ticks until the earliest debounce, long press or repeat timer, rounded up
+static TickType_t input_next_wait(uint32_t now)
+{
+    uint32_t wait_us = UINT32_MAX;
+    
+    for (uint8_t i = 0; i < s_button_count; i++) {
+        uint32_t due;
+        if (input_debounce_next(&s_debouncers[i], &due)) {
+            int32_t remaining = due - now;
+            if (remaining <= 0) {
+                return 0;
+            }
+            if ((uint32_t)remaining < wait_us) {
+                wait_us = remaining;
+            }
+        }
+    }
+    
+    if (wait_us == UINT32_MAX) {
+        return portMAX_DELAY;
+    }
+    uint32_t wait_ms = (wait_us + 999) / 1000;
+    return (wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+}
+
+static void input_task(void *arg)
+{
+    unsigned int overflows = 0;
+    
+    while (1) {
+        // Sleep until an edge arrives or a timer is due
+        ulTaskNotifyTake(pdTRUE, input_next_wait(esp_timer_get_time()));
+        
+        // Read the clock before draining, so every edge stamped before it is in the ring
+        uint32_t now = esp_timer_get_time();
+        bool queued = false;
+        
+        unsigned int tail = atomic_load_explicit(&s_tail, memory_order_relaxed);
+        unsigned int head = atomic_load_explicit(&s_head, memory_order_acquire);
+        while (tail != head) {
+            input_edge_t edge = s_edges[tail % INPUT_EDGE_QUEUE_SIZE];
+            atomic_store_explicit(&s_tail, ++tail, memory_order_release);
+            input_debounce_edge(&s_debouncers[edge.button], &s_timing, edge.pressed, edge.time_us,
+                                input_emit, &queued);
+        }
+        
+        // Lost edges: the current levels are the best information left
+        unsigned int lost = atomic_load_explicit(&s_overflows, memory_order_relaxed);
+        if (lost != overflows) {
+            ESP_LOGW(TAG, "%u edges lost, resynchronizing", lost - overflows);
+            overflows = lost;
+            for (uint8_t i = 0; i < s_button_count; i++) {
+                input_debounce_edge(&s_debouncers[i], &s_timing, input_read_level(i), now, input_emit, &queued);
+            }
+        }
+        
+        for (uint8_t i = 0; i < s_button_count; i++) {
+            input_debounce_poll(&s_debouncers[i], &s_timing, now, input_emit, &queued);
+        }
+        
+        if (queued && s_notify) {
+            s_notify(s_notify_arg);
+        }
+    }
+}
+
+esp_err_t input_init(const input_config_t *config)
+{
+    if (config == NULL || config->buttons == NULL ||
+        config->button_count == 0 || config->button_count > INPUT_MAX_BUTTONS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    memcpy(s_buttons, config->buttons, config->button_count * sizeof(input_button_t));
+    s_button_count = config->button_count;
+    s_timing = (input_timing_t){
+        .debounce_us = config->debounce_ms * 1000,
+        .long_press_us = config->long_press_ms * 1000,
+        .repeat_us = config->long_press_ms ? config->repeat_ms * 1000 : 0,
+    };
+    s_notify = config->notify;
+    s_notify_arg = config->notify_arg;
+    
+    s_events = xQueueCreate(INPUT_EVENT_QUEUE_SIZE, sizeof(input_event_t));
+    if (s_events == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Each pin gets its own pull-up setting; an active-high button must not be pulled up
+    esp_err_t ret;
+    for (uint8_t i = 0; i < s_button_count; i++) {
+        gpio_config_t gpio_conf = {
+            .pin_bit_mask = 1ULL << s_buttons[i].gpio,
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = s_buttons[i].active_low ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_ANYEDGE,
+        };
+        ret = gpio_config(&gpio_conf);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to configure button GPIO %d: %s", s_buttons[i].gpio, esp_err_to_name(ret));
+            vQueueDelete(s_events);
+            s_events = NULL;
+            return ret;
+        }
+    }
+    
+    // The ISR service may already be installed by another driver. Installed before
+    // the task exists, so a failure leaves nothing running.
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+        vQueueDelete(s_events);
+        s_events = NULL;
+        return ret;
+    }
+    
+    // Start from the current levels, so a button held at boot is not a press
+    for (uint8_t i = 0; i < s_button_count; i++) {
+        input_debounce_init(&s_debouncers[i], i, input_read_level(i));
+    }
+    
+    if (xTaskCreate(input_task, "input", 2560, NULL, config->task_priority, &s_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create input task");
+        s_task = NULL;
+        vQueueDelete(s_events);
+        s_events = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Handlers go in last: the ISR notifies s_task. On failure the ones already
+    // added are removed before the task and queue go away.
+    for (uint8_t i = 0; i < s_button_count; i++) {
+        ret = gpio_isr_handler_add(s_buttons[i].gpio, input_isr, (void *)(uintptr_t)i);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to add ISR handler for GPIO %d: %s", s_buttons[i].gpio, esp_err_to_name(ret));
+            while (i-- > 0) {
+                gpio_isr_handler_remove(s_buttons[i].gpio);
+            }
+            vTaskDelete(s_task);
+            s_task = NULL;
+            vQueueDelete(s_events);
+            s_events = NULL;
+            return ret;
+        }
+    }
+    
+    ESP_LOGI(TAG, "Input initialized with %u buttons", s_button_count);
+    return ESP_OK;
+}
+
+esp_err_t input_get_event(input_event_t *event, uint32_t timeout_ms)
+{
+    if (event == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_events == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    return xQueueReceive(s_events, event, pdMS_TO_TICKS(timeout_ms)) == pdTRUE ? ESP_OK : ESP_ERR_TIMEOUT;
+}
@@ -0,0 +1,103 @@
+#include "input_debounce.h"
+
+// Wrapping clock comparison: a is at or after b
+static bool time_reached(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) >= 0;
+}
+
+static void emit_event(input_debouncer_t *db, input_event_type_t type, uint32_t time_us,
+                       input_emit_t emit, void *arg)
+{
+    input_event_t event = {
+        .type = type,
+        .button = db->button,
+        .time_us = time_us,
+        .held_us = (type == INPUT_EVENT_PRESS) ? 0 : time_us - db->pressed_at,
+    };
+    emit(&event, arg);
+}
+
+// Report a change of the debounced level and ignore edges for debounce_us
+static void change_level(input_debouncer_t *db, const input_timing_t *timing, bool pressed, uint32_t time_us,
+                         input_emit_t emit, void *arg)
+{
+    db->pressed = pressed;
+    db->settling = true;
+    db->settle_until = time_us + timing->debounce_us;
+    
+    if (pressed) {
+        db->pressed_at = time_us;
+        db->long_sent = false;
+        db->timer = timing->long_press_us > 0;
+        db->next_timer = time_us + timing->long_press_us;
+        emit_event(db, INPUT_EVENT_PRESS, time_us, emit, arg);
+    } else {
+        db->timer = false;
+        emit_event(db, INPUT_EVENT_RELEASE, time_us, emit, arg);
+    }
+}
+
+void input_debounce_init(input_debouncer_t *db, uint8_t button, bool pressed)
+{
+    *db = (input_debouncer_t){
+        .button = button,
+        .raw = pressed,
+        .pressed = pressed,
+    };
+}
+
+bool input_debounce_next(const input_debouncer_t *db, uint32_t *deadline_us)
+{
+    if (db->settling && (!db->timer || !time_reached(db->settle_until, db->next_timer))) {
+        *deadline_us = db->settle_until;
+        return true;
+    }
+    if (db->timer) {
+        *deadline_us = db->next_timer;
+        return true;
+    }
+    return false;
+}
+
+void input_debounce_poll(input_debouncer_t *db, const input_timing_t *timing, uint32_t now_us,
+                         input_emit_t emit, void *arg)
+{
+    uint32_t due;
+    
+    // Several timers may have expired since the last call; run them in order
+    while (input_debounce_next(db, &due) && time_reached(now_us, due)) {
+        if (db->settling && due == db->settle_until) {
+            // End of the debounce window: catch up with a level that changed inside
+            // it, once the contact has been quiet for debounce_us
+            if (db->raw != db->pressed && !time_reached(due, db->last_edge + timing->debounce_us)) {
+                db->settle_until = db->last_edge + timing->debounce_us;
+                continue;
+            }
+            db->settling = false;
+            if (db->raw != db->pressed) {
+                change_level(db, timing, db->raw, due, emit, arg);
+            }
+        } else if (!db->long_sent) {
+            db->long_sent = true;
+            db->timer = timing->repeat_us > 0;
+            db->next_timer = due + timing->repeat_us;
+            emit_event(db, INPUT_EVENT_LONG_PRESS, due, emit, arg);
+        } else {
+            db->next_timer = due + timing->repeat_us;
+            emit_event(db, INPUT_EVENT_REPEAT, due, emit, arg);
+        }
+    }
+}
+
+void input_debounce_edge(input_debouncer_t *db, const input_timing_t *timing, bool pressed, uint32_t time_us,
+                         input_emit_t emit, void *arg)
+{
+    input_debounce_poll(db, timing, time_us, emit, arg);
+    
+    db->raw = pressed;
+    db->last_edge = time_us;
+    if (!db->settling && pressed != db->pressed) {
+        change_level(db, timing, pressed, time_us, emit, arg);
+    }
+}
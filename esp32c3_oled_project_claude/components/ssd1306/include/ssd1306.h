@@ -1,8 +1,11 @@
 #ifndef SSD1306_H
 #define SSD1306_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "esp_err.h"
 #include "driver/i2c_master.h"
+#include "ssd1306_transport.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,11 +22,62 @@ extern "C" {
 #define SSD1306_COLOR_WHITE     1
 
 // Font sizes
-#define SSD1306_FONT_SIZE_11    11
+#define SSD1306_FONT_SIZE_8     8
 #define SSD1306_FONT_SIZE_16    16
 
 typedef struct ssd1306_dev* ssd1306_handle_t;
 
+/**
+ * @brief Hardware scroll direction
+ */
+typedef enum {
+    SSD1306_SCROLL_RIGHT = 0,
+    SSD1306_SCROLL_LEFT,
+} ssd1306_scroll_dir_t;
+
+/**
+ * @brief Ticker content callback
+ * @param page Zeroed page buffer (one byte per column, bit n = row n) to render into
+ * @param seq Number of pages fetched before this one
+ * @param arg User argument passed to ssd1306_ticker_start()
+ */
+typedef void (*ssd1306_ticker_fill_t)(uint8_t page[SSD1306_WIDTH], uint32_t seq, void *arg);
+
+/**
+ * @brief Cost of the most recent frame sent to the panel
+ *
+ * A frame is everything one refresh sent, from its first window to its last.
+ */
+typedef struct {
+    uint32_t frames;            // Frames sent since creation
+    uint32_t flush_us;          // Time from the first to the end of the last transfer
+    uint32_t bytes;             // Bytes on the bus, control and window commands included
+    uint16_t dirty_columns;     // Page columns sent (8 pixels each)
+} ssd1306_flush_stats_t;
+
+/**
+ * @brief Compact bitmap font covering one contiguous character range
+ *
+ * Glyphs are stored column-major in the GRAM page layout: for each page of the
+ * glyph (height / 8 pages) the column bytes follow each other, bit n being row n.
+ * Fixed-width fonts set width and leave widths/offsets NULL; proportional fonts
+ * set width to 0 and provide a per-glyph width and bitmap offset table.
+ */
+typedef struct {
+    uint8_t first_char;         // First encoded character
+    uint8_t last_char;          // Last encoded character
+    uint8_t height;             // Glyph height in pixels, multiple of 8
+    uint8_t width;              // Fixed glyph width, 0 for proportional fonts
+    uint8_t spacing;            // Blank columns after each glyph
+    const uint8_t *widths;      // Per-glyph widths (proportional fonts)
+    const uint16_t *offsets;    // Per-glyph bitmap offsets (proportional fonts)
+    const uint8_t *bitmap;      // Packed column bitmaps
+} ssd1306_font_t;
+
+extern const ssd1306_font_t ssd1306_font_6x8;     // 5x7 glyphs in a 6x8 cell
+extern const ssd1306_font_t ssd1306_font_8x16;    // Default 8x16 font
+extern const ssd1306_font_t ssd1306_font_prop8;   // Proportional 8 pixel font
+
 /**
  * @brief Create SSD1306 device handle
  * @param bus_handle I2C master bus handle
@@ -32,6 +86,13 @@ typedef struct ssd1306_dev* ssd1306_handle_t;
  */
 ssd1306_handle_t ssd1306_create(i2c_master_bus_handle_t bus_handle, uint8_t dev_addr);
 
+/**
+ * @brief Create SSD1306 device handle on an existing transport
+ * @param transport Bus backend; owned by the device once this call succeeds
+ * @return SSD1306 device handle or NULL on error
+ */
+ssd1306_handle_t ssd1306_create_with_transport(ssd1306_transport_t *transport);
+
 /**
  * @brief Delete SSD1306 device handle
  * @param dev SSD1306 device handle
@@ -54,10 +115,162 @@ void ssd1306_clear_screen(ssd1306_handle_t dev, uint8_t chFill);
 
 /**
  * @brief Refresh GRAM (display buffer to screen)
+ *
+ * Only the column ranges modified since the last refresh are transmitted.
  * @param dev SSD1306 device handle
  */
 void ssd1306_refresh_gram(ssd1306_handle_t dev);
 
+/**
+ * @brief Enable double-buffered, asynchronous refresh
+ *
+ * Allocates a front buffer and a flush task that transmits it, so the next
+ * frame can be rendered into the back buffer while the previous one is sent.
+ * @param dev SSD1306 device handle
+ * @param task_priority FreeRTOS priority of the flush task
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_enable_async(ssd1306_handle_t dev, uint32_t task_priority);
+
+/**
+ * @brief Queue the current buffer for transmission and return immediately
+ *
+ * Blocks only while the previous frame is still being flushed. Falls back to
+ * a synchronous refresh when asynchronous mode is not enabled.
+ * @param dev SSD1306 device handle
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_refresh_gram_async(ssd1306_handle_t dev);
+
+/**
+ * @brief Wait until the frame queued by ssd1306_refresh_gram_async() is sent
+ * @param dev SSD1306 device handle
+ * @param timeout_ms Maximum time to wait
+ * @return ESP_OK when idle, ESP_ERR_TIMEOUT otherwise
+ */
+esp_err_t ssd1306_wait_flush(ssd1306_handle_t dev, uint32_t timeout_ms);
+
+/**
+ * @brief Get the cost of the most recent frame sent
+ *
+ * Never waits for a frame in flight: the figures describe the last complete
+ * frame and are published as a whole, so this is safe to call every render.
+ * @param dev SSD1306 device handle
+ * @param stats Output statistics
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_get_flush_stats(ssd1306_handle_t dev, ssd1306_flush_stats_t *stats);
+
+/**
+ * @brief Mark the whole buffer dirty so the next refresh resends every page
+ * @param dev SSD1306 device handle
+ */
+void ssd1306_invalidate(ssd1306_handle_t dev);
+
+/**
+ * @brief Set the panel contrast (brightness)
+ * @param dev SSD1306 device handle
+ * @param contrast Contrast level (0-255)
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_set_contrast(ssd1306_handle_t dev, uint8_t contrast);
+
+/**
+ * @brief Put the panel to sleep or wake it up
+ *
+ * Sleeping turns the display and the charge pump off. The panel keeps its
+ * GRAM, and refreshes are skipped until wake-up, when pending changes are
+ * sent before the display is turned back on.
+ *
+ * @param dev SSD1306 device handle
+ * @param sleep true to sleep, false to wake
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_set_sleep(ssd1306_handle_t dev, bool sleep);
+
+/**
+ * @brief Check whether the panel is asleep
+ * @param dev SSD1306 device handle
+ * @return true if asleep
+ */
+bool ssd1306_is_sleeping(ssd1306_handle_t dev);
+
+/**
+ * @brief Set the pre-charge period
+ * @param dev SSD1306 device handle
+ * @param phase1 Phase 1 period in DCLKs (1-15)
+ * @param phase2 Phase 2 period in DCLKs (1-15)
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_set_precharge(ssd1306_handle_t dev, uint8_t phase1, uint8_t phase2);
+
+/**
+ * @brief Set the GRAM row shown at the top of the screen
+ * @param dev SSD1306 device handle
+ * @param line Display start line (0-63)
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_set_start_line(ssd1306_handle_t dev, uint8_t line);
+
+/**
+ * @brief Start continuous hardware scrolling of a page range
+ *
+ * The panel scrolls on its own with no I2C traffic. Refreshes are held back
+ * while scrolling, since GRAM must not be written during a scroll.
+ *
+ * @param dev SSD1306 device handle
+ * @param dir Horizontal direction
+ * @param start_page First page to scroll
+ * @param end_page Last page to scroll
+ * @param interval Frame interval code (0-7, see datasheet)
+ * @param vertical_offset Rows to scroll vertically per step, 0 for horizontal only
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_start_scroll(ssd1306_handle_t dev, ssd1306_scroll_dir_t dir, uint8_t start_page,
+                               uint8_t end_page, uint8_t interval, uint8_t vertical_offset);
+
+/**
+ * @brief Stop hardware scrolling
+ *
+ * The panel content has moved, so the whole buffer is marked dirty and the
+ * next refresh redraws it.
+ *
+ * @param dev SSD1306 device handle
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_stop_scroll(ssd1306_handle_t dev);
+
+/**
+ * @brief Start a vertical ticker driven by start line rotation
+ * @param dev SSD1306 device handle
+ * @param fill Callback rendering the next page of content
+ * @param arg User argument for the callback
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_ticker_start(ssd1306_handle_t dev, ssd1306_ticker_fill_t fill, void *arg);
+
+/**
+ * @brief Scroll the ticker up by one row
+ *
+ * Writes the newly exposed row (at most one page window) and advances the
+ * start line; the rest of the screen is not re-sent.
+ *
+ * @param dev SSD1306 device handle
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_ticker_step(ssd1306_handle_t dev);
+
+/**
+ * @brief Stop the ticker and restore start line 0
+ *
+ * The buffer is rotated so the visible image is kept; the next refresh
+ * re-sends it.
+ *
+ * @param dev SSD1306 device handle
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_ticker_stop(ssd1306_handle_t dev);
+
 /**
  * @brief Draw a point
  * @param dev SSD1306 device handle
@@ -89,13 +302,106 @@ void ssd1306_draw_line(ssd1306_handle_t dev, uint8_t chXpos0, uint8_t chYpos0, u
  */
 void ssd1306_draw_rectangle(ssd1306_handle_t dev, uint8_t chXpos0, uint8_t chYpos0, uint8_t chWidth, uint8_t chHeight, uint8_t chMode);
 
+/**
+ * @brief Fill a rectangle, writing whole page bytes where possible
+ * @param dev SSD1306 device handle
+ * @param chXpos Top-left X coordinate
+ * @param chYpos Top-left Y coordinate
+ * @param chWidth Width in pixels (clipped to the panel)
+ * @param chHeight Height in pixels (clipped to the panel)
+ * @param chMode Color (0=black, 1=white)
+ */
+void ssd1306_fill_rect(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight, uint8_t chMode);
+
+/**
+ * @brief Invert every pixel of a rectangle, e.g. for a selection bar over text
+ * @param dev SSD1306 device handle
+ * @param chXpos Top-left X coordinate
+ * @param chYpos Top-left Y coordinate
+ * @param chWidth Width in pixels (clipped to the panel)
+ * @param chHeight Height in pixels (clipped to the panel)
+ */
+void ssd1306_invert_rect(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight);
+
+/**
+ * @brief Move the contents of a rectangle left, e.g. to scroll a graph by one sample
+ *
+ * Pixels outside the rectangle are left alone; the chShift columns vacated
+ * on its right are cleared.
+ * @param dev SSD1306 device handle
+ * @param chXpos Top-left X coordinate
+ * @param chYpos Top-left Y coordinate
+ * @param chWidth Width in pixels (clipped to the panel)
+ * @param chHeight Height in pixels (clipped to the panel)
+ * @param chShift Columns to move by; chWidth or more clears the rectangle
+ */
+void ssd1306_shift_left(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight, uint8_t chShift);
+
+/**
+ * @brief Draw a horizontal line
+ * @param dev SSD1306 device handle
+ * @param chXpos Start X coordinate
+ * @param chYpos Y coordinate
+ * @param chWidth Length in pixels
+ * @param chMode Color (0=black, 1=white)
+ */
+void ssd1306_draw_hline(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chMode);
+
+/**
+ * @brief Draw a vertical line
+ * @param dev SSD1306 device handle
+ * @param chXpos X coordinate
+ * @param chYpos Start Y coordinate
+ * @param chHeight Length in pixels
+ * @param chMode Color (0=black, 1=white)
+ */
+void ssd1306_draw_vline(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chHeight, uint8_t chMode);
+
+/**
+ * @brief Get the built-in font for a legacy size value
+ * @param chSize SSD1306_FONT_SIZE_8 or SSD1306_FONT_SIZE_16
+ * @return Font descriptor or NULL if the size is not available
+ */
+const ssd1306_font_t *ssd1306_font_for_size(uint8_t chSize);
+
+/**
+ * @brief Draw a single glyph from a font
+ * @param dev SSD1306 device handle
+ * @param chXpos X coordinate
+ * @param chYpos Y coordinate
+ * @param chChr Character to display
+ * @param font Font descriptor
+ * @param chMode 1 draws the glyph, 0 clears its cell
+ * @return Horizontal advance in pixels
+ */
+uint8_t ssd1306_draw_glyph(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chChr, const ssd1306_font_t *font, uint8_t chMode);
+
+/**
+ * @brief Show a string using a specific font
+ * @param dev SSD1306 device handle
+ * @param chXpos X coordinate
+ * @param chYpos Y coordinate
+ * @param pchString String to display
+ * @param font Font descriptor
+ * @param chMode Color (0=black, 1=white)
+ */
+void ssd1306_show_string_font(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, const char *pchString, const ssd1306_font_t *font, uint8_t chMode);
+
+/**
+ * @brief Width of a string in pixels when rendered with a font
+ * @param font Font descriptor
+ * @param pchString String to measure
+ * @return Width in pixels
+ */
+uint16_t ssd1306_text_width(const ssd1306_font_t *font, const char *pchString);
+
 /**
  * @brief Show a string on the display
  * @param dev SSD1306 device handle
  * @param chXpos X coordinate
  * @param chYpos Y coordinate
  * @param pchString String to display
- * @param chSize Font size (16 supported)
+ * @param chSize Font size (8 or 16)
  * @param chMode Color (0=black, 1=white)
  */
 void ssd1306_show_string(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, const char *pchString, uint8_t chSize, uint8_t chMode);
@@ -106,7 +412,7 @@ void ssd1306_show_string(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, c
  * @param chXpos X coordinate
  * @param chYpos Y coordinate
  * @param chChr Character to display
- * @param chSize Font size (16 supported)
+ * @param chSize Font size (8 or 16)
  * @param chMode Color (0=black, 1=white)
  */
 void ssd1306_show_char(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chChr, uint8_t chSize, uint8_t chMode);
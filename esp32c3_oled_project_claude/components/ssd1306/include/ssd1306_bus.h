@@ -0,0 +1,80 @@
+#ifndef SSD1306_BUS_H
+#define SSD1306_BUS_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_BUS_MAX_PANELS      4
+
+typedef struct ssd1306_bus* ssd1306_bus_handle_t;
+
+/**
+ * @brief Frame latency of one panel on a shared bus
+ *
+ * Latency runs from ssd1306_refresh_gram_async() handing a frame over to
+ * its last byte being sent.
+ */
+typedef struct {
+    uint32_t frames;            // Frames sent
+    uint32_t last_latency_us;   // Latency of the most recent frame
+    uint32_t avg_latency_us;    // Average latency
+    uint32_t max_latency_us;    // Worst latency
+} ssd1306_bus_stats_t;
+
+/**
+ * @brief Create a refresh scheduler for panels sharing one bus
+ *
+ * A single task sends the frames of all attached panels, so flushes never
+ * overlap on the wire. Pending frames are interleaved a few pages at a time,
+ * so a full redraw on one panel does not hold back small updates on another.
+ *
+ * @param task_priority Priority of the scheduler task
+ * @param ret_bus Returned scheduler handle
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_bus_create(uint32_t task_priority, ssd1306_bus_handle_t *ret_bus);
+
+/**
+ * @brief Remove all panels and delete the scheduler
+ * @param bus Scheduler handle
+ */
+void ssd1306_bus_delete(ssd1306_bus_handle_t bus);
+
+/**
+ * @brief Attach a panel to the scheduler
+ *
+ * The panel must not use ssd1306_enable_async(). Afterwards
+ * ssd1306_refresh_gram_async() queues its frames on the scheduler.
+ *
+ * @param bus Scheduler handle
+ * @param dev SSD1306 device handle
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_bus_add_panel(ssd1306_bus_handle_t bus, ssd1306_handle_t dev);
+
+/**
+ * @brief Detach a panel once its in-flight frame is sent
+ * @param bus Scheduler handle
+ * @param dev SSD1306 device handle
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_bus_remove_panel(ssd1306_bus_handle_t bus, ssd1306_handle_t dev);
+
+/**
+ * @brief Get the frame latency statistics of an attached panel
+ * @param dev SSD1306 device handle
+ * @param stats Destination
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_bus_get_stats(ssd1306_handle_t dev, ssd1306_bus_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_BUS_H
@@ -0,0 +1,111 @@
+#ifndef SSD1306_GFX_H
+#define SSD1306_GFX_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Integer-only shape rasterizer. Coordinates are signed so shapes may lie
+ * partly or entirely off screen; everything is clipped to the panel, and a
+ * clipped line lights exactly the pixels the unclipped one would.
+ * chMode: 1 sets pixels, 0 clears them.
+ */
+
+/**
+ * @brief Raster operation applied by ssd1306_blit()
+ */
+typedef enum {
+    SSD1306_ROP_COPY = 0,   // dst = src
+    SSD1306_ROP_OR,         // dst |= src
+    SSD1306_ROP_AND_NOT,    // dst &= ~src
+    SSD1306_ROP_XOR,        // dst ^= src
+} ssd1306_rop_t;
+
+/**
+ * @brief 1bpp bitmap in the GRAM page layout
+ *
+ * (height + 7) / 8 pages of width column bytes each, bit n of a byte being
+ * row n of its page. Rows past height in the last page are ignored.
+ */
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    const uint8_t *data;    // Pixel data
+    const uint8_t *mask;    // Optional transparency mask in the same layout, 1 = opaque
+} ssd1306_bitmap_t;
+
+/**
+ * @brief Draw a bitmap with its top-left corner at (x, y)
+ *
+ * Unaligned rows are written as shifted bytes spanning two pages. Only pixels
+ * set in the mask are touched; without a mask the whole rectangle is.
+ * Drawing the same bitmap twice with SSD1306_ROP_XOR restores the background.
+ */
+void ssd1306_blit(ssd1306_handle_t dev, int16_t x, int16_t y, const ssd1306_bitmap_t *bmp, ssd1306_rop_t rop);
+
+/**
+ * @brief Plot a batch of points given as separate coordinate arrays
+ *
+ * Coordinates are fixed point with frac_bits fractional bits (0 for whole
+ * pixels), so structure-of-arrays particle storage can be drawn as is.
+ * Off-screen points are skipped and dirty ranges are merged once per batch.
+ */
+void ssd1306_gfx_points(ssd1306_handle_t dev, const int16_t *xs, const int16_t *ys, uint16_t count,
+                        uint8_t frac_bits, uint8_t chMode);
+
+/**
+ * @brief Draw a line between two points, both endpoints included
+ */
+void ssd1306_gfx_line(ssd1306_handle_t dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t chMode);
+
+/**
+ * @brief Draw a w x h rectangle outline
+ */
+void ssd1306_gfx_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t chMode);
+
+/**
+ * @brief Fill a w x h rectangle
+ */
+void ssd1306_gfx_fill_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t chMode);
+
+/**
+ * @brief Draw a circle outline of radius r centred on (cx, cy)
+ */
+void ssd1306_gfx_circle(ssd1306_handle_t dev, int16_t cx, int16_t cy, int16_t r, uint8_t chMode);
+
+/**
+ * @brief Fill a circle of radius r centred on (cx, cy)
+ */
+void ssd1306_gfx_fill_circle(ssd1306_handle_t dev, int16_t cx, int16_t cy, int16_t r, uint8_t chMode);
+
+/**
+ * @brief Draw a w x h rectangle outline with corners of radius r
+ */
+void ssd1306_gfx_round_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint8_t chMode);
+
+/**
+ * @brief Fill a w x h rectangle with corners of radius r
+ */
+void ssd1306_gfx_fill_round_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint8_t chMode);
+
+/**
+ * @brief Draw a triangle outline
+ */
+void ssd1306_gfx_triangle(ssd1306_handle_t dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                          int16_t x2, int16_t y2, uint8_t chMode);
+
+/**
+ * @brief Fill a triangle
+ */
+void ssd1306_gfx_fill_triangle(ssd1306_handle_t dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                               int16_t x2, int16_t y2, uint8_t chMode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_GFX_H
@@ -0,0 +1,87 @@
+#ifndef SSD1306_MEM_H
+#define SSD1306_MEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "ssd1306.h"
+#include "ssd1306_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bus traffic recorded by the memory transport
+ */
+typedef struct {
+    uint32_t transfers;         // Transfers (one I2C transaction each)
+    uint32_t bytes;             // Bytes on the wire, control bytes included
+    uint32_t data_bytes;        // GRAM bytes written
+    uint64_t bus_time_us;       // Time the transfers would take at the configured bus clock
+} ssd1306_mem_stats_t;
+
+/**
+ * @brief Create a transport that emulates the panel in memory
+ *
+ * Commands are decoded and data is written into an emulated GRAM, so the
+ * driver can run without hardware, e.g. for render tests and benchmarks.
+ *
+ * @param bus_hz Bus clock used for the bus time estimate (e.g. 400000)
+ * @param ret_transport Returned transport
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_new_transport_mem(uint32_t bus_hz, ssd1306_transport_t **ret_transport);
+
+/**
+ * @brief Copy the image the panel currently shows
+ *
+ * Takes the start line, inversion and display on/off state into account.
+ *
+ * @param transport Memory transport
+ * @param frame Destination in GRAM layout (SSD1306_BUFFER_SIZE bytes)
+ */
+void ssd1306_mem_get_frame(ssd1306_transport_t *transport, uint8_t *frame);
+
+/**
+ * @brief Get a pixel of the image the panel currently shows
+ * @param transport Memory transport
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return true if the pixel is lit
+ */
+bool ssd1306_mem_get_pixel(ssd1306_transport_t *transport, uint8_t x, uint8_t y);
+
+/**
+ * @brief Get the contrast the panel was last set to
+ * @param transport Memory transport
+ * @return Contrast level (0-255)
+ */
+uint8_t ssd1306_mem_get_contrast(ssd1306_transport_t *transport);
+
+/**
+ * @brief Write the image the panel currently shows as a binary PBM file
+ * @param transport Memory transport
+ * @param path Output file path
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_mem_write_pbm(ssd1306_transport_t *transport, const char *path);
+
+/**
+ * @brief Get the recorded bus statistics
+ * @param transport Memory transport
+ * @param stats Destination
+ */
+void ssd1306_mem_get_stats(ssd1306_transport_t *transport, ssd1306_mem_stats_t *stats);
+
+/**
+ * @brief Reset the recorded bus statistics
+ * @param transport Memory transport
+ */
+void ssd1306_mem_reset_stats(ssd1306_transport_t *transport);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_MEM_H
@@ -0,0 +1,57 @@
+#ifndef SSD1306_TRANSPORT_H
+#define SSD1306_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/i2c_master.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Control bytes leading every transfer
+#define SSD1306_CONTROL_CMD_STREAM          0x00
+#define SSD1306_CONTROL_DATA_STREAM         0x40
+
+typedef struct ssd1306_transport ssd1306_transport_t;
+
+/**
+ * @brief Bus backend used by the SSD1306 driver
+ *
+ * Backends embed this structure as their first member and fill in the
+ * operations. Every transfer starts with a control byte (command or data
+ * stream) followed by the payload, as on the I2C wire.
+ */
+struct ssd1306_transport {
+    /**
+     * @brief Send one transfer
+     * @param transport Transport instance
+     * @param data Control byte followed by payload
+     * @param len Total length including the control byte
+     * @return ESP_OK on success
+     */
+    esp_err_t (*transmit)(ssd1306_transport_t *transport, const uint8_t *data, size_t len);
+    
+    /**
+     * @brief Release the transport
+     * @param transport Transport instance
+     */
+    void (*del)(ssd1306_transport_t *transport);
+};
+
+/**
+ * @brief Create an I2C transport
+ * @param bus_handle I2C master bus handle
+ * @param dev_addr I2C device address
+ * @param ret_transport Returned transport
+ * @return ESP_OK on success
+ */
+esp_err_t ssd1306_new_transport_i2c(i2c_master_bus_handle_t bus_handle, uint8_t dev_addr,
+                                    ssd1306_transport_t **ret_transport);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_TRANSPORT_H
@@ -3,9 +3,14 @@
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
-#include "driver/i2c_master.h"
+#include "esp_timer.h"
 #include "ssd1306.h"
+#include "ssd1306_transport.h"
+#include "ssd1306_bus.h"
+#include "ssd1306_gfx.h"
+#include "ssd1306_priv.h"
 
 static const char *TAG = "SSD1306";
 
@@ -33,257 +38,84 @@ static const char *TAG = "SSD1306";
 #define SSD1306_CMD_COMSCAN_INC             0xC0
 #define SSD1306_CMD_SEGREMAP                0xA0
 #define SSD1306_CMD_CHARGE_PUMP             0x8D
+#define SSD1306_CMD_SCROLL_RIGHT            0x26
+#define SSD1306_CMD_SCROLL_LEFT             0x27
+#define SSD1306_CMD_SCROLL_VERT_RIGHT       0x29
+#define SSD1306_CMD_SCROLL_VERT_LEFT        0x2A
+#define SSD1306_CMD_SCROLL_DEACTIVATE       0x2E
+#define SSD1306_CMD_SCROLL_ACTIVATE         0x2F
+#define SSD1306_CMD_SET_VERT_SCROLL_AREA    0xA3
 
-#define SSD1306_TIMEOUT_MS                  1000
-
-// Complete 8x16 ASCII font (32-126) - 95 characters
-// Each character is 8 pixels wide, 16 pixels tall
-// Data is stored as 16 bytes per character (one byte per row)
-static const uint8_t font8x16[][16] = {
-    // ' ' (32)
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // '!' (33)
-    {0x00,0x00,0x18,0x3C,0x3C,0x3C,0x18,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // '"' (34)
-    {0x00,0x00,0x66,0x66,0x66,0x24,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // '#' (35)
-    {0x00,0x00,0x6C,0x6C,0xFE,0x6C,0x6C,0x6C,0xFE,0x6C,0x6C,0x00,0x00,0x00,0x00,0x00},
-    // '$' (36)
-    {0x00,0x10,0x10,0x7C,0xD6,0xD0,0xD0,0x7C,0x16,0x16,0xD6,0x7C,0x10,0x10,0x00,0x00},
-    // '%' (37)
-    {0x00,0x00,0x00,0x00,0xC2,0xC6,0x0C,0x18,0x30,0x60,0xC6,0x86,0x00,0x00,0x00,0x00},
-    // '&' (38)
-    {0x00,0x00,0x38,0x6C,0x6C,0x38,0x76,0xDC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // ''' (39)
-    {0x00,0x00,0x30,0x30,0x30,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // '(' (40)
-    {0x00,0x00,0x0C,0x18,0x30,0x30,0x30,0x30,0x30,0x30,0x18,0x0C,0x00,0x00,0x00,0x00},
-    // ')' (41)
-    {0x00,0x00,0x30,0x18,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x18,0x30,0x00,0x00,0x00,0x00},
-    // '*' (42)
-    {0x00,0x00,0x00,0x00,0x99,0x5A,0x3C,0xFF,0x3C,0x5A,0x99,0x00,0x00,0x00,0x00,0x00},
-    // '+' (43)
-    {0x00,0x00,0x00,0x18,0x18,0x18,0xFF,0xFF,0x18,0x18,0x18,0x00,0x00,0x00,0x00,0x00},
-    // ',' (44)
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x18,0x30,0x00,0x00,0x00},
-    // '-' (45)
-    {0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // '.' (46)
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // '/' (47)
-    {0x00,0x00,0x00,0x02,0x06,0x0C,0x18,0x30,0x60,0xC0,0x80,0x00,0x00,0x00,0x00,0x00},
-    // '0' (48)
-    {0x00,0x00,0x3C,0x66,0xC3,0xC3,0xDB,0xDB,0xC3,0xC3,0x66,0x3C,0x00,0x00,0x00,0x00},
-    // '1' (49)
-    {0x00,0x00,0x18,0x38,0x58,0x18,0x18,0x18,0x18,0x18,0x18,0x7E,0x00,0x00,0x00,0x00},
-    // '2' (50)
-    {0x00,0x00,0x7C,0xC6,0x06,0x0C,0x18,0x30,0x60,0xC0,0xC6,0xFE,0x00,0x00,0x00,0x00},
-    // '3' (51)
-    {0x00,0x00,0x7C,0xC6,0x06,0x06,0x3C,0x06,0x06,0x06,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // '4' (52)
-    {0x00,0x00,0x0C,0x1C,0x3C,0x6C,0xCC,0xFE,0x0C,0x0C,0x0C,0x1E,0x00,0x00,0x00,0x00},
-    // '5' (53)
-    {0x00,0x00,0xFE,0xC0,0xC0,0xC0,0xFC,0x0E,0x06,0x06,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // '6' (54)
-    {0x00,0x00,0x38,0x60,0xC0,0xC0,0xFC,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // '7' (55)
-    {0x00,0x00,0xFE,0xC6,0x06,0x06,0x0C,0x18,0x30,0x30,0x30,0x30,0x00,0x00,0x00,0x00},
-    // '8' (56)
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0x7C,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // '9' (57)
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0x7E,0x06,0x06,0x06,0x0C,0x78,0x00,0x00,0x00,0x00},
-    // ':' (58)
-    {0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00,0x00},
-    // ';' (59)
-    {0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x30,0x00,0x00,0x00,0x00},
-    // '<' (60)
-    {0x00,0x00,0x00,0x06,0x0C,0x18,0x30,0x60,0x30,0x18,0x0C,0x06,0x00,0x00,0x00,0x00},
-    // '=' (61)
-    {0x00,0x00,0x00,0x00,0x00,0x7E,0x00,0x00,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // '>' (62)
-    {0x00,0x00,0x00,0x60,0x30,0x18,0x0C,0x06,0x0C,0x18,0x30,0x60,0x00,0x00,0x00,0x00},
-    // '?' (63)
-    {0x00,0x00,0x7C,0xC6,0xC6,0x0C,0x18,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // '@' (64)
-    {0x00,0x00,0x7C,0xC6,0xC6,0xDE,0xDE,0xDE,0xDC,0xC0,0x7C,0x00,0x00,0x00,0x00,0x00},
-    // 'A' (65)
-    {0x00,0x00,0x10,0x38,0x6C,0xC6,0xC6,0xFE,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 'B' (66)
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x66,0x66,0x66,0x66,0xFC,0x00,0x00,0x00,0x00},
-    // 'C' (67)
-    {0x00,0x00,0x3C,0x66,0xC2,0xC0,0xC0,0xC0,0xC0,0xC2,0x66,0x3C,0x00,0x00,0x00,0x00},
-    // 'D' (68)
-    {0x00,0x00,0xF8,0x6C,0x66,0x66,0x66,0x66,0x66,0x66,0x6C,0xF8,0x00,0x00,0x00,0x00},
-    // 'E' (69)
-    {0x00,0x00,0xFE,0x66,0x62,0x68,0x78,0x68,0x60,0x62,0x66,0xFE,0x00,0x00,0x00,0x00},
-    // 'F' (70)
-    {0x00,0x00,0xFE,0x66,0x62,0x68,0x78,0x68,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 'G' (71)
-    {0x00,0x00,0x3C,0x66,0xC2,0xC0,0xC0,0xDE,0xC6,0xC6,0x66,0x3A,0x00,0x00,0x00,0x00},
-    // 'H' (72)
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xFE,0xC6,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 'I' (73)
-    {0x00,0x00,0x3C,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 'J' (74)
-    {0x00,0x00,0x1E,0x0C,0x0C,0x0C,0x0C,0x0C,0xCC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00},
-    // 'K' (75)
-    {0x00,0x00,0xE6,0x66,0x66,0x6C,0x78,0x78,0x6C,0x66,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 'L' (76)
-    {0x00,0x00,0xF0,0x60,0x60,0x60,0x60,0x60,0x60,0x62,0x66,0xFE,0x00,0x00,0x00,0x00},
-    // 'M' (77)
-    {0x00,0x00,0xC6,0xEE,0xFE,0xFE,0xD6,0xC6,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 'N' (78)
-    {0x00,0x00,0xC6,0xE6,0xF6,0xFE,0xDE,0xCE,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 'O' (79)
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 'P' (80)
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x60,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 'Q' (81)
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xD6,0xDE,0x7C,0x0C,0x0E,0x00,0x00},
-    // 'R' (82)
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x6C,0x66,0x66,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 'S' (83)
-    {0x00,0x00,0x7C,0xC6,0xC6,0x60,0x38,0x0C,0x06,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 'T' (84)
-    {0x00,0x00,0x7E,0x7E,0x5A,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 'U' (85)
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 'V' (86)
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x6C,0x38,0x10,0x00,0x00,0x00,0x00},
-    // 'W' (87)
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xD6,0xD6,0xD6,0xFE,0xEE,0x6C,0x00,0x00,0x00,0x00},
-    // 'X' (88)
-    {0x00,0x00,0xC6,0xC6,0x6C,0x7C,0x38,0x38,0x7C,0x6C,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 'Y' (89)
-    {0x00,0x00,0x66,0x66,0x66,0x66,0x3C,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 'Z' (90)
-    {0x00,0x00,0xFE,0xC6,0x86,0x0C,0x18,0x30,0x60,0xC2,0xC6,0xFE,0x00,0x00,0x00,0x00},
-    // '[' (91)
-    {0x00,0x00,0x3C,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x3C,0x00,0x00,0x00,0x00},
-    // '\' (92)
-    {0x00,0x00,0x00,0x80,0xC0,0x60,0x30,0x18,0x0C,0x06,0x02,0x00,0x00,0x00,0x00,0x00},
-    // ']' (93)
-    {0x00,0x00,0x3C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x3C,0x00,0x00,0x00,0x00},
-    // '^' (94)
-    {0x00,0x00,0x10,0x38,0x6C,0xC6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // '_' (95)
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00},
-    // '`' (96)
-    {0x00,0x00,0x0C,0x18,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 'a' (97)
-    {0x00,0x00,0x00,0x00,0x00,0x78,0x0C,0x7C,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 'b' (98)
-    {0x00,0x00,0xE0,0x60,0x60,0x78,0x6C,0x66,0x66,0x66,0x66,0x7C,0x00,0x00,0x00,0x00},
-    // 'c' (99)
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xC0,0xC0,0xC0,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 'd' (100)
-    {0x00,0x00,0x1C,0x0C,0x0C,0x3C,0x6C,0xCC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 'e' (101)
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xFE,0xC0,0xC0,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 'f' (102)
-    {0x00,0x00,0x38,0x6C,0x64,0x60,0xF0,0x60,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 'g' (103)
-    {0x00,0x00,0x00,0x00,0x00,0x76,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0xCC,0x78,0x00,0x00},
-    // 'h' (104)
-    {0x00,0x00,0xE0,0x60,0x60,0x6C,0x76,0x66,0x66,0x66,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 'i' (105)
-    {0x00,0x00,0x18,0x18,0x00,0x38,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 'j' (106)
-    {0x00,0x00,0x06,0x06,0x00,0x0E,0x06,0x06,0x06,0x06,0x06,0x06,0x66,0x66,0x3C,0x00},
-    // 'k' (107)
-    {0x00,0x00,0xE0,0x60,0x60,0x66,0x6C,0x78,0x78,0x6C,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 'l' (108)
-    {0x00,0x00,0x38,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 'm' (109)
-    {0x00,0x00,0x00,0x00,0x00,0xEC,0xFE,0xD6,0xD6,0xD6,0xD6,0xC6,0x00,0x00,0x00,0x00},
-    // 'n' (110)
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x66,0x66,0x66,0x66,0x66,0x66,0x00,0x00,0x00,0x00},
-    // 'o' (111)
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 'p' (112)
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x66,0x66,0x66,0x66,0x7C,0x60,0x60,0xF0,0x00,0x00},
-    // 'q' (113)
-    {0x00,0x00,0x00,0x00,0x00,0x76,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0x0C,0x1E,0x00,0x00},
-    // 'r' (114)
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x76,0x66,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 's' (115)
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0x60,0x38,0x0C,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 't' (116)
-    {0x00,0x00,0x10,0x30,0x30,0xFC,0x30,0x30,0x30,0x30,0x36,0x1C,0x00,0x00,0x00,0x00},
-    // 'u' (117)
-    {0x00,0x00,0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 'v' (118)
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0x6C,0x38,0x00,0x00,0x00,0x00},
-    // 'w' (119)
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xD6,0xD6,0xD6,0xFE,0x6C,0x00,0x00,0x00,0x00},
-    // 'x' (120)
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0x6C,0x38,0x38,0x38,0x6C,0xC6,0x00,0x00,0x00,0x00},
-    // 'y' (121)
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0x7E,0x06,0x0C,0xF8,0x00,0x00},
-    // 'z' (122)
-    {0x00,0x00,0x00,0x00,0x00,0xFE,0xCC,0x18,0x30,0x60,0xC6,0xFE,0x00,0x00,0x00,0x00},
-    // '{' (123)
-    {0x00,0x00,0x0E,0x18,0x18,0x18,0x70,0x18,0x18,0x18,0x18,0x0E,0x00,0x00,0x00,0x00},
-    // '|' (124)
-    {0x00,0x00,0x18,0x18,0x18,0x18,0x00,0x18,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0x00},
-    // '}' (125)
-    {0x00,0x00,0x70,0x18,0x18,0x18,0x0E,0x18,0x18,0x18,0x18,0x70,0x00,0x00,0x00,0x00},
-    // '~' (126)
-    {0x00,0x00,0x76,0xDC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}
-};
-
-// Rest of the structure and helper functions remain the same...
-struct ssd1306_dev {
-    i2c_master_dev_handle_t i2c_dev;
-    uint8_t dev_addr;
-    uint8_t *gram;
-};
-
-static esp_err_t ssd1306_write_cmd(ssd1306_handle_t dev, uint8_t cmd)
-{
-    uint8_t data[2] = {0x00, cmd}; // 0x00 = Command mode
-    esp_err_t ret = i2c_master_transmit(dev->i2c_dev, data, 2, SSD1306_TIMEOUT_MS);
+#define SSD1306_MAX_CMD_STREAM              32
+
+#define SSD1306_DEFAULT_CONTRAST            0xCF
+
+// Send a command sequence as a single transaction behind one control byte
+static esp_err_t ssd1306_write_cmds(ssd1306_handle_t dev, const uint8_t *cmds, size_t len)
+{
+    uint8_t data[SSD1306_MAX_CMD_STREAM + 1];
+    
+    if (len > SSD1306_MAX_CMD_STREAM) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    
+    data[0] = SSD1306_CONTROL_CMD_STREAM;
+    memcpy(&data[1], cmds, len);
+    
+    esp_err_t ret = dev->transport->transmit(dev->transport, data, len + 1);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to write command 0x%02X: %s", cmd, esp_err_to_name(ret));
+        ESP_LOGE(TAG, "Failed to write %zu command bytes (0x%02X...): %s", len, cmds[0], esp_err_to_name(ret));
     }
     return ret;
 }
 
-static esp_err_t ssd1306_write_data(ssd1306_handle_t dev, uint8_t *data, size_t data_len)
+// Send the column range x0..x1 of pages page0..page1 of buf as one data transaction
+static esp_err_t ssd1306_write_window(ssd1306_handle_t dev, const uint8_t *buf,
+                                      uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1)
 {
-    // For large data transfers, we need to send in chunks
-    const size_t max_chunk_size = 128;
-    size_t bytes_sent = 0;
-    esp_err_t ret = ESP_OK;
-    
-    uint8_t *write_buffer = malloc(max_chunk_size + 1);
-    if (write_buffer == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate write buffer");
-        return ESP_ERR_NO_MEM;
-    }
-    
-    write_buffer[0] = 0x40; // Data mode
+    size_t width = x1 - x0 + 1;
+    size_t len = 0;
     
-    while (bytes_sent < data_len) {
-        size_t chunk_size = (data_len - bytes_sent > max_chunk_size) ? max_chunk_size : (data_len - bytes_sent);
-        
-        memcpy(&write_buffer[1], &data[bytes_sent], chunk_size);
-        
-        ret = i2c_master_transmit(dev->i2c_dev, write_buffer, chunk_size + 1, SSD1306_TIMEOUT_MS);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to write data chunk at offset %d: %s", bytes_sent, esp_err_to_name(ret));
-            break;
+    dev->tx_buf[0] = SSD1306_CONTROL_DATA_STREAM;
+    if (width == SSD1306_WIDTH) {
+        len = (page1 - page0 + 1) * SSD1306_WIDTH;
+        memcpy(&dev->tx_buf[1], &buf[page0 * SSD1306_WIDTH], len);
+    } else {
+        for (uint8_t page = page0; page <= page1; page++) {
+            memcpy(&dev->tx_buf[1 + len], &buf[page * SSD1306_WIDTH + x0], width);
+            len += width;
         }
-        
-        bytes_sent += chunk_size;
     }
     
-    free(write_buffer);
+    esp_err_t ret = dev->transport->transmit(dev->transport, dev->tx_buf, len + 1);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write %zu data bytes: %s", len, esp_err_to_name(ret));
+    }
     return ret;
 }
 
 ssd1306_handle_t ssd1306_create(i2c_master_bus_handle_t bus_handle, uint8_t dev_addr)
 {
+    ssd1306_transport_t *transport;
+    
+    esp_err_t ret = ssd1306_new_transport_i2c(bus_handle, dev_addr, &transport);
+    if (ret != ESP_OK) {
+        return NULL;
+    }
+    
+    ssd1306_handle_t dev = ssd1306_create_with_transport(transport);
+    if (dev == NULL) {
+        transport->del(transport);
+    }
+    return dev;
+}
+
+ssd1306_handle_t ssd1306_create_with_transport(ssd1306_transport_t *transport)
+{
+    if (transport == NULL) {
+        return NULL;
+    }
+    
     ssd1306_handle_t dev = malloc(sizeof(struct ssd1306_dev));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate memory for SSD1306 device");
@@ -297,23 +129,28 @@ ssd1306_handle_t ssd1306_create(i2c_master_bus_handle_t bus_handle, uint8_t dev_
         return NULL;
     }
     
-    // Add I2C device to the bus
-    i2c_device_config_t dev_cfg = {
-        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
-        .device_address = dev_addr,
-        .scl_speed_hz = 400000,
-    };
-    
-    esp_err_t ret = i2c_master_bus_add_device(bus_handle, &dev_cfg, &dev->i2c_dev);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to add I2C device: %s", esp_err_to_name(ret));
-        free(dev->gram);
-        free(dev);
-        return NULL;
+    dev->transport = transport;
+    dev->front = NULL;
+    dev->flush_task = NULL;
+    dev->flush_idle = NULL;
+    dev->flush_exit = false;
+    memset(&dev->flush_stats, 0, sizeof(dev->flush_stats));
+    portMUX_INITIALIZE(&dev->stats_lock);
+    dev->flush_start_us = 0;
+    dev->bus = NULL;
+    dev->bus_slot = 0;
+    dev->contrast = SSD1306_DEFAULT_CONTRAST;
+    dev->asleep = false;
+    dev->start_line = 0;
+    dev->hw_scroll = false;
+    dev->ticker_fill = NULL;
+    dev->ticker_arg = NULL;
+    dev->ticker_seq = 0;
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        ssd1306_mark_clean(&dev->dirty, page);
+        ssd1306_mark_clean(&dev->front_dirty, page);
     }
     
-    dev->dev_addr = dev_addr;
-    
     ESP_LOGI(TAG, "SSD1306 device created successfully");
     return dev;
 }
@@ -321,8 +158,24 @@ ssd1306_handle_t ssd1306_create(i2c_master_bus_handle_t bus_handle, uint8_t dev_
 void ssd1306_delete(ssd1306_handle_t dev)
 {
     if (dev) {
-        if (dev->i2c_dev) {
-            i2c_master_bus_rm_device(dev->i2c_dev);
+        if (dev->bus) {
+            ssd1306_bus_remove_panel(dev->bus, dev);
+        }
+        if (dev->flush_task) {
+            // Let the in-flight frame finish, then wait for the task to acknowledge exit
+            xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
+            dev->flush_exit = true;
+            xTaskNotifyGive(dev->flush_task);
+            xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
+        }
+        if (dev->flush_idle) {
+            vSemaphoreDelete(dev->flush_idle);
+        }
+        if (dev->front) {
+            free(dev->front);
+        }
+        if (dev->transport) {
+            dev->transport->del(dev->transport);
         }
         if (dev->gram) {
             free(dev->gram);
@@ -334,104 +187,290 @@ void ssd1306_delete(ssd1306_handle_t dev)
 
 esp_err_t ssd1306_init(ssd1306_handle_t dev)
 {
+    static const uint8_t init_cmds[] = {
+        SSD1306_CMD_DISPLAY_OFF,
+        SSD1306_CMD_SET_DISPLAY_CLK_DIV, 0x80,      // Clock divide ratio/oscillator frequency
+        SSD1306_CMD_SET_MULTIPLEX, SSD1306_HEIGHT - 1,
+        SSD1306_CMD_SET_DISPLAY_OFFSET, 0x00,
+        SSD1306_CMD_SET_START_LINE | 0x00,
+        SSD1306_CMD_CHARGE_PUMP, 0x14,
+        SSD1306_CMD_MEMORY_ADDR_MODE, 0x00,         // Horizontal addressing mode
+        SSD1306_CMD_SEGREMAP | 0x01,
+        SSD1306_CMD_COMSCAN_DEC,
+        SSD1306_CMD_SET_COMPINS, 0x12,
+        SSD1306_CMD_SET_CONTRAST, SSD1306_DEFAULT_CONTRAST,
+        SSD1306_CMD_SET_PRECHARGE, 0xF1,
+        SSD1306_CMD_SET_VCOM_DETECT, 0x40,          // VCOM deselect level
+        SSD1306_CMD_DISPLAY_ALL_ON_RESUME,
+        SSD1306_CMD_NORMAL_DISPLAY,
+        SSD1306_CMD_DISPLAY_ON,
+    };
     esp_err_t ret;
     
+    if (dev == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
     ESP_LOGI(TAG, "Initializing SSD1306 display...");
     
-    // Display OFF
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_DISPLAY_OFF);
+    ret = ssd1306_write_cmds(dev, init_cmds, sizeof(init_cmds));
     if (ret != ESP_OK) return ret;
+    dev->contrast = SSD1306_DEFAULT_CONTRAST;
+    dev->asleep = false;
+    dev->start_line = 0;
+    dev->hw_scroll = false;
+    dev->ticker_fill = NULL;
     
-    // Set display clock divide ratio/oscillator frequency
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_DISPLAY_CLK_DIV);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0x80);
-    if (ret != ESP_OK) return ret;
+    // Clear GRAM; the panel content is unknown, so the first refresh sends everything
+    memset(dev->gram, 0, SSD1306_BUFFER_SIZE);
+    ssd1306_invalidate(dev);
     
-    // Set multiplex ratio
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_MULTIPLEX);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, SSD1306_HEIGHT - 1);
-    if (ret != ESP_OK) return ret;
+    ESP_LOGI(TAG, "SSD1306 initialization completed successfully");
+    return ESP_OK;
+}
+
+void ssd1306_clear_screen(ssd1306_handle_t dev, uint8_t chFill)
+{
+    if (dev && dev->gram) {
+        // Only columns whose content actually changes need to be re-sent
+        for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+            uint8_t *row = &dev->gram[page * SSD1306_WIDTH];
+            int x0 = 0;
+            int x1 = SSD1306_WIDTH - 1;
+            
+            while (x0 <= x1 && row[x0] == chFill) x0++;
+            if (x0 > x1) continue;
+            while (row[x1] == chFill) x1--;
+            
+            memset(&row[x0], chFill, x1 - x0 + 1);
+            ssd1306_mark_dirty(&dev->dirty, page, x0, x1);
+        }
+    }
+}
+
+esp_err_t ssd1306_get_flush_stats(ssd1306_handle_t dev, ssd1306_flush_stats_t *stats)
+{
+    if (dev == NULL || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Set display offset
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_DISPLAY_OFFSET);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0x00);
-    if (ret != ESP_OK) return ret;
+    portENTER_CRITICAL(&dev->stats_lock);
+    *stats = dev->flush_stats;
+    portEXIT_CRITICAL(&dev->stats_lock);
+    return ESP_OK;
+}
+
+void ssd1306_invalidate(ssd1306_handle_t dev)
+{
+    if (dev == NULL) return;
     
-    // Set start line address
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_START_LINE | 0x00);
-    if (ret != ESP_OK) return ret;
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        dev->dirty.x0[page] = 0;
+        dev->dirty.x1[page] = SSD1306_WIDTH - 1;
+    }
+}
+
+esp_err_t ssd1306_flush_window(ssd1306_handle_t dev, const uint8_t *buf, ssd1306_dirty_t *dirty,
+                               uint8_t max_pages, bool *done)
+{
+    uint8_t page = 0;
+    while (page < SSD1306_PAGES && !ssd1306_page_is_dirty(dirty, page)) {
+        page++;
+    }
+    if (page == SSD1306_PAGES) {
+        if (dev->flush_start_us) {
+            uint32_t flush_us = esp_timer_get_time() - dev->flush_start_us;
+            portENTER_CRITICAL(&dev->stats_lock);
+            dev->flush_stats.frames++;
+            dev->flush_stats.flush_us = flush_us;
+            dev->flush_stats.bytes = dev->flush_bytes;
+            dev->flush_stats.dirty_columns = dev->flush_columns;
+            portEXIT_CRITICAL(&dev->stats_lock);
+            dev->flush_start_us = 0;
+        }
+        *done = true;
+        return ESP_OK;
+    }
+    *done = false;
     
-    // Set charge pump
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_CHARGE_PUMP);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0x14);
-    if (ret != ESP_OK) return ret;
+    if (dev->flush_start_us == 0) {
+        dev->flush_start_us = esp_timer_get_time();
+        dev->flush_bytes = 0;
+        dev->flush_columns = 0;
+    }
     
-    // Set memory addressing mode
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_MEMORY_ADDR_MODE);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0x00); // Horizontal addressing mode
-    if (ret != ESP_OK) return ret;
+    // Merge consecutive pages with the same dirty columns into one window
+    uint8_t x0 = dirty->x0[page];
+    uint8_t x1 = dirty->x1[page];
+    uint8_t last = page;
+    while (last + 1 < SSD1306_PAGES && last + 1 - page < max_pages &&
+           dirty->x0[last + 1] == x0 && dirty->x1[last + 1] == x1) {
+        last++;
+    }
     
-    // Set segment re-map
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SEGREMAP | 0x01);
-    if (ret != ESP_OK) return ret;
+    const uint8_t window_cmds[] = {
+        SSD1306_CMD_SET_COLUMN_RANGE, x0, x1,
+        SSD1306_CMD_SET_PAGE_RANGE, page, last,
+    };
+    esp_err_t ret = ssd1306_write_cmds(dev, window_cmds, sizeof(window_cmds));
+    if (ret == ESP_OK) {
+        // The controller wraps within the column range, so the whole window is one transfer
+        ret = ssd1306_write_window(dev, buf, x0, x1, page, last);
+    }
+    if (ret != ESP_OK) {
+        // Leave the pages dirty so the next refresh retries; it is timed from its own start
+        dev->flush_start_us = 0;
+        return ret;
+    }
+    for (uint8_t p = page; p <= last; p++) {
+        ssd1306_mark_clean(dirty, p);
+    }
     
-    // Set COM output scan direction
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_COMSCAN_DEC);
-    if (ret != ESP_OK) return ret;
+    uint16_t columns = (x1 - x0 + 1) * (last - page + 1);
+    dev->flush_bytes += 1 + sizeof(window_cmds) + 1 + columns;
+    dev->flush_columns += columns;
+    return ESP_OK;
+}
+
+// Send the dirty windows of buf to the panel, marking each page clean once it is on the wire
+static esp_err_t ssd1306_flush(ssd1306_handle_t dev, const uint8_t *buf, ssd1306_dirty_t *dirty)
+{
+    bool done = false;
+    while (!done) {
+        esp_err_t ret = ssd1306_flush_window(dev, buf, dirty, SSD1306_PAGES, &done);
+        if (ret != ESP_OK) return ret;
+    }
+    return ESP_OK;
+}
+
+static void ssd1306_flush_task(void *arg)
+{
+    ssd1306_handle_t dev = (ssd1306_handle_t)arg;
     
-    // Set COM pins hardware configuration
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_COMPINS);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0x12);
-    if (ret != ESP_OK) return ret;
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (dev->flush_exit) {
+            break;
+        }
+        
+        ssd1306_flush(dev, dev->front, &dev->front_dirty);
+        xSemaphoreGive(dev->flush_idle);
+    }
     
-    // Set contrast control
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_CONTRAST);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0xCF);
-    if (ret != ESP_OK) return ret;
+    xSemaphoreGive(dev->flush_idle);
+    vTaskDelete(NULL);
+}
+
+esp_err_t ssd1306_alloc_front(ssd1306_handle_t dev)
+{
+    if (dev->front == NULL) {
+        dev->front = malloc(SSD1306_BUFFER_SIZE);
+        dev->flush_idle = xSemaphoreCreateBinary();
+        if (dev->front == NULL || dev->flush_idle == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate front buffer");
+            if (dev->flush_idle) {
+                vSemaphoreDelete(dev->flush_idle);
+                dev->flush_idle = NULL;
+            }
+            free(dev->front);
+            dev->front = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+        xSemaphoreGive(dev->flush_idle);
+    }
     
-    // Set pre-charge period
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_PRECHARGE);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0xF1);
-    if (ret != ESP_OK) return ret;
+    // The front buffer starts out matching the back buffer; pending dirty state stays with gram
+    memcpy(dev->front, dev->gram, SSD1306_BUFFER_SIZE);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_enable_async(ssd1306_handle_t dev, uint32_t task_priority)
+{
+    if (dev == NULL || dev->gram == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dev->bus) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (dev->flush_task) {
+        return ESP_OK;
+    }
     
-    // Set VCOM deselect level
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_VCOM_DETECT);
-    if (ret != ESP_OK) return ret;
-    ret = ssd1306_write_cmd(dev, 0x40);
+    esp_err_t ret = ssd1306_alloc_front(dev);
     if (ret != ESP_OK) return ret;
     
-    // Display all on resume
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_DISPLAY_ALL_ON_RESUME);
-    if (ret != ESP_OK) return ret;
+    if (xTaskCreate(ssd1306_flush_task, "ssd1306_flush", 2048, dev, task_priority, &dev->flush_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create flush task");
+        dev->flush_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
     
-    // Normal display
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_NORMAL_DISPLAY);
-    if (ret != ESP_OK) return ret;
+    ESP_LOGI(TAG, "Asynchronous refresh enabled");
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_refresh_gram_async(ssd1306_handle_t dev)
+{
+    if (dev == NULL || dev->gram == NULL) {
+        ESP_LOGE(TAG, "Invalid device handle");
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Display ON
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_DISPLAY_ON);
-    if (ret != ESP_OK) return ret;
+    // GRAM must not be written while the panel scrolls; changes go out after ssd1306_stop_scroll().
+    // A sleeping panel keeps its GRAM, so changes made meanwhile simply stay dirty until wake-up.
+    if (dev->hw_scroll || dev->asleep) {
+        return ESP_OK;
+    }
     
-    // Clear GRAM
-    memset(dev->gram, 0, SSD1306_BUFFER_SIZE);
+    if (dev->flush_task == NULL) {
+        return ssd1306_flush(dev, dev->gram, &dev->dirty);
+    }
     
-    ESP_LOGI(TAG, "SSD1306 initialization completed successfully");
+    // Back-pressure: at most one frame is in flight
+    xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
+    
+    // Hand the changed windows to the front buffer; copying only dirty columns is
+    // cheaper than swapping and then re-syncing the whole back buffer
+    bool pending = false;
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        if (ssd1306_page_is_dirty(&dev->dirty, page)) {
+            uint8_t x0 = dev->dirty.x0[page];
+            uint8_t x1 = dev->dirty.x1[page];
+            uint16_t offset = page * SSD1306_WIDTH + x0;
+            memcpy(&dev->front[offset], &dev->gram[offset], x1 - x0 + 1);
+            ssd1306_mark_dirty(&dev->front_dirty, page, x0, x1);
+            ssd1306_mark_clean(&dev->dirty, page);
+        }
+        pending |= ssd1306_page_is_dirty(&dev->front_dirty, page);
+    }
+    
+    if (!pending) {
+        xSemaphoreGive(dev->flush_idle);
+        return ESP_OK;
+    }
+    
+    if (dev->bus) {
+        ssd1306_bus_submit(dev);
+    } else {
+        xTaskNotifyGive(dev->flush_task);
+    }
     return ESP_OK;
 }
 
-void ssd1306_clear_screen(ssd1306_handle_t dev, uint8_t chFill)
+esp_err_t ssd1306_wait_flush(ssd1306_handle_t dev, uint32_t timeout_ms)
 {
-    if (dev && dev->gram) {
-        memset(dev->gram, chFill, SSD1306_BUFFER_SIZE);
+    if (dev == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dev->flush_task == NULL) {
+        return ESP_OK;
     }
+    
+    if (xSemaphoreTake(dev->flush_idle, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    xSemaphoreGive(dev->flush_idle);
+    return ESP_OK;
 }
 
 void ssd1306_refresh_gram(ssd1306_handle_t dev)
@@ -441,26 +480,260 @@ void ssd1306_refresh_gram(ssd1306_handle_t dev)
         return;
     }
     
+    if (dev->hw_scroll || dev->asleep) {
+        return;
+    }
+    
+    if (dev->flush_task) {
+        ssd1306_refresh_gram_async(dev);
+        xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
+        xSemaphoreGive(dev->flush_idle);
+        return;
+    }
+    
+    ssd1306_flush(dev, dev->gram, &dev->dirty);
+}
+
+// Send commands once no frame is in flight, so they do not land in the middle of a flush
+static esp_err_t ssd1306_write_cmds_idle(ssd1306_handle_t dev, const uint8_t *cmds, size_t len)
+{
+    if (dev->flush_task == NULL) {
+        return ssd1306_write_cmds(dev, cmds, len);
+    }
+    
+    xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
+    esp_err_t ret = ssd1306_write_cmds(dev, cmds, len);
+    xSemaphoreGive(dev->flush_idle);
+    return ret;
+}
+
+esp_err_t ssd1306_set_contrast(ssd1306_handle_t dev, uint8_t contrast)
+{
+    if (dev == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (contrast == dev->contrast) {
+        return ESP_OK;
+    }
+    
+    const uint8_t cmds[] = {SSD1306_CMD_SET_CONTRAST, contrast};
+    esp_err_t ret = ssd1306_write_cmds_idle(dev, cmds, sizeof(cmds));
+    if (ret == ESP_OK) {
+        dev->contrast = contrast;
+    }
+    return ret;
+}
+
+esp_err_t ssd1306_set_sleep(ssd1306_handle_t dev, bool sleep)
+{
+    if (dev == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (sleep == dev->asleep) {
+        return ESP_OK;
+    }
+    
+    // The charge pump may only be switched while the display is off
+    static const uint8_t sleep_cmds[] = {
+        SSD1306_CMD_DISPLAY_OFF,
+        SSD1306_CMD_CHARGE_PUMP, 0x10,
+    };
+    static const uint8_t wake_cmds[] = {
+        SSD1306_CMD_CHARGE_PUMP, 0x14,
+        SSD1306_CMD_DISPLAY_ON,
+    };
+    
     esp_err_t ret;
+    if (sleep) {
+        ret = ssd1306_write_cmds_idle(dev, sleep_cmds, sizeof(sleep_cmds));
+        if (ret == ESP_OK) {
+            dev->asleep = true;
+        }
+    } else {
+        // Bring GRAM up to date before the panel lights up again
+        dev->asleep = false;
+        ssd1306_refresh_gram(dev);
+        ret = ssd1306_write_cmds_idle(dev, wake_cmds, sizeof(wake_cmds));
+        if (ret != ESP_OK) {
+            dev->asleep = true;
+        }
+    }
+    return ret;
+}
+
+bool ssd1306_is_sleeping(ssd1306_handle_t dev)
+{
+    return dev && dev->asleep;
+}
+
+esp_err_t ssd1306_set_precharge(ssd1306_handle_t dev, uint8_t phase1, uint8_t phase2)
+{
+    if (dev == NULL || phase1 < 1 || phase1 > 15 || phase2 < 1 || phase2 > 15) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    const uint8_t cmds[] = {SSD1306_CMD_SET_PRECHARGE, (phase2 << 4) | phase1};
+    return ssd1306_write_cmds_idle(dev, cmds, sizeof(cmds));
+}
+
+esp_err_t ssd1306_set_start_line(ssd1306_handle_t dev, uint8_t line)
+{
+    if (dev == NULL || line >= SSD1306_HEIGHT) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Set column address range
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_COLUMN_RANGE);
-    if (ret != ESP_OK) return;
-    ret = ssd1306_write_cmd(dev, 0);
-    if (ret != ESP_OK) return;
-    ret = ssd1306_write_cmd(dev, SSD1306_WIDTH - 1);
-    if (ret != ESP_OK) return;
+    const uint8_t cmd = SSD1306_CMD_SET_START_LINE | line;
+    esp_err_t ret = ssd1306_write_cmds_idle(dev, &cmd, 1);
+    if (ret == ESP_OK) {
+        dev->start_line = line;
+    }
+    return ret;
+}
+
+esp_err_t ssd1306_start_scroll(ssd1306_handle_t dev, ssd1306_scroll_dir_t dir, uint8_t start_page,
+                               uint8_t end_page, uint8_t interval, uint8_t vertical_offset)
+{
+    if (dev == NULL || start_page > end_page || end_page >= SSD1306_PAGES ||
+        interval > 7 || vertical_offset >= SSD1306_HEIGHT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dev->ticker_fill) {
+        return ESP_ERR_INVALID_STATE;
+    }
     
-    // Set page address range
-    ret = ssd1306_write_cmd(dev, SSD1306_CMD_SET_PAGE_RANGE);
-    if (ret != ESP_OK) return;
-    ret = ssd1306_write_cmd(dev, 0);
-    if (ret != ESP_OK) return;
-    ret = ssd1306_write_cmd(dev, (SSD1306_HEIGHT / 8) - 1);
-    if (ret != ESP_OK) return;
+    // Scroll setup is only valid while scrolling is deactivated
+    uint8_t cmds[12];
+    size_t len = 0;
+    cmds[len++] = SSD1306_CMD_SCROLL_DEACTIVATE;
+    if (vertical_offset == 0) {
+        cmds[len++] = (dir == SSD1306_SCROLL_LEFT) ? SSD1306_CMD_SCROLL_LEFT : SSD1306_CMD_SCROLL_RIGHT;
+        cmds[len++] = 0x00;
+        cmds[len++] = start_page;
+        cmds[len++] = interval;
+        cmds[len++] = end_page;
+        cmds[len++] = 0x00;
+        cmds[len++] = 0xFF;
+    } else {
+        cmds[len++] = SSD1306_CMD_SET_VERT_SCROLL_AREA;
+        cmds[len++] = 0x00;
+        cmds[len++] = SSD1306_HEIGHT;
+        cmds[len++] = (dir == SSD1306_SCROLL_LEFT) ? SSD1306_CMD_SCROLL_VERT_LEFT : SSD1306_CMD_SCROLL_VERT_RIGHT;
+        cmds[len++] = 0x00;
+        cmds[len++] = start_page;
+        cmds[len++] = interval;
+        cmds[len++] = end_page;
+        cmds[len++] = vertical_offset;
+    }
+    cmds[len++] = SSD1306_CMD_SCROLL_ACTIVATE;
     
-    // Send GRAM data to display
-    ssd1306_write_data(dev, dev->gram, SSD1306_BUFFER_SIZE);
+    esp_err_t ret = ssd1306_write_cmds_idle(dev, cmds, len);
+    if (ret == ESP_OK) {
+        dev->hw_scroll = true;
+    }
+    return ret;
+}
+
+esp_err_t ssd1306_stop_scroll(ssd1306_handle_t dev)
+{
+    if (dev == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    const uint8_t cmd = SSD1306_CMD_SCROLL_DEACTIVATE;
+    esp_err_t ret = ssd1306_write_cmds_idle(dev, &cmd, 1);
+    if (ret != ESP_OK) return ret;
+    
+    // The scroll has moved data around inside the panel, so GRAM no longer matches it
+    dev->hw_scroll = false;
+    ssd1306_invalidate(dev);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_ticker_start(ssd1306_handle_t dev, ssd1306_ticker_fill_t fill, void *arg)
+{
+    if (dev == NULL || dev->gram == NULL || fill == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dev->hw_scroll) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    dev->ticker_fill = fill;
+    dev->ticker_arg = arg;
+    dev->ticker_seq = 0;
+    
+    // Each new page of content is fetched when its first row is about to scroll in
+    if (dev->start_line % 8 != 0) {
+        memset(dev->ticker_page, 0, sizeof(dev->ticker_page));
+        fill(dev->ticker_page, dev->ticker_seq++, arg);
+    }
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_ticker_step(ssd1306_handle_t dev)
+{
+    if (dev == NULL || dev->ticker_fill == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // The row at the top of the screen is the one that reappears at the bottom
+    // once the start line advances, so it gets the next row of new content
+    uint8_t row = dev->start_line;
+    uint8_t page = row / 8;
+    uint8_t bit = 1 << (row % 8);
+    
+    if (bit == 0x01) {
+        memset(dev->ticker_page, 0, sizeof(dev->ticker_page));
+        dev->ticker_fill(dev->ticker_page, dev->ticker_seq++, dev->ticker_arg);
+    }
+    
+    uint8_t *dst = &dev->gram[page * SSD1306_WIDTH];
+    for (uint8_t x = 0; x < SSD1306_WIDTH; x++) {
+        uint8_t value = (dst[x] & ~bit) | (dev->ticker_page[x] & bit);
+        if (value != dst[x]) {
+            dst[x] = value;
+            ssd1306_mark_dirty(&dev->dirty, page, x, x);
+        }
+    }
+    
+    // The row must be in the panel's GRAM before it becomes visible
+    esp_err_t ret = ssd1306_refresh_gram_async(dev);
+    if (ret == ESP_OK) {
+        ret = ssd1306_wait_flush(dev, SSD1306_TIMEOUT_MS);
+    }
+    if (ret != ESP_OK) return ret;
+    
+    return ssd1306_set_start_line(dev, (row + 1) % SSD1306_HEIGHT);
+}
+
+esp_err_t ssd1306_ticker_stop(ssd1306_handle_t dev)
+{
+    if (dev == NULL || dev->gram == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    dev->ticker_fill = NULL;
+    dev->ticker_arg = NULL;
+    
+    uint8_t shift = dev->start_line;
+    if (shift == 0) {
+        return ESP_OK;
+    }
+    
+    // Rotate each column so the visible image stays put with the start line back at 0
+    for (uint8_t x = 0; x < SSD1306_WIDTH; x++) {
+        uint64_t column = 0;
+        for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+            column |= (uint64_t)dev->gram[page * SSD1306_WIDTH + x] << (page * 8);
+        }
+        column = (column >> shift) | (column << (SSD1306_HEIGHT - shift));
+        for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+            dev->gram[page * SSD1306_WIDTH + x] = column >> (page * 8);
+        }
+    }
+    ssd1306_invalidate(dev);
+    
+    return ssd1306_set_start_line(dev, 0);
 }
 
 void ssd1306_draw_point(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chPoint)
@@ -476,121 +749,321 @@ void ssd1306_draw_point(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, ui
     uint8_t page = chYpos / 8;
     uint8_t bit = chYpos % 8;
     uint16_t gram_index = chXpos + page * SSD1306_WIDTH;
+    uint8_t old_value = dev->gram[gram_index];
+    uint8_t new_value;
     
     if (chPoint) {
-        dev->gram[gram_index] |= (1 << bit);
+        new_value = old_value | (1 << bit);
     } else {
-        dev->gram[gram_index] &= ~(1 << bit);
+        new_value = old_value & ~(1 << bit);
+    }
+    
+    if (new_value != old_value) {
+        dev->gram[gram_index] = new_value;
+        ssd1306_mark_dirty(&dev->dirty, page, chXpos, chXpos);
     }
 }
 
-void ssd1306_draw_line(ssd1306_handle_t dev, uint8_t chXpos0, uint8_t chYpos0, uint8_t chXpos1, uint8_t chYpos1, uint8_t chMode)
+// Set or clear the bits of mask in len consecutive bytes of a page row, a word at a time.
+// Returns true if any byte changed.
+static bool ssd1306_apply_span(uint8_t *row, size_t len, uint8_t mask, uint8_t chMode)
+{
+    uint8_t diff = 0;
+    
+    if (mask == 0xFF) {
+        uint8_t fill = chMode ? 0xFF : 0x00;
+        for (size_t i = 0; i < len; i++) {
+            diff |= row[i] ^ fill;
+        }
+        if (diff) {
+            memset(row, fill, len);
+        }
+        return diff != 0;
+    }
+    
+    // Head bytes up to word alignment
+    while (len > 0 && ((uintptr_t)row & 3)) {
+        uint8_t value = chMode ? (*row | mask) : (*row & ~mask);
+        diff |= *row ^ value;
+        *row++ = value;
+        len--;
+    }
+    
+    // Four columns per iteration
+    uint32_t mask32 = mask * 0x01010101u;
+    uint32_t diff32 = 0;
+    while (len >= 4) {
+        uint32_t word;
+        memcpy(&word, row, sizeof(word));
+        uint32_t value = chMode ? (word | mask32) : (word & ~mask32);
+        diff32 |= word ^ value;
+        memcpy(row, &value, sizeof(value));
+        row += 4;
+        len -= 4;
+    }
+    
+    // Tail bytes
+    while (len > 0) {
+        uint8_t value = chMode ? (*row | mask) : (*row & ~mask);
+        diff |= *row ^ value;
+        *row++ = value;
+        len--;
+    }
+    
+    return diff != 0 || diff32 != 0;
+}
+
+void ssd1306_fill_rect(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight, uint8_t chMode)
 {
-    int t;
-    int xerr = 0, yerr = 0, delta_x, delta_y, distance;
-    int incx, incy, uRow, uCol;
+    if (dev == NULL || dev->gram == NULL) {
+        return;
+    }
     
-    delta_x = chXpos1 - chXpos0;
-    delta_y = chYpos1 - chYpos0;
-    uRow = chXpos0;
-    uCol = chYpos0;
+    if (chXpos >= SSD1306_WIDTH || chYpos >= SSD1306_HEIGHT || chWidth == 0 || chHeight == 0) {
+        return;
+    }
+    
+    // Clip to the panel; x1/y1 are inclusive
+    uint8_t x1 = (chXpos + chWidth > SSD1306_WIDTH) ? SSD1306_WIDTH - 1 : chXpos + chWidth - 1;
+    uint8_t y1 = (chYpos + chHeight > SSD1306_HEIGHT) ? SSD1306_HEIGHT - 1 : chYpos + chHeight - 1;
+    uint8_t page0 = chYpos / 8;
+    uint8_t page1 = y1 / 8;
     
-    if (delta_x > 0) incx = 1;
-    else if (delta_x == 0) incx = 0;
-    else {
-        incx = -1;
-        delta_x = -delta_x;
+    for (uint8_t page = page0; page <= page1; page++) {
+        uint8_t mask = 0xFF;
+        if (page == page0) mask &= 0xFF << (chYpos % 8);
+        if (page == page1) mask &= 0xFF >> (7 - y1 % 8);
+        
+        if (ssd1306_apply_span(&dev->gram[page * SSD1306_WIDTH + chXpos], x1 - chXpos + 1, mask, chMode)) {
+            ssd1306_mark_dirty(&dev->dirty, page, chXpos, x1);
+        }
+    }
+}
+
+void ssd1306_invert_rect(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight)
+{
+    if (dev == NULL || dev->gram == NULL) {
+        return;
     }
     
-    if (delta_y > 0) incy = 1;
-    else if (delta_y == 0) incy = 0;
-    else {
-        incy = -1;
-        delta_y = -delta_y;
+    if (chXpos >= SSD1306_WIDTH || chYpos >= SSD1306_HEIGHT || chWidth == 0 || chHeight == 0) {
+        return;
     }
     
-    if (delta_x > delta_y) distance = delta_x;
-    else distance = delta_y;
+    // Same clipping and page masks as ssd1306_fill_rect(); every byte changes
+    uint8_t x1 = (chXpos + chWidth > SSD1306_WIDTH) ? SSD1306_WIDTH - 1 : chXpos + chWidth - 1;
+    uint8_t y1 = (chYpos + chHeight > SSD1306_HEIGHT) ? SSD1306_HEIGHT - 1 : chYpos + chHeight - 1;
+    uint8_t page0 = chYpos / 8;
+    uint8_t page1 = y1 / 8;
     
-    for (t = 0; t <= distance + 1; t++) {
-        ssd1306_draw_point(dev, uRow, uCol, chMode);
-        xerr += delta_x;
-        yerr += delta_y;
-        if (xerr > distance) {
-            xerr -= distance;
-            uRow += incx;
+    for (uint8_t page = page0; page <= page1; page++) {
+        uint8_t mask = 0xFF;
+        if (page == page0) mask &= 0xFF << (chYpos % 8);
+        if (page == page1) mask &= 0xFF >> (7 - y1 % 8);
+        
+        uint8_t *row = &dev->gram[page * SSD1306_WIDTH];
+        for (uint8_t x = chXpos; x <= x1; x++) {
+            row[x] ^= mask;
         }
-        if (yerr > distance) {
-            yerr -= distance;
-            uCol += incy;
+        ssd1306_mark_dirty(&dev->dirty, page, chXpos, x1);
+    }
+}
+
+void ssd1306_shift_left(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight, uint8_t chShift)
+{
+    if (dev == NULL || dev->gram == NULL) {
+        return;
+    }
+    
+    if (chXpos >= SSD1306_WIDTH || chYpos >= SSD1306_HEIGHT || chWidth == 0 || chHeight == 0 || chShift == 0) {
+        return;
+    }
+    
+    // Same clipping and page masks as ssd1306_fill_rect()
+    uint8_t x1 = (chXpos + chWidth > SSD1306_WIDTH) ? SSD1306_WIDTH - 1 : chXpos + chWidth - 1;
+    uint8_t y1 = (chYpos + chHeight > SSD1306_HEIGHT) ? SSD1306_HEIGHT - 1 : chYpos + chHeight - 1;
+    uint8_t page0 = chYpos / 8;
+    uint8_t page1 = y1 / 8;
+    size_t width = x1 - chXpos + 1;
+    size_t kept = chShift < width ? width - chShift : 0;
+    
+    for (uint8_t page = page0; page <= page1; page++) {
+        uint8_t mask = 0xFF;
+        if (page == page0) mask &= 0xFF << (chYpos % 8);
+        if (page == page1) mask &= 0xFF >> (7 - y1 % 8);
+        
+        uint8_t *row = &dev->gram[page * SSD1306_WIDTH + chXpos];
+        if (mask == 0xFF) {
+            memmove(row, row + chShift, kept);
+        } else {
+            for (size_t i = 0; i < kept; i++) {
+                row[i] = (row[i] & ~mask) | (row[i + chShift] & mask);
+            }
         }
+        ssd1306_apply_span(row + kept, width - kept, mask, 0);
+        ssd1306_mark_dirty(&dev->dirty, page, chXpos, x1);
     }
 }
 
+void ssd1306_draw_hline(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chMode)
+{
+    ssd1306_fill_rect(dev, chXpos, chYpos, chWidth, 1, chMode);
+}
+
+void ssd1306_draw_vline(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chHeight, uint8_t chMode)
+{
+    ssd1306_fill_rect(dev, chXpos, chYpos, 1, chHeight, chMode);
+}
+
+void ssd1306_draw_line(ssd1306_handle_t dev, uint8_t chXpos0, uint8_t chYpos0, uint8_t chXpos1, uint8_t chYpos1, uint8_t chMode)
+{
+    ssd1306_gfx_line(dev, chXpos0, chYpos0, chXpos1, chYpos1, chMode);
+}
+
 void ssd1306_draw_rectangle(ssd1306_handle_t dev, uint8_t chXpos0, uint8_t chYpos0, uint8_t chWidth, uint8_t chHeight, uint8_t chMode)
 {
-    ssd1306_draw_line(dev, chXpos0, chYpos0, chXpos0 + chWidth, chYpos0, chMode);
-    ssd1306_draw_line(dev, chXpos0, chYpos0, chXpos0, chYpos0 + chHeight, chMode);
-    ssd1306_draw_line(dev, chXpos0, chYpos0 + chHeight, chXpos0 + chWidth, chYpos0 + chHeight, chMode);
-    ssd1306_draw_line(dev, chXpos0 + chWidth, chYpos0, chXpos0 + chWidth, chYpos0 + chHeight, chMode);
+    // Width and height are inclusive here: the outline spans chWidth + 1 columns
+    ssd1306_gfx_rect(dev, chXpos0, chYpos0, chWidth + 1, chHeight + 1, chMode);
 }
 
-void ssd1306_show_char(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chChr, uint8_t chSize, uint8_t chMode)
+const ssd1306_font_t *ssd1306_font_for_size(uint8_t chSize)
 {
-    if (dev == NULL) return;
+    switch (chSize) {
+        case SSD1306_FONT_SIZE_8:
+            return &ssd1306_font_6x8;
+        case SSD1306_FONT_SIZE_16:
+            return &ssd1306_font_8x16;
+        default:
+            return NULL;
+    }
+}
+
+// Look up a glyph's width and column data, substituting space for unknown characters
+static const uint8_t *ssd1306_font_glyph(const ssd1306_font_t *font, uint8_t chChr, uint8_t *width)
+{
+    if (chChr < font->first_char || chChr > font->last_char) {
+        chChr = ' ';
+        if (chChr < font->first_char || chChr > font->last_char) {
+            *width = 0;
+            return NULL;
+        }
+    }
+    
+    uint8_t index = chChr - font->first_char;
+    if (font->widths) {
+        *width = font->widths[index];
+        return &font->bitmap[font->offsets[index]];
+    }
+    
+    *width = font->width;
+    return &font->bitmap[index * font->width * (font->height / 8)];
+}
+
+uint8_t ssd1306_draw_glyph(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chChr, const ssd1306_font_t *font, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL || font == NULL) return 0;
+    
+    uint8_t width;
+    const uint8_t *glyph = ssd1306_font_glyph(font, chChr, &width);
+    if (glyph == NULL) return 0;
+    
+    uint8_t advance = width + font->spacing;
     
     // Check bounds
-    if (chXpos >= SSD1306_WIDTH || chYpos >= SSD1306_HEIGHT) return;
+    if (chXpos >= SSD1306_WIDTH || chYpos >= SSD1306_HEIGHT) return advance;
     
-    // Check if character is printable (ASCII 32-126)
-    if (chChr < 32 || chChr > 126) {
-        chChr = 32; // Use space for unprintable characters
-    }
+    // Mode 1 ORs the glyph in; mode 0 clears the whole character cell
+    uint8_t columns = chMode ? width : advance;
+    if (chXpos + columns > SSD1306_WIDTH) columns = SSD1306_WIDTH - chXpos;
     
-    // Get font index (ASCII offset from space character)
-    uint8_t char_index = chChr - 32;
+    uint8_t glyph_pages = font->height / 8;
+    uint8_t page0 = chYpos / 8;
+    uint8_t shift = chYpos % 8;
+    uint8_t changed = 0; // Bit per GRAM page
     
-    if (chSize == 16) {
-        // 8x16 font: each character is 8 pixels wide, 16 pixels tall
-        // Font data is stored as 16 bytes per character (one byte per row)
-        for (int row = 0; row < 16; row++) {
-            uint8_t font_data = font8x16[char_index][row];
+    for (uint8_t gp = 0; gp < glyph_pages; gp++) {
+        // Page-aligned glyph rows map onto exactly one GRAM page, unaligned ones straddle two
+        uint8_t span = shift ? 2 : 1;
+        if (page0 + gp >= SSD1306_PAGES) break;
+        if (page0 + gp + span > SSD1306_PAGES) span = 1;
+        
+        const uint8_t *src = &glyph[gp * width];
+        uint8_t *dst = &dev->gram[(page0 + gp) * SSD1306_WIDTH + chXpos];
+        
+        for (uint8_t col = 0; col < columns; col++) {
+            uint16_t bits = chMode ? src[col] : 0xFF;
+            bits <<= shift;
             
-            // Draw 8 pixels for this row
-            for (int col = 0; col < 8; col++) {
-                // Check if we're within display bounds
-                if ((chXpos + col) < SSD1306_WIDTH && (chYpos + row) < SSD1306_HEIGHT) {
-                    // Check bit (MSB first: bit 7 = leftmost pixel)
-                    if (font_data & (0x80 >> col)) {
-                        ssd1306_draw_point(dev, chXpos + col, chYpos + row, chMode);
-                    } else if (chMode == 0) {
-                        // If drawing in "erase" mode, clear the pixel
-                        ssd1306_draw_point(dev, chXpos + col, chYpos + row, 0);
-                    }
+            for (uint8_t k = 0; k < span; k++) {
+                uint8_t mask = bits >> (8 * k);
+                uint8_t *cell = &dst[col + k * SSD1306_WIDTH];
+                uint8_t value = chMode ? (*cell | mask) : (*cell & ~mask);
+                if (value != *cell) {
+                    *cell = value;
+                    changed |= 1 << (page0 + gp + k);
                 }
             }
         }
     }
+    
+    for (uint8_t page = page0; changed; page++) {
+        if (changed & (1 << page)) {
+            ssd1306_mark_dirty(&dev->dirty, page, chXpos, chXpos + columns - 1);
+            changed &= ~(1 << page);
+        }
+    }
+    
+    return advance;
 }
 
-void ssd1306_show_string(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, const char *pchString, uint8_t chSize, uint8_t chMode)
+void ssd1306_show_char(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, uint8_t chChr, uint8_t chSize, uint8_t chMode)
+{
+    const ssd1306_font_t *font = ssd1306_font_for_size(chSize);
+    if (font == NULL) return;
+    
+    ssd1306_draw_glyph(dev, chXpos, chYpos, chChr, font, chMode);
+}
+
+void ssd1306_show_string_font(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, const char *pchString, const ssd1306_font_t *font, uint8_t chMode)
 {
     uint8_t chXpos0 = chXpos;
     
-    if (dev == NULL || pchString == NULL) return;
+    if (dev == NULL || pchString == NULL || font == NULL) return;
     
     while (*pchString != '\0') {
-        if (chXpos > (SSD1306_WIDTH - 8)) { // 8 pixels wide per character
+        uint8_t width;
+        ssd1306_font_glyph(font, *pchString, &width);
+        
+        if (chXpos + width + font->spacing > SSD1306_WIDTH) {
             chXpos = chXpos0;
-            chYpos += chSize;
+            chYpos += font->height;
         }
-        if (chYpos > (SSD1306_HEIGHT - chSize)) {
+        if (chYpos > (SSD1306_HEIGHT - font->height)) {
             chYpos = chXpos = 0;
             ssd1306_clear_screen(dev, 0x00);
         }
         
-        ssd1306_show_char(dev, chXpos, chYpos, *pchString, chSize, chMode);
-        chXpos += 8; // Move to next character position (8 pixels wide)
+        chXpos += ssd1306_draw_glyph(dev, chXpos, chYpos, *pchString, font, chMode);
         pchString++;
     }
 }
+
+uint16_t ssd1306_text_width(const ssd1306_font_t *font, const char *pchString)
+{
+    uint16_t width = 0;
+    
+    if (font == NULL || pchString == NULL) return 0;
+    
+    while (*pchString != '\0') {
+        uint8_t glyph_width;
+        ssd1306_font_glyph(font, *pchString++, &glyph_width);
+        width += glyph_width + font->spacing;
+    }
+    
+    return width;
+}
+
+void ssd1306_show_string(ssd1306_handle_t dev, uint8_t chXpos, uint8_t chYpos, const char *pchString, uint8_t chSize, uint8_t chMode)
+{
+    ssd1306_show_string_font(dev, chXpos, chYpos, pchString, ssd1306_font_for_size(chSize), chMode);
+}
@@ -0,0 +1,223 @@
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "ssd1306_bus.h"
+#include "ssd1306_priv.h"
+
+static const char *TAG = "SSD1306_BUS";
+
+// Pages sent per panel before the scheduler moves on to the next one
+#define SSD1306_BUS_PAGES_PER_TURN          2
+
+typedef struct {
+    ssd1306_handle_t dev;
+    volatile bool pending;
+    int64_t submit_time;
+    uint64_t total_latency_us;
+    ssd1306_bus_stats_t stats;
+} ssd1306_bus_slot_t;
+
+struct ssd1306_bus {
+    ssd1306_bus_slot_t slots[SSD1306_BUS_MAX_PANELS];
+    SemaphoreHandle_t lock;
+    SemaphoreHandle_t exited;
+    TaskHandle_t task;
+    volatile bool exit;
+};
+
+static void ssd1306_bus_finish_frame(ssd1306_bus_slot_t *slot)
+{
+    uint32_t latency = esp_timer_get_time() - slot->submit_time;
+    
+    slot->stats.frames++;
+    slot->stats.last_latency_us = latency;
+    if (latency > slot->stats.max_latency_us) {
+        slot->stats.max_latency_us = latency;
+    }
+    slot->total_latency_us += latency;
+    slot->stats.avg_latency_us = slot->total_latency_us / slot->stats.frames;
+    
+    slot->pending = false;
+    xSemaphoreGive(slot->dev->flush_idle);
+}
+
+static void ssd1306_bus_task(void *arg)
+{
+    ssd1306_bus_handle_t bus = (ssd1306_bus_handle_t)arg;
+    
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (bus->exit) {
+            break;
+        }
+        
+        // Round-robin over the pending panels, one window each per round
+        bool busy = true;
+        while (busy) {
+            busy = false;
+            xSemaphoreTake(bus->lock, portMAX_DELAY);
+            for (int i = 0; i < SSD1306_BUS_MAX_PANELS; i++) {
+                ssd1306_bus_slot_t *slot = &bus->slots[i];
+                if (slot->dev == NULL || !slot->pending) {
+                    continue;
+                }
+                
+                bool done;
+                esp_err_t ret = ssd1306_flush_window(slot->dev, slot->dev->front, &slot->dev->front_dirty,
+                                                     SSD1306_BUS_PAGES_PER_TURN, &done);
+                if (ret != ESP_OK || done) {
+                    // Failed pages stay dirty and go out with the next frame
+                    ssd1306_bus_finish_frame(slot);
+                } else {
+                    busy = true;
+                }
+            }
+            xSemaphoreGive(bus->lock);
+        }
+    }
+    
+    xSemaphoreGive(bus->exited);
+    vTaskDelete(NULL);
+}
+
+esp_err_t ssd1306_bus_create(uint32_t task_priority, ssd1306_bus_handle_t *ret_bus)
+{
+    if (ret_bus == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    ssd1306_bus_handle_t bus = calloc(1, sizeof(struct ssd1306_bus));
+    if (bus == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate bus scheduler");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    bus->lock = xSemaphoreCreateMutex();
+    bus->exited = xSemaphoreCreateBinary();
+    if (bus->lock == NULL || bus->exited == NULL) {
+        ESP_LOGE(TAG, "Failed to create bus semaphores");
+        goto err;
+    }
+    
+    if (xTaskCreate(ssd1306_bus_task, "ssd1306_bus", 2048, bus, task_priority, &bus->task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create bus task");
+        goto err;
+    }
+    
+    *ret_bus = bus;
+    return ESP_OK;
+    
+err:
+    if (bus->lock) {
+        vSemaphoreDelete(bus->lock);
+    }
+    if (bus->exited) {
+        vSemaphoreDelete(bus->exited);
+    }
+    free(bus);
+    return ESP_ERR_NO_MEM;
+}
+
+void ssd1306_bus_delete(ssd1306_bus_handle_t bus)
+{
+    if (bus == NULL) return;
+    
+    for (int i = 0; i < SSD1306_BUS_MAX_PANELS; i++) {
+        if (bus->slots[i].dev) {
+            ssd1306_bus_remove_panel(bus, bus->slots[i].dev);
+        }
+    }
+    
+    bus->exit = true;
+    xTaskNotifyGive(bus->task);
+    xSemaphoreTake(bus->exited, portMAX_DELAY);
+    
+    vSemaphoreDelete(bus->lock);
+    vSemaphoreDelete(bus->exited);
+    free(bus);
+}
+
+esp_err_t ssd1306_bus_add_panel(ssd1306_bus_handle_t bus, ssd1306_handle_t dev)
+{
+    if (bus == NULL || dev == NULL || dev->gram == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dev->flush_task || dev->bus) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    esp_err_t ret = ssd1306_alloc_front(dev);
+    if (ret != ESP_OK) return ret;
+    
+    xSemaphoreTake(bus->lock, portMAX_DELAY);
+    
+    int slot_index = -1;
+    for (int i = 0; i < SSD1306_BUS_MAX_PANELS; i++) {
+        if (bus->slots[i].dev == NULL) {
+            slot_index = i;
+            break;
+        }
+    }
+    if (slot_index < 0) {
+        xSemaphoreGive(bus->lock);
+        ESP_LOGE(TAG, "No free panel slot");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    ssd1306_bus_slot_t *slot = &bus->slots[slot_index];
+    memset(slot, 0, sizeof(*slot));
+    slot->dev = dev;
+    dev->bus = bus;
+    dev->bus_slot = slot_index;
+    dev->flush_task = bus->task;
+    
+    xSemaphoreGive(bus->lock);
+    
+    ESP_LOGI(TAG, "Panel attached to slot %d", slot_index);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_bus_remove_panel(ssd1306_bus_handle_t bus, ssd1306_handle_t dev)
+{
+    if (bus == NULL || dev == NULL || dev->bus != bus) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // Wait for the in-flight frame; holding flush_idle also keeps new ones out
+    xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
+    
+    xSemaphoreTake(bus->lock, portMAX_DELAY);
+    bus->slots[dev->bus_slot].dev = NULL;
+    dev->bus = NULL;
+    dev->flush_task = NULL;
+    xSemaphoreGive(bus->lock);
+    
+    xSemaphoreGive(dev->flush_idle);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_bus_get_stats(ssd1306_handle_t dev, ssd1306_bus_stats_t *stats)
+{
+    if (dev == NULL || stats == NULL || dev->bus == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // The scheduler task updates the figures under the bus lock
+    xSemaphoreTake(dev->bus->lock, portMAX_DELAY);
+    *stats = dev->bus->slots[dev->bus_slot].stats;
+    xSemaphoreGive(dev->bus->lock);
+    return ESP_OK;
+}
+
+void ssd1306_bus_submit(ssd1306_handle_t dev)
+{
+    ssd1306_bus_slot_t *slot = &dev->bus->slots[dev->bus_slot];
+    
+    slot->submit_time = esp_timer_get_time();
+    slot->pending = true;
+    xTaskNotifyGive(dev->bus->task);
+}
@@ -0,0 +1,452 @@
+#include <stdint.h>
+#include "ssd1306.h"
+
+// Complete 8x16 ASCII font (32-126) - 95 characters
+// Each character is 8 pixels wide, 16 pixels tall
+// Glyphs are stored pre-rotated to match the GRAM layout: bytes 0-7 are the
+// columns of the upper page (rows 0-7), bytes 8-15 the columns of the lower
+// page (rows 8-15). Bit n of a column byte is row n within its page.
+static const uint8_t font8x16[][16] = {
+    // ' ' (32)
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+    // '!' (33)
+    {0x00,0x00,0x38,0xFC,0xFC,0x38,0x00,0x00,0x00,0x00,0x00,0x0D,0x0D,0x00,0x00,0x00},
+    // '"' (34)
+    {0x00,0x1C,0x3C,0x00,0x00,0x3C,0x1C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+    // '#' (35)
+    {0x10,0xFC,0xFC,0x10,0xFC,0xFC,0x10,0x00,0x01,0x07,0x07,0x01,0x07,0x07,0x01,0x00},
+    // '$' (36)
+    {0x70,0xF8,0x88,0xFE,0x88,0x98,0x10,0x00,0x04,0x0C,0x08,0x3F,0x08,0x0F,0x07,0x00},
+    // '%' (37)
+    {0x30,0x30,0x00,0x80,0xC0,0x60,0x30,0x00,0x0C,0x06,0x03,0x01,0x00,0x0C,0x0C,0x00},
+    // '&' (38)
+    {0x80,0xD8,0x7C,0xE4,0xBC,0xD8,0x40,0x00,0x07,0x0F,0x08,0x08,0x07,0x0F,0x08,0x00},
+    // ''' (39)
+    {0x00,0x20,0x3C,0x1C,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+    // '(' (40)
+    {0x00,0x00,0xF0,0xF8,0x0C,0x04,0x00,0x00,0x00,0x00,0x03,0x07,0x0C,0x08,0x00,0x00},
+    // ')' (41)
+    {0x00,0x00,0x04,0x0C,0xF8,0xF0,0x00,0x00,0x00,0x00,0x08,0x0C,0x07,0x03,0x00,0x00},
+    // '*' (42)
+    {0x90,0xA0,0xC0,0xF0,0xF0,0xC0,0xA0,0x90,0x04,0x02,0x01,0x07,0x07,0x01,0x02,0x04},
+    // '+' (43)
+    {0xC0,0xC0,0xC0,0xF8,0xF8,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x07,0x07,0x00,0x00,0x00},
+    // ',' (44)
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,0x1E,0x0E,0x00,0x00,0x00},
+    // '-' (45)
+    {0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+    // '.' (46)
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0C,0x0C,0x00,0x00,0x00},
+    // '/' (47)
+    {0x00,0x00,0x80,0xC0,0x60,0x30,0x18,0x00,0x06,0x03,0x01,0x00,0x00,0x00,0x00,0x00},
+    // '0' (48)
+    {0xF0,0xF8,0x0C,0xC4,0xC4,0x0C,0xF8,0xF0,0x03,0x07,0x0C,0x08,0x08,0x0C,0x07,0x03},
+    // '1' (49)
+    {0x00,0x10,0x08,0xFC,0xFC,0x00,0x00,0x00,0x00,0x08,0x08,0x0F,0x0F,0x08,0x08,0x00},
+    // '2' (50)
+    {0x08,0x0C,0x84,0xC4,0x64,0x3C,0x18,0x00,0x0E,0x0F,0x09,0x08,0x08,0x0C,0x0C,0x00},
+    // '3' (51)
+    {0x08,0x0C,0x44,0x44,0x44,0xFC,0xB8,0x00,0x04,0x0C,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // '4' (52)
+    {0xC0,0xE0,0xB0,0x98,0xFC,0xFC,0x80,0x00,0x00,0x00,0x00,0x08,0x0F,0x0F,0x08,0x00},
+    // '5' (53)
+    {0x7C,0x7C,0x44,0x44,0xC4,0xC4,0x84,0x00,0x04,0x0C,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // '6' (54)
+    {0xF0,0xF8,0x4C,0x44,0x44,0xC0,0x80,0x00,0x07,0x0F,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // '7' (55)
+    {0x0C,0x0C,0x04,0x84,0xC4,0x7C,0x3C,0x00,0x00,0x00,0x0F,0x0F,0x00,0x00,0x00,0x00},
+    // '8' (56)
+    {0xB8,0xFC,0x44,0x44,0x44,0xFC,0xB8,0x00,0x07,0x0F,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // '9' (57)
+    {0x38,0x7C,0x44,0x44,0x44,0xFC,0xF8,0x00,0x00,0x08,0x08,0x08,0x0C,0x07,0x03,0x00},
+    // ':' (58)
+    {0x00,0x00,0x00,0x30,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x06,0x06,0x00,0x00,0x00},
+    // ';' (59)
+    {0x00,0x00,0x00,0x30,0x30,0x00,0x00,0x00,0x00,0x00,0x08,0x0E,0x06,0x00,0x00,0x00},
+    // '<' (60)
+    {0x00,0x80,0xC0,0x60,0x30,0x18,0x08,0x00,0x00,0x00,0x01,0x03,0x06,0x0C,0x08,0x00},
+    // '=' (61)
+    {0x00,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x00},
+    // '>' (62)
+    {0x00,0x08,0x18,0x30,0x60,0xC0,0x80,0x00,0x00,0x08,0x0C,0x06,0x03,0x01,0x00,0x00},
+    // '?' (63)
+    {0x18,0x1C,0x04,0xC4,0xE4,0x3C,0x18,0x00,0x00,0x00,0x00,0x0D,0x0D,0x00,0x00,0x00},
+    // '@' (64)
+    {0xF8,0xFC,0x04,0xE4,0xE4,0xFC,0xF8,0x00,0x03,0x07,0x04,0x05,0x05,0x05,0x00,0x00},
+    // 'A' (65)
+    {0xE0,0xF0,0x98,0x8C,0x98,0xF0,0xE0,0x00,0x0F,0x0F,0x00,0x00,0x00,0x0F,0x0F,0x00},
+    // 'B' (66)
+    {0x04,0xFC,0xFC,0x44,0x44,0xFC,0xB8,0x00,0x08,0x0F,0x0F,0x08,0x08,0x0F,0x07,0x00},
+    // 'C' (67)
+    {0xF0,0xF8,0x0C,0x04,0x04,0x0C,0x18,0x00,0x03,0x07,0x0C,0x08,0x08,0x0C,0x06,0x00},
+    // 'D' (68)
+    {0x04,0xFC,0xFC,0x04,0x0C,0xF8,0xF0,0x00,0x08,0x0F,0x0F,0x08,0x0C,0x07,0x03,0x00},
+    // 'E' (69)
+    {0x04,0xFC,0xFC,0x44,0xE4,0x0C,0x1C,0x00,0x08,0x0F,0x0F,0x08,0x08,0x0C,0x0E,0x00},
+    // 'F' (70)
+    {0x04,0xFC,0xFC,0x44,0xE4,0x0C,0x1C,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00,0x00,0x00},
+    // 'G' (71)
+    {0xF0,0xF8,0x0C,0x84,0x84,0x8C,0x98,0x00,0x03,0x07,0x0C,0x08,0x08,0x07,0x0F,0x00},
+    // 'H' (72)
+    {0xFC,0xFC,0x40,0x40,0x40,0xFC,0xFC,0x00,0x0F,0x0F,0x00,0x00,0x00,0x0F,0x0F,0x00},
+    // 'I' (73)
+    {0x00,0x00,0x04,0xFC,0xFC,0x04,0x00,0x00,0x00,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00},
+    // 'J' (74)
+    {0x00,0x00,0x00,0x04,0xFC,0xFC,0x04,0x00,0x07,0x0F,0x08,0x08,0x0F,0x07,0x00,0x00},
+    // 'K' (75)
+    {0x04,0xFC,0xFC,0xC0,0xE0,0x3C,0x1C,0x00,0x08,0x0F,0x0F,0x00,0x01,0x0F,0x0E,0x00},
+    // 'L' (76)
+    {0x04,0xFC,0xFC,0x04,0x00,0x00,0x00,0x00,0x08,0x0F,0x0F,0x08,0x08,0x0C,0x0E,0x00},
+    // 'M' (77)
+    {0xFC,0xFC,0x38,0x70,0x38,0xFC,0xFC,0x00,0x0F,0x0F,0x00,0x00,0x00,0x0F,0x0F,0x00},
+    // 'N' (78)
+    {0xFC,0xFC,0x38,0x70,0xE0,0xFC,0xFC,0x00,0x0F,0x0F,0x00,0x00,0x00,0x0F,0x0F,0x00},
+    // 'O' (79)
+    {0xF8,0xFC,0x04,0x04,0x04,0xFC,0xF8,0x00,0x07,0x0F,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // 'P' (80)
+    {0x04,0xFC,0xFC,0x44,0x44,0x7C,0x38,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00,0x00,0x00},
+    // 'Q' (81)
+    {0xF8,0xFC,0x04,0x04,0x04,0xFC,0xF8,0x00,0x07,0x0F,0x08,0x0E,0x3C,0x3F,0x27,0x00},
+    // 'R' (82)
+    {0x04,0xFC,0xFC,0x44,0xC4,0xFC,0x38,0x00,0x08,0x0F,0x0F,0x00,0x00,0x0F,0x0F,0x00},
+    // 'S' (83)
+    {0x18,0x3C,0x64,0x44,0xC4,0x9C,0x18,0x00,0x06,0x0E,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // 'T' (84)
+    {0x00,0x1C,0x0C,0xFC,0xFC,0x0C,0x1C,0x00,0x00,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00},
+    // 'U' (85)
+    {0xFC,0xFC,0x00,0x00,0x00,0xFC,0xFC,0x00,0x07,0x0F,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // 'V' (86)
+    {0xFC,0xFC,0x00,0x00,0x00,0xFC,0xFC,0x00,0x01,0x03,0x06,0x0C,0x06,0x03,0x01,0x00},
+    // 'W' (87)
+    {0xFC,0xFC,0x00,0xC0,0x00,0xFC,0xFC,0x00,0x07,0x0F,0x0E,0x03,0x0E,0x0F,0x07,0x00},
+    // 'X' (88)
+    {0x0C,0x3C,0xF0,0xE0,0xF0,0x3C,0x0C,0x00,0x0C,0x0F,0x03,0x01,0x03,0x0F,0x0C,0x00},
+    // 'Y' (89)
+    {0x00,0x3C,0x7C,0xC0,0xC0,0x7C,0x3C,0x00,0x00,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00},
+    // 'Z' (90)
+    {0x1C,0x0C,0x84,0xC4,0x64,0x3C,0x1C,0x00,0x0E,0x0F,0x09,0x08,0x08,0x0C,0x0E,0x00},
+    // '[' (91)
+    {0x00,0x00,0xFC,0xFC,0x04,0x04,0x00,0x00,0x00,0x00,0x0F,0x0F,0x08,0x08,0x00,0x00},
+    // '\' (92)
+    {0x18,0x30,0x60,0xC0,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x03,0x06,0x00},
+    // ']' (93)
+    {0x00,0x00,0x04,0x04,0xFC,0xFC,0x00,0x00,0x00,0x00,0x08,0x08,0x0F,0x0F,0x00,0x00},
+    // '^' (94)
+    {0x20,0x30,0x18,0x0C,0x18,0x30,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+    // '_' (95)
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20},
+    // '`' (96)
+    {0x00,0x00,0x10,0x18,0x0C,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+    // 'a' (97)
+    {0x00,0xA0,0xA0,0xA0,0xE0,0xC0,0x00,0x00,0x07,0x0F,0x08,0x08,0x07,0x0F,0x08,0x00},
+    // 'b' (98)
+    {0x04,0xFC,0xFC,0x20,0x60,0xC0,0x80,0x00,0x00,0x0F,0x0F,0x08,0x08,0x0F,0x07,0x00},
+    // 'c' (99)
+    {0xC0,0xE0,0x20,0x20,0x20,0x60,0x40,0x00,0x07,0x0F,0x08,0x08,0x08,0x0C,0x04,0x00},
+    // 'd' (100)
+    {0x80,0xC0,0x60,0x24,0xFC,0xFC,0x00,0x00,0x07,0x0F,0x08,0x08,0x07,0x0F,0x08,0x00},
+    // 'e' (101)
+    {0xC0,0xE0,0xA0,0xA0,0xA0,0xE0,0xC0,0x00,0x07,0x0F,0x08,0x08,0x08,0x0C,0x04,0x00},
+    // 'f' (102)
+    {0x40,0xF8,0xFC,0x44,0x0C,0x18,0x00,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00,0x00,0x00},
+    // 'g' (103)
+    {0xC0,0xE0,0x20,0x20,0xC0,0xE0,0x20,0x00,0x13,0x37,0x24,0x24,0x3F,0x1F,0x00,0x00},
+    // 'h' (104)
+    {0x04,0xFC,0xFC,0x40,0x20,0xE0,0xC0,0x00,0x08,0x0F,0x0F,0x00,0x00,0x0F,0x0F,0x00},
+    // 'i' (105)
+    {0x00,0x00,0x20,0xEC,0xEC,0x00,0x00,0x00,0x00,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00},
+    // 'j' (106)
+    {0x00,0x00,0x00,0x00,0x20,0xEC,0xEC,0x00,0x00,0x30,0x70,0x40,0x40,0x7F,0x3F,0x00},
+    // 'k' (107)
+    {0x04,0xFC,0xFC,0x80,0xC0,0x60,0x20,0x00,0x08,0x0F,0x0F,0x01,0x03,0x0E,0x0C,0x00},
+    // 'l' (108)
+    {0x00,0x00,0x04,0xFC,0xFC,0x00,0x00,0x00,0x00,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00},
+    // 'm' (109)
+    {0xE0,0xE0,0x60,0xC0,0x60,0xE0,0xC0,0x00,0x0F,0x0F,0x00,0x07,0x00,0x0F,0x0F,0x00},
+    // 'n' (110)
+    {0x20,0xE0,0xC0,0x20,0x20,0xE0,0xC0,0x00,0x00,0x0F,0x0F,0x00,0x00,0x0F,0x0F,0x00},
+    // 'o' (111)
+    {0xC0,0xE0,0x20,0x20,0x20,0xE0,0xC0,0x00,0x07,0x0F,0x08,0x08,0x08,0x0F,0x07,0x00},
+    // 'p' (112)
+    {0x20,0xE0,0xC0,0x20,0x20,0xE0,0xC0,0x00,0x20,0x3F,0x3F,0x24,0x04,0x07,0x03,0x00},
+    // 'q' (113)
+    {0xC0,0xE0,0x20,0x20,0xC0,0xE0,0x20,0x00,0x03,0x07,0x04,0x24,0x3F,0x3F,0x20,0x00},
+    // 'r' (114)
+    {0x20,0xE0,0xC0,0x60,0x20,0xE0,0xC0,0x00,0x08,0x0F,0x0F,0x08,0x00,0x00,0x00,0x00},
+    // 's' (115)
+    {0x40,0xE0,0xA0,0x20,0x20,0x60,0x40,0x00,0x04,0x0C,0x09,0x09,0x0B,0x0E,0x04,0x00},
+    // 't' (116)
+    {0x20,0x20,0xF8,0xFC,0x20,0x20,0x00,0x00,0x00,0x00,0x07,0x0F,0x08,0x0C,0x04,0x00},
+    // 'u' (117)
+    {0xE0,0xE0,0x00,0x00,0xE0,0xE0,0x00,0x00,0x07,0x0F,0x08,0x08,0x07,0x0F,0x08,0x00},
+    // 'v' (118)
+    {0xE0,0xE0,0x00,0x00,0x00,0xE0,0xE0,0x00,0x03,0x07,0x0C,0x08,0x0C,0x07,0x03,0x00},
+    // 'w' (119)
+    {0xE0,0xE0,0x00,0x80,0x00,0xE0,0xE0,0x00,0x07,0x0F,0x0C,0x07,0x0C,0x0F,0x07,0x00},
+    // 'x' (120)
+    {0x20,0x60,0xC0,0x80,0xC0,0x60,0x20,0x00,0x08,0x0C,0x07,0x03,0x07,0x0C,0x08,0x00},
+    // 'y' (121)
+    {0xE0,0xE0,0x00,0x00,0x00,0xE0,0xE0,0x00,0x23,0x27,0x24,0x24,0x34,0x1F,0x0F,0x00},
+    // 'z' (122)
+    {0x60,0x60,0x20,0xA0,0xE0,0x60,0x20,0x00,0x0C,0x0E,0x0B,0x09,0x08,0x0C,0x0C,0x00},
+    // '{' (123)
+    {0x00,0x40,0x40,0xF8,0xBC,0x04,0x04,0x00,0x00,0x00,0x00,0x07,0x0F,0x08,0x08,0x00},
+    // '|' (124)
+    {0x00,0x00,0x00,0xBC,0xBC,0x00,0x00,0x00,0x00,0x00,0x00,0x0F,0x0F,0x00,0x00,0x00},
+    // '}' (125)
+    {0x00,0x04,0x04,0xBC,0xF8,0x40,0x40,0x00,0x00,0x08,0x08,0x0F,0x07,0x00,0x00,0x00},
+    // '~' (126)
+    {0x08,0x0C,0x04,0x0C,0x08,0x0C,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}
+};
+
+
+// Classic 5x7 ASCII font (32-126), one byte per column, bit n = row n
+static const uint8_t font5x7[][5] = {
+    {0x00,0x00,0x00,0x00,0x00}, // ' ' (32)
+    {0x00,0x00,0x5F,0x00,0x00}, // '!' (33)
+    {0x00,0x07,0x00,0x07,0x00}, // '"' (34)
+    {0x14,0x7F,0x14,0x7F,0x14}, // '#' (35)
+    {0x24,0x2A,0x7F,0x2A,0x12}, // '$' (36)
+    {0x23,0x13,0x08,0x64,0x62}, // '%' (37)
+    {0x36,0x49,0x55,0x22,0x50}, // '&' (38)
+    {0x00,0x05,0x03,0x00,0x00}, // ''' (39)
+    {0x00,0x1C,0x22,0x41,0x00}, // '(' (40)
+    {0x00,0x41,0x22,0x1C,0x00}, // ')' (41)
+    {0x14,0x08,0x3E,0x08,0x14}, // '*' (42)
+    {0x08,0x08,0x3E,0x08,0x08}, // '+' (43)
+    {0x00,0x50,0x30,0x00,0x00}, // ',' (44)
+    {0x08,0x08,0x08,0x08,0x08}, // '-' (45)
+    {0x00,0x60,0x60,0x00,0x00}, // '.' (46)
+    {0x20,0x10,0x08,0x04,0x02}, // '/' (47)
+    {0x3E,0x51,0x49,0x45,0x3E}, // '0' (48)
+    {0x00,0x42,0x7F,0x40,0x00}, // '1' (49)
+    {0x42,0x61,0x51,0x49,0x46}, // '2' (50)
+    {0x21,0x41,0x45,0x4B,0x31}, // '3' (51)
+    {0x18,0x14,0x12,0x7F,0x10}, // '4' (52)
+    {0x27,0x45,0x45,0x45,0x39}, // '5' (53)
+    {0x3C,0x4A,0x49,0x49,0x30}, // '6' (54)
+    {0x01,0x71,0x09,0x05,0x03}, // '7' (55)
+    {0x36,0x49,0x49,0x49,0x36}, // '8' (56)
+    {0x06,0x49,0x49,0x29,0x1E}, // '9' (57)
+    {0x00,0x36,0x36,0x00,0x00}, // ':' (58)
+    {0x00,0x56,0x36,0x00,0x00}, // ';' (59)
+    {0x08,0x14,0x22,0x41,0x00}, // '<' (60)
+    {0x14,0x14,0x14,0x14,0x14}, // '=' (61)
+    {0x00,0x41,0x22,0x14,0x08}, // '>' (62)
+    {0x02,0x01,0x51,0x09,0x06}, // '?' (63)
+    {0x32,0x49,0x79,0x41,0x3E}, // '@' (64)
+    {0x7E,0x11,0x11,0x11,0x7E}, // 'A' (65)
+    {0x7F,0x49,0x49,0x49,0x36}, // 'B' (66)
+    {0x3E,0x41,0x41,0x41,0x22}, // 'C' (67)
+    {0x7F,0x41,0x41,0x22,0x1C}, // 'D' (68)
+    {0x7F,0x49,0x49,0x49,0x41}, // 'E' (69)
+    {0x7F,0x09,0x09,0x01,0x01}, // 'F' (70)
+    {0x3E,0x41,0x41,0x51,0x32}, // 'G' (71)
+    {0x7F,0x08,0x08,0x08,0x7F}, // 'H' (72)
+    {0x00,0x41,0x7F,0x41,0x00}, // 'I' (73)
+    {0x20,0x40,0x41,0x3F,0x01}, // 'J' (74)
+    {0x7F,0x08,0x14,0x22,0x41}, // 'K' (75)
+    {0x7F,0x40,0x40,0x40,0x40}, // 'L' (76)
+    {0x7F,0x02,0x04,0x02,0x7F}, // 'M' (77)
+    {0x7F,0x04,0x08,0x10,0x7F}, // 'N' (78)
+    {0x3E,0x41,0x41,0x41,0x3E}, // 'O' (79)
+    {0x7F,0x09,0x09,0x09,0x06}, // 'P' (80)
+    {0x3E,0x41,0x51,0x21,0x5E}, // 'Q' (81)
+    {0x7F,0x09,0x19,0x29,0x46}, // 'R' (82)
+    {0x46,0x49,0x49,0x49,0x31}, // 'S' (83)
+    {0x01,0x01,0x7F,0x01,0x01}, // 'T' (84)
+    {0x3F,0x40,0x40,0x40,0x3F}, // 'U' (85)
+    {0x1F,0x20,0x40,0x20,0x1F}, // 'V' (86)
+    {0x7F,0x20,0x18,0x20,0x7F}, // 'W' (87)
+    {0x63,0x14,0x08,0x14,0x63}, // 'X' (88)
+    {0x03,0x04,0x78,0x04,0x03}, // 'Y' (89)
+    {0x61,0x51,0x49,0x45,0x43}, // 'Z' (90)
+    {0x00,0x7F,0x41,0x41,0x00}, // '[' (91)
+    {0x02,0x04,0x08,0x10,0x20}, // '\' (92)
+    {0x00,0x41,0x41,0x7F,0x00}, // ']' (93)
+    {0x04,0x02,0x01,0x02,0x04}, // '^' (94)
+    {0x40,0x40,0x40,0x40,0x40}, // '_' (95)
+    {0x00,0x01,0x02,0x04,0x00}, // '`' (96)
+    {0x20,0x54,0x54,0x54,0x78}, // 'a' (97)
+    {0x7F,0x48,0x44,0x44,0x38}, // 'b' (98)
+    {0x38,0x44,0x44,0x44,0x20}, // 'c' (99)
+    {0x38,0x44,0x44,0x48,0x7F}, // 'd' (100)
+    {0x38,0x54,0x54,0x54,0x18}, // 'e' (101)
+    {0x08,0x7E,0x09,0x01,0x02}, // 'f' (102)
+    {0x0C,0x52,0x52,0x52,0x3E}, // 'g' (103)
+    {0x7F,0x08,0x04,0x04,0x78}, // 'h' (104)
+    {0x00,0x44,0x7D,0x40,0x00}, // 'i' (105)
+    {0x20,0x40,0x44,0x3D,0x00}, // 'j' (106)
+    {0x7F,0x10,0x28,0x44,0x00}, // 'k' (107)
+    {0x00,0x41,0x7F,0x40,0x00}, // 'l' (108)
+    {0x7C,0x04,0x18,0x04,0x78}, // 'm' (109)
+    {0x7C,0x08,0x04,0x04,0x78}, // 'n' (110)
+    {0x38,0x44,0x44,0x44,0x38}, // 'o' (111)
+    {0x7C,0x14,0x14,0x14,0x08}, // 'p' (112)
+    {0x08,0x14,0x14,0x18,0x7C}, // 'q' (113)
+    {0x7C,0x08,0x04,0x04,0x08}, // 'r' (114)
+    {0x48,0x54,0x54,0x54,0x20}, // 's' (115)
+    {0x04,0x3F,0x44,0x40,0x20}, // 't' (116)
+    {0x3C,0x40,0x40,0x20,0x7C}, // 'u' (117)
+    {0x1C,0x20,0x40,0x20,0x1C}, // 'v' (118)
+    {0x3C,0x40,0x30,0x40,0x3C}, // 'w' (119)
+    {0x44,0x28,0x10,0x28,0x44}, // 'x' (120)
+    {0x0C,0x50,0x50,0x50,0x3C}, // 'y' (121)
+    {0x44,0x64,0x54,0x4C,0x44}, // 'z' (122)
+    {0x00,0x08,0x36,0x41,0x00}, // '{' (123)
+    {0x00,0x00,0x7F,0x00,0x00}, // '|' (124)
+    {0x00,0x41,0x36,0x08,0x00}, // '}' (125)
+    {0x08,0x04,0x08,0x10,0x08}  // '~' (126)
+};
+
+// Proportional variant of the 5x7 font with blank side columns trimmed
+static const uint8_t font_prop8_widths[] = {
+    2, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+    5, 3, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+    3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5
+};
+
+static const uint16_t font_prop8_offsets[] = {
+    0, 2, 3, 6, 11, 16, 21, 26, 28, 31, 34, 39,
+    44, 46, 51, 53, 58, 63, 66, 71, 76, 81, 86, 91,
+    96, 101, 106, 108, 110, 114, 119, 123, 128, 133, 138, 143,
+    148, 153, 158, 163, 168, 173, 176, 181, 186, 191, 196, 201,
+    206, 211, 216, 221, 226, 231, 236, 241, 246, 251, 256, 261,
+    264, 269, 272, 277, 282, 285, 290, 295, 300, 305, 310, 315,
+    320, 325, 328, 332, 336, 339, 344, 349, 354, 359, 364, 369,
+    374, 379, 384, 389, 394, 399, 404, 409, 412, 413, 416
+};
+
+static const uint8_t font_prop8_bitmap[] = {
+    0x00,0x00, // ' ' (32)
+    0x5F, // '!' (33)
+    0x07,0x00,0x07, // '"' (34)
+    0x14,0x7F,0x14,0x7F,0x14, // '#' (35)
+    0x24,0x2A,0x7F,0x2A,0x12, // '$' (36)
+    0x23,0x13,0x08,0x64,0x62, // '%' (37)
+    0x36,0x49,0x55,0x22,0x50, // '&' (38)
+    0x05,0x03, // ''' (39)
+    0x1C,0x22,0x41, // '(' (40)
+    0x41,0x22,0x1C, // ')' (41)
+    0x14,0x08,0x3E,0x08,0x14, // '*' (42)
+    0x08,0x08,0x3E,0x08,0x08, // '+' (43)
+    0x50,0x30, // ',' (44)
+    0x08,0x08,0x08,0x08,0x08, // '-' (45)
+    0x60,0x60, // '.' (46)
+    0x20,0x10,0x08,0x04,0x02, // '/' (47)
+    0x3E,0x51,0x49,0x45,0x3E, // '0' (48)
+    0x42,0x7F,0x40, // '1' (49)
+    0x42,0x61,0x51,0x49,0x46, // '2' (50)
+    0x21,0x41,0x45,0x4B,0x31, // '3' (51)
+    0x18,0x14,0x12,0x7F,0x10, // '4' (52)
+    0x27,0x45,0x45,0x45,0x39, // '5' (53)
+    0x3C,0x4A,0x49,0x49,0x30, // '6' (54)
+    0x01,0x71,0x09,0x05,0x03, // '7' (55)
+    0x36,0x49,0x49,0x49,0x36, // '8' (56)
+    0x06,0x49,0x49,0x29,0x1E, // '9' (57)
+    0x36,0x36, // ':' (58)
+    0x56,0x36, // ';' (59)
+    0x08,0x14,0x22,0x41, // '<' (60)
+    0x14,0x14,0x14,0x14,0x14, // '=' (61)
+    0x41,0x22,0x14,0x08, // '>' (62)
+    0x02,0x01,0x51,0x09,0x06, // '?' (63)
+    0x32,0x49,0x79,0x41,0x3E, // '@' (64)
+    0x7E,0x11,0x11,0x11,0x7E, // 'A' (65)
+    0x7F,0x49,0x49,0x49,0x36, // 'B' (66)
+    0x3E,0x41,0x41,0x41,0x22, // 'C' (67)
+    0x7F,0x41,0x41,0x22,0x1C, // 'D' (68)
+    0x7F,0x49,0x49,0x49,0x41, // 'E' (69)
+    0x7F,0x09,0x09,0x01,0x01, // 'F' (70)
+    0x3E,0x41,0x41,0x51,0x32, // 'G' (71)
+    0x7F,0x08,0x08,0x08,0x7F, // 'H' (72)
+    0x41,0x7F,0x41, // 'I' (73)
+    0x20,0x40,0x41,0x3F,0x01, // 'J' (74)
+    0x7F,0x08,0x14,0x22,0x41, // 'K' (75)
+    0x7F,0x40,0x40,0x40,0x40, // 'L' (76)
+    0x7F,0x02,0x04,0x02,0x7F, // 'M' (77)
+    0x7F,0x04,0x08,0x10,0x7F, // 'N' (78)
+    0x3E,0x41,0x41,0x41,0x3E, // 'O' (79)
+    0x7F,0x09,0x09,0x09,0x06, // 'P' (80)
+    0x3E,0x41,0x51,0x21,0x5E, // 'Q' (81)
+    0x7F,0x09,0x19,0x29,0x46, // 'R' (82)
+    0x46,0x49,0x49,0x49,0x31, // 'S' (83)
+    0x01,0x01,0x7F,0x01,0x01, // 'T' (84)
+    0x3F,0x40,0x40,0x40,0x3F, // 'U' (85)
+    0x1F,0x20,0x40,0x20,0x1F, // 'V' (86)
+    0x7F,0x20,0x18,0x20,0x7F, // 'W' (87)
+    0x63,0x14,0x08,0x14,0x63, // 'X' (88)
+    0x03,0x04,0x78,0x04,0x03, // 'Y' (89)
+    0x61,0x51,0x49,0x45,0x43, // 'Z' (90)
+    0x7F,0x41,0x41, // '[' (91)
+    0x02,0x04,0x08,0x10,0x20, // '\' (92)
+    0x41,0x41,0x7F, // ']' (93)
+    0x04,0x02,0x01,0x02,0x04, // '^' (94)
+    0x40,0x40,0x40,0x40,0x40, // '_' (95)
+    0x01,0x02,0x04, // '`' (96)
+    0x20,0x54,0x54,0x54,0x78, // 'a' (97)
+    0x7F,0x48,0x44,0x44,0x38, // 'b' (98)
+    0x38,0x44,0x44,0x44,0x20, // 'c' (99)
+    0x38,0x44,0x44,0x48,0x7F, // 'd' (100)
+    0x38,0x54,0x54,0x54,0x18, // 'e' (101)
+    0x08,0x7E,0x09,0x01,0x02, // 'f' (102)
+    0x0C,0x52,0x52,0x52,0x3E, // 'g' (103)
+    0x7F,0x08,0x04,0x04,0x78, // 'h' (104)
+    0x44,0x7D,0x40, // 'i' (105)
+    0x20,0x40,0x44,0x3D, // 'j' (106)
+    0x7F,0x10,0x28,0x44, // 'k' (107)
+    0x41,0x7F,0x40, // 'l' (108)
+    0x7C,0x04,0x18,0x04,0x78, // 'm' (109)
+    0x7C,0x08,0x04,0x04,0x78, // 'n' (110)
+    0x38,0x44,0x44,0x44,0x38, // 'o' (111)
+    0x7C,0x14,0x14,0x14,0x08, // 'p' (112)
+    0x08,0x14,0x14,0x18,0x7C, // 'q' (113)
+    0x7C,0x08,0x04,0x04,0x08, // 'r' (114)
+    0x48,0x54,0x54,0x54,0x20, // 's' (115)
+    0x04,0x3F,0x44,0x40,0x20, // 't' (116)
+    0x3C,0x40,0x40,0x20,0x7C, // 'u' (117)
+    0x1C,0x20,0x40,0x20,0x1C, // 'v' (118)
+    0x3C,0x40,0x30,0x40,0x3C, // 'w' (119)
+    0x44,0x28,0x10,0x28,0x44, // 'x' (120)
+    0x0C,0x50,0x50,0x50,0x3C, // 'y' (121)
+    0x44,0x64,0x54,0x4C,0x44, // 'z' (122)
+    0x08,0x36,0x41, // '{' (123)
+    0x7F, // '|' (124)
+    0x41,0x36,0x08, // '}' (125)
+    0x08,0x04,0x08,0x10,0x08, // '~' (126)
+};
+
+const ssd1306_font_t ssd1306_font_6x8 = {
+    .first_char = 32,
+    .last_char = 126,
+    .height = 8,
+    .width = 5,
+    .spacing = 1,
+    .widths = NULL,
+    .offsets = NULL,
+    .bitmap = &font5x7[0][0],
+};
+
+const ssd1306_font_t ssd1306_font_8x16 = {
+    .first_char = 32,
+    .last_char = 126,
+    .height = 16,
+    .width = 8,
+    .spacing = 0,
+    .widths = NULL,
+    .offsets = NULL,
+    .bitmap = &font8x16[0][0],
+};
+
+const ssd1306_font_t ssd1306_font_prop8 = {
+    .first_char = 32,
+    .last_char = 126,
+    .height = 8,
+    .width = 0,
+    .spacing = 1,
+    .widths = font_prop8_widths,
+    .offsets = font_prop8_offsets,
+    .bitmap = font_prop8_bitmap,
+};
@@ -0,0 +1,472 @@
+#include <stdlib.h>
+#include "ssd1306.h"
+#include "ssd1306_gfx.h"
+#include "ssd1306_priv.h"
+
+// Cohen-Sutherland outcodes
+#define GFX_OUT_LEFT                        0x01
+#define GFX_OUT_RIGHT                       0x02
+#define GFX_OUT_TOP                         0x04
+#define GFX_OUT_BOTTOM                      0x08
+
+// Changed columns per page while a shape is plotted pixel by pixel
+typedef struct {
+    ssd1306_handle_t dev;
+    uint8_t mode;
+    ssd1306_dirty_t changed;
+} gfx_plot_t;
+
+static void gfx_plot_begin(gfx_plot_t *plot, ssd1306_handle_t dev, uint8_t chMode)
+{
+    plot->dev = dev;
+    plot->mode = chMode;
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        ssd1306_mark_clean(&plot->changed, page);
+    }
+}
+
+static void gfx_plot_end(gfx_plot_t *plot)
+{
+    for (uint8_t page = 0; page < SSD1306_PAGES; page++) {
+        if (ssd1306_page_is_dirty(&plot->changed, page)) {
+            ssd1306_mark_dirty(&plot->dev->dirty, page, plot->changed.x0[page], plot->changed.x1[page]);
+        }
+    }
+}
+
+// Plot an on-screen pixel; callers guarantee the coordinates are in range
+static inline void gfx_plot(gfx_plot_t *plot, uint8_t x, uint8_t y)
+{
+    uint8_t page = y / 8;
+    uint8_t *cell = &plot->dev->gram[page * SSD1306_WIDTH + x];
+    uint8_t bit = 1 << (y % 8);
+    uint8_t value = plot->mode ? (*cell | bit) : (*cell & ~bit);
+    
+    if (value != *cell) {
+        *cell = value;
+        ssd1306_mark_dirty(&plot->changed, page, x, x);
+    }
+}
+
+static inline void gfx_plot_clipped(gfx_plot_t *plot, int16_t x, int16_t y)
+{
+    if (x >= 0 && x < SSD1306_WIDTH && y >= 0 && y < SSD1306_HEIGHT) {
+        gfx_plot(plot, x, y);
+    }
+}
+
+void ssd1306_gfx_points(ssd1306_handle_t dev, const int16_t *xs, const int16_t *ys, uint16_t count,
+                        uint8_t frac_bits, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL || xs == NULL || ys == NULL) return;
+    
+    gfx_plot_t plot;
+    gfx_plot_begin(&plot, dev, chMode);
+    for (uint16_t i = 0; i < count; i++) {
+        gfx_plot_clipped(&plot, xs[i] >> frac_bits, ys[i] >> frac_bits);
+    }
+    gfx_plot_end(&plot);
+}
+
+// Horizontal span x0..x1 (inclusive) on row y, written a byte column at a time.
+// x1 < x0 is an empty span, not a reversed one.
+static void gfx_hspan(ssd1306_handle_t dev, int16_t x0, int16_t x1, int16_t y, uint8_t chMode)
+{
+    if (y < 0 || y >= SSD1306_HEIGHT || x1 < x0) return;
+    if (x1 < 0 || x0 >= SSD1306_WIDTH) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 >= SSD1306_WIDTH) x1 = SSD1306_WIDTH - 1;
+    
+    ssd1306_fill_rect(dev, x0, y, x1 - x0 + 1, 1, chMode);
+}
+
+// Vertical span y0..y1 (inclusive) on column x, written a page at a time.
+// y1 < y0 is an empty span, not a reversed one.
+static void gfx_vspan(ssd1306_handle_t dev, int16_t x, int16_t y0, int16_t y1, uint8_t chMode)
+{
+    if (x < 0 || x >= SSD1306_WIDTH || y1 < y0) return;
+    if (y1 < 0 || y0 >= SSD1306_HEIGHT) return;
+    if (y0 < 0) y0 = 0;
+    if (y1 >= SSD1306_HEIGHT) y1 = SSD1306_HEIGHT - 1;
+    
+    ssd1306_fill_rect(dev, x, y0, 1, y1 - y0 + 1, chMode);
+}
+
+static uint8_t gfx_outcode(int16_t x, int16_t y)
+{
+    uint8_t code = 0;
+    
+    if (x < 0) code |= GFX_OUT_LEFT;
+    else if (x >= SSD1306_WIDTH) code |= GFX_OUT_RIGHT;
+    if (y < 0) code |= GFX_OUT_TOP;
+    else if (y >= SSD1306_HEIGHT) code |= GFX_OUT_BOTTOM;
+    return code;
+}
+
+// Ceiling division for a positive divisor
+static inline int64_t gfx_div_ceil(int64_t num, int64_t den)
+{
+    return (num >= 0) ? (num + den - 1) / den : -((-num) / den);
+}
+
+// x0 + (x1 - x0) * t / n, rounded to nearest; n > 0
+static inline int32_t gfx_interp(int32_t x0, int32_t x1, int32_t t, int32_t n)
+{
+    int64_t num = 2 * (int64_t)(x1 - x0) * t;
+    return x0 + ((num >= 0) ? (num + n) / (2 * n) : -((n - num) / (2 * n)));
+}
+
+void ssd1306_gfx_line(ssd1306_handle_t dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL) return;
+    
+    // Both endpoints on the same outer side: nothing to draw
+    uint8_t code0 = gfx_outcode(x0, y0);
+    uint8_t code1 = gfx_outcode(x1, y1);
+    if (code0 & code1) return;
+    
+    if (y0 == y1) {
+        gfx_hspan(dev, (x0 < x1) ? x0 : x1, (x0 < x1) ? x1 : x0, y0, chMode);
+        return;
+    }
+    if (x0 == x1) {
+        gfx_vspan(dev, x0, (y0 < y1) ? y0 : y1, (y0 < y1) ? y1 : y0, chMode);
+        return;
+    }
+    
+    // Step i along the major axis a moves the minor axis b by
+    // floor((2 * i * d + D) / (2 * D)), i.e. the nearest pixel to the ideal line
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = abs(y1 - y0);
+    bool steep = dy > dx;
+    int32_t a0 = steep ? y0 : x0;
+    int32_t b0 = steep ? x0 : y0;
+    int32_t sa = steep ? ((y1 > y0) ? 1 : -1) : ((x1 > x0) ? 1 : -1);
+    int32_t sb = steep ? ((x1 > x0) ? 1 : -1) : ((y1 > y0) ? 1 : -1);
+    int32_t big_d = steep ? dy : dx;
+    int32_t small_d = steep ? dx : dy;
+    int32_t a_max = (steep ? SSD1306_HEIGHT : SSD1306_WIDTH) - 1;
+    int32_t b_max = (steep ? SSD1306_WIDTH : SSD1306_HEIGHT) - 1;
+    
+    int32_t i_start = 0;
+    int32_t i_end = big_d;
+    
+    if (code0 | code1) {
+        // Clip in step space so the visible part matches the unclipped line exactly
+        int32_t lo = (sa > 0) ? -a0 : a0 - a_max;
+        int32_t hi = (sa > 0) ? a_max - a0 : a0;
+        if (lo > i_start) i_start = lo;
+        if (hi < i_end) i_end = hi;
+        
+        // The minor offset m(i) is non-decreasing; keep b0 + sb * m(i) on screen
+        int32_t m_lo = (sb > 0) ? -b0 : b0 - b_max;
+        int32_t m_hi = (sb > 0) ? b_max - b0 : b0;
+        int64_t i_first = gfx_div_ceil(2 * (int64_t)big_d * m_lo - big_d, 2 * small_d);
+        int64_t i_last = gfx_div_ceil(2 * (int64_t)big_d * (m_hi + 1) - big_d, 2 * small_d) - 1;
+        if (i_first > i_start) i_start = i_first;
+        if (i_last < i_end) i_end = i_last;
+        
+        if (i_start > i_end) return;
+    }
+    
+    int64_t num = 2 * (int64_t)small_d * i_start + big_d;
+    int32_t a = a0 + sa * i_start;
+    int32_t b = b0 + sb * (int32_t)(num / (2 * big_d));
+    int32_t rem = num % (2 * big_d);
+    
+    gfx_plot_t plot;
+    gfx_plot_begin(&plot, dev, chMode);
+    for (int32_t i = i_start; i <= i_end; i++) {
+        if (steep) {
+            gfx_plot(&plot, b, a);
+        } else {
+            gfx_plot(&plot, a, b);
+        }
+        a += sa;
+        rem += 2 * small_d;
+        if (rem >= 2 * big_d) {
+            rem -= 2 * big_d;
+            b += sb;
+        }
+    }
+    gfx_plot_end(&plot);
+}
+
+// Apply a raster op to the masked bits of one byte; returns true if it changed
+static inline bool gfx_rop(uint8_t *cell, uint8_t src, uint8_t mask, ssd1306_rop_t rop)
+{
+    uint8_t value = *cell;
+    
+    switch (rop) {
+        case SSD1306_ROP_COPY:
+            value = (value & ~mask) | (src & mask);
+            break;
+        case SSD1306_ROP_OR:
+            value |= src & mask;
+            break;
+        case SSD1306_ROP_AND_NOT:
+            value &= ~(src & mask);
+            break;
+        case SSD1306_ROP_XOR:
+            value ^= src & mask;
+            break;
+    }
+    
+    if (value == *cell) return false;
+    *cell = value;
+    return true;
+}
+
+void ssd1306_blit(ssd1306_handle_t dev, int16_t x, int16_t y, const ssd1306_bitmap_t *bmp, ssd1306_rop_t rop)
+{
+    if (dev == NULL || dev->gram == NULL || bmp == NULL || bmp->data == NULL) return;
+    if (bmp->width == 0 || bmp->height == 0) return;
+    
+    // Visible column range in bitmap coordinates
+    int16_t col0 = (x < 0) ? -x : 0;
+    int16_t col1 = bmp->width - 1;
+    if (x + col1 >= SSD1306_WIDTH) col1 = SSD1306_WIDTH - 1 - x;
+    if (col0 > col1 || y >= SSD1306_HEIGHT || y + bmp->height <= 0) return;
+    
+    // Source page p lands on destination pages dst_page + p and dst_page + p + 1
+    int16_t dst_page = (y >= 0) ? y / 8 : -((7 - y) / 8);
+    uint8_t shift = y - dst_page * 8;
+    uint8_t src_pages = (bmp->height + 7) / 8;
+    
+    gfx_plot_t plot;
+    gfx_plot_begin(&plot, dev, 1);
+    
+    for (uint8_t sp = 0; sp < src_pages; sp++) {
+        const uint8_t *src = &bmp->data[sp * bmp->width];
+        const uint8_t *msk = bmp->mask ? &bmp->mask[sp * bmp->width] : NULL;
+        
+        // Rows past the bitmap height in its last page are never touched
+        uint8_t rows = bmp->height - sp * 8;
+        uint8_t row_mask = (rows >= 8) ? 0xFF : (0xFF >> (8 - rows));
+        
+        int16_t page_lo = dst_page + sp;
+        int16_t page_hi = page_lo + 1;
+        bool lo_visible = page_lo >= 0 && page_lo < SSD1306_PAGES;
+        bool hi_visible = shift && page_hi >= 0 && page_hi < SSD1306_PAGES;
+        if (!lo_visible && !hi_visible) continue;
+        
+        int16_t base_lo = page_lo * SSD1306_WIDTH + x;
+        int16_t base_hi = page_hi * SSD1306_WIDTH + x;
+        
+        for (int16_t col = col0; col <= col1; col++) {
+            uint8_t m = row_mask & (msk ? msk[col] : 0xFF);
+            if (m == 0) continue;
+            
+            if (shift == 0) {
+                if (gfx_rop(&dev->gram[base_lo + col], src[col], m, rop)) {
+                    ssd1306_mark_dirty(&plot.changed, page_lo, x + col, x + col);
+                }
+                continue;
+            }
+            
+            uint16_t bits = (uint16_t)src[col] << shift;
+            uint16_t mask = (uint16_t)m << shift;
+            if (lo_visible && gfx_rop(&dev->gram[base_lo + col], bits, mask, rop)) {
+                ssd1306_mark_dirty(&plot.changed, page_lo, x + col, x + col);
+            }
+            if (hi_visible && gfx_rop(&dev->gram[base_hi + col], bits >> 8, mask >> 8, rop)) {
+                ssd1306_mark_dirty(&plot.changed, page_hi, x + col, x + col);
+            }
+        }
+    }
+    
+    gfx_plot_end(&plot);
+}
+
+void ssd1306_gfx_fill_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t chMode)
+{
+    if (dev == NULL || w <= 0 || h <= 0) return;
+    
+    int32_t x1 = (int32_t)x + w - 1;
+    int32_t y1 = (int32_t)y + h - 1;
+    if (x1 < 0 || y1 < 0 || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 >= SSD1306_WIDTH) x1 = SSD1306_WIDTH - 1;
+    if (y1 >= SSD1306_HEIGHT) y1 = SSD1306_HEIGHT - 1;
+    
+    ssd1306_fill_rect(dev, x, y, x1 - x + 1, y1 - y + 1, chMode);
+}
+
+void ssd1306_gfx_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t chMode)
+{
+    if (dev == NULL || w <= 0 || h <= 0) return;
+    
+    int16_t x1 = x + w - 1;
+    int16_t y1 = y + h - 1;
+    gfx_hspan(dev, x, x1, y, chMode);
+    gfx_hspan(dev, x, x1, y1, chMode);
+    if (h > 2) {
+        gfx_vspan(dev, x, y + 1, y1 - 1, chMode);
+        gfx_vspan(dev, x1, y + 1, y1 - 1, chMode);
+    }
+}
+
+void ssd1306_gfx_circle(ssd1306_handle_t dev, int16_t cx, int16_t cy, int16_t r, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL || r < 0) return;
+    
+    // Midpoint circle, one octant mirrored eight ways
+    int16_t x = r;
+    int16_t y = 0;
+    int16_t err = 1 - r;
+    
+    gfx_plot_t plot;
+    gfx_plot_begin(&plot, dev, chMode);
+    while (x >= y) {
+        gfx_plot_clipped(&plot, cx + x, cy + y);
+        gfx_plot_clipped(&plot, cx - x, cy + y);
+        gfx_plot_clipped(&plot, cx + x, cy - y);
+        gfx_plot_clipped(&plot, cx - x, cy - y);
+        gfx_plot_clipped(&plot, cx + y, cy + x);
+        gfx_plot_clipped(&plot, cx - y, cy + x);
+        gfx_plot_clipped(&plot, cx + y, cy - x);
+        gfx_plot_clipped(&plot, cx - y, cy - x);
+        
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+    gfx_plot_end(&plot);
+}
+
+// Draw the four corner arcs of radius r around the rectangle (x0, y0)-(x1, y1),
+// either as outline pixels or as horizontal spans joining the left and right arcs
+static void gfx_corners(ssd1306_handle_t dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                        int16_t r, bool fill, uint8_t chMode)
+{
+    int16_t x = r;
+    int16_t y = 0;
+    int16_t err = 1 - r;
+    
+    gfx_plot_t plot;
+    gfx_plot_begin(&plot, dev, chMode);
+    while (x >= y) {
+        if (fill) {
+            gfx_hspan(dev, x0 - x, x1 + x, y0 - y, chMode);
+            gfx_hspan(dev, x0 - x, x1 + x, y1 + y, chMode);
+            gfx_hspan(dev, x0 - y, x1 + y, y0 - x, chMode);
+            gfx_hspan(dev, x0 - y, x1 + y, y1 + x, chMode);
+        } else {
+            gfx_plot_clipped(&plot, x1 + x, y1 + y);
+            gfx_plot_clipped(&plot, x0 - x, y1 + y);
+            gfx_plot_clipped(&plot, x1 + x, y0 - y);
+            gfx_plot_clipped(&plot, x0 - x, y0 - y);
+            gfx_plot_clipped(&plot, x1 + y, y1 + x);
+            gfx_plot_clipped(&plot, x0 - y, y1 + x);
+            gfx_plot_clipped(&plot, x1 + y, y0 - x);
+            gfx_plot_clipped(&plot, x0 - y, y0 - x);
+        }
+        
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+    gfx_plot_end(&plot);
+}
+
+void ssd1306_gfx_fill_circle(ssd1306_handle_t dev, int16_t cx, int16_t cy, int16_t r, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL || r < 0) return;
+    
+    gfx_corners(dev, cx, cy, cx, cy, r, true, chMode);
+}
+
+void ssd1306_gfx_round_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL || w <= 0 || h <= 0) return;
+    
+    if (r > (w - 1) / 2) r = (w - 1) / 2;
+    if (r > (h - 1) / 2) r = (h - 1) / 2;
+    if (r <= 0) {
+        ssd1306_gfx_rect(dev, x, y, w, h, chMode);
+        return;
+    }
+    
+    int16_t x1 = x + w - 1;
+    int16_t y1 = y + h - 1;
+    gfx_hspan(dev, x + r + 1, x1 - r - 1, y, chMode);
+    gfx_hspan(dev, x + r + 1, x1 - r - 1, y1, chMode);
+    gfx_vspan(dev, x, y + r + 1, y1 - r - 1, chMode);
+    gfx_vspan(dev, x1, y + r + 1, y1 - r - 1, chMode);
+    gfx_corners(dev, x + r, y + r, x1 - r, y1 - r, r, false, chMode);
+}
+
+void ssd1306_gfx_fill_round_rect(ssd1306_handle_t dev, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL || w <= 0 || h <= 0) return;
+    
+    if (r > (w - 1) / 2) r = (w - 1) / 2;
+    if (r > (h - 1) / 2) r = (h - 1) / 2;
+    if (r < 0) r = 0;
+    
+    // Straight middle band, then the rounded caps above and below it
+    ssd1306_gfx_fill_rect(dev, x, y + r, w, h - 2 * r, chMode);
+    if (r > 0) {
+        gfx_corners(dev, x + r, y + r, x + w - 1 - r, y + h - 1 - r, r, true, chMode);
+    }
+}
+
+void ssd1306_gfx_triangle(ssd1306_handle_t dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                          int16_t x2, int16_t y2, uint8_t chMode)
+{
+    ssd1306_gfx_line(dev, x0, y0, x1, y1, chMode);
+    ssd1306_gfx_line(dev, x1, y1, x2, y2, chMode);
+    ssd1306_gfx_line(dev, x2, y2, x0, y0, chMode);
+}
+
+void ssd1306_gfx_fill_triangle(ssd1306_handle_t dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                               int16_t x2, int16_t y2, uint8_t chMode)
+{
+    if (dev == NULL || dev->gram == NULL) return;
+    
+    // Sort vertices by y
+    int16_t t;
+    if (y0 > y1) { t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+    if (y1 > y2) { t = y1; y1 = y2; y2 = t; t = x1; x1 = x2; x2 = t; }
+    if (y0 > y1) { t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+    
+    if (y2 < 0 || y0 >= SSD1306_HEIGHT) return;
+    
+    if (y0 == y2) {
+        int16_t lo = x0, hi = x0;
+        if (x1 < lo) lo = x1;
+        if (x1 > hi) hi = x1;
+        if (x2 < lo) lo = x2;
+        if (x2 > hi) hi = x2;
+        gfx_hspan(dev, lo, hi, y0, chMode);
+        return;
+    }
+    
+    // Only visible scanlines are walked
+    int16_t y_start = (y0 < 0) ? 0 : y0;
+    int16_t y_end = (y2 >= SSD1306_HEIGHT) ? SSD1306_HEIGHT - 1 : y2;
+    
+    for (int16_t y = y_start; y <= y_end; y++) {
+        // Long edge 0-2 on one side, edge 0-1 or 1-2 on the other
+        int16_t xa = gfx_interp(x0, x2, y - y0, y2 - y0);
+        int16_t xb;
+        if (y < y1) {
+            xb = gfx_interp(x0, x1, y - y0, y1 - y0);
+        } else if (y2 > y1) {
+            xb = gfx_interp(x1, x2, y - y1, y2 - y1);
+        } else {
+            xb = x1;
+        }
+        
+        gfx_hspan(dev, (xa < xb) ? xa : xb, (xa < xb) ? xb : xa, y, chMode);
+    }
+}
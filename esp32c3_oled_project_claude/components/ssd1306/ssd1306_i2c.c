@@ -0,0 +1,64 @@
+#include <stdlib.h>
+#include "esp_log.h"
+#include "driver/i2c_master.h"
+#include "ssd1306_transport.h"
+
+static const char *TAG = "SSD1306_I2C";
+
+#define SSD1306_I2C_SPEED_HZ                400000
+#define SSD1306_I2C_TIMEOUT_MS              1000
+
+typedef struct {
+    ssd1306_transport_t base;
+    i2c_master_dev_handle_t i2c_dev;
+} ssd1306_i2c_transport_t;
+
+static esp_err_t ssd1306_i2c_transmit(ssd1306_transport_t *transport, const uint8_t *data, size_t len)
+{
+    ssd1306_i2c_transport_t *i2c = (ssd1306_i2c_transport_t *)transport;
+    
+    return i2c_master_transmit(i2c->i2c_dev, data, len, SSD1306_I2C_TIMEOUT_MS);
+}
+
+static void ssd1306_i2c_del(ssd1306_transport_t *transport)
+{
+    ssd1306_i2c_transport_t *i2c = (ssd1306_i2c_transport_t *)transport;
+    
+    if (i2c->i2c_dev) {
+        i2c_master_bus_rm_device(i2c->i2c_dev);
+    }
+    free(i2c);
+}
+
+esp_err_t ssd1306_new_transport_i2c(i2c_master_bus_handle_t bus_handle, uint8_t dev_addr,
+                                    ssd1306_transport_t **ret_transport)
+{
+    if (ret_transport == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    ssd1306_i2c_transport_t *i2c = calloc(1, sizeof(ssd1306_i2c_transport_t));
+    if (i2c == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate I2C transport");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Add I2C device to the bus
+    i2c_device_config_t dev_cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = dev_addr,
+        .scl_speed_hz = SSD1306_I2C_SPEED_HZ,
+    };
+    
+    esp_err_t ret = i2c_master_bus_add_device(bus_handle, &dev_cfg, &i2c->i2c_dev);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add I2C device: %s", esp_err_to_name(ret));
+        free(i2c);
+        return ret;
+    }
+    
+    i2c->base.transmit = ssd1306_i2c_transmit;
+    i2c->base.del = ssd1306_i2c_del;
+    *ret_transport = &i2c->base;
+    return ESP_OK;
+}
@@ -0,0 +1,270 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "ssd1306_mem.h"
+
+static const char *TAG = "SSD1306_MEM";
+
+#define SSD1306_MEM_PAGES                   (SSD1306_HEIGHT / 8)
+#define SSD1306_MEM_MAX_ARGS                6
+
+typedef struct {
+    ssd1306_transport_t base;
+    uint32_t bus_hz;
+    ssd1306_mem_stats_t stats;
+    
+    // Emulated controller state
+    uint8_t gram[SSD1306_BUFFER_SIZE];
+    uint8_t col_start, col_end, col;
+    uint8_t page_start, page_end, page;
+    uint8_t start_line;
+    uint8_t contrast;
+    bool display_on;
+    bool inverted;
+    bool all_on;
+    bool scrolling;
+    
+    // Command currently collecting arguments
+    uint8_t cmd;
+    uint8_t args[SSD1306_MEM_MAX_ARGS];
+    uint8_t arg_count;
+    uint8_t args_needed;
+} ssd1306_mem_transport_t;
+
+// Number of argument bytes following a command opcode
+static uint8_t ssd1306_mem_arg_count(uint8_t cmd)
+{
+    switch (cmd) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void ssd1306_mem_exec(ssd1306_mem_transport_t *mem)
+{
+    uint8_t cmd = mem->cmd;
+    
+    if (cmd >= 0x40 && cmd <= 0x7F) {
+        mem->start_line = cmd & 0x3F;
+        return;
+    }
+    
+    switch (cmd) {
+        case 0x21:
+            mem->col_start = mem->col = mem->args[0] & 0x7F;
+            mem->col_end = mem->args[1] & 0x7F;
+            break;
+        case 0x22:
+            mem->page_start = mem->page = mem->args[0] & 0x07;
+            mem->page_end = mem->args[1] & 0x07;
+            break;
+        case 0x81:
+            mem->contrast = mem->args[0];
+            break;
+        case 0xA4:
+        case 0xA5:
+            mem->all_on = (cmd == 0xA5);
+            break;
+        case 0xA6:
+        case 0xA7:
+            mem->inverted = (cmd == 0xA7);
+            break;
+        case 0xAE:
+        case 0xAF:
+            mem->display_on = (cmd == 0xAF);
+            break;
+        case 0x2E:
+            mem->scrolling = false;
+            break;
+        case 0x2F:
+            mem->scrolling = true;
+            break;
+        default:
+            break;
+    }
+}
+
+static void ssd1306_mem_command(ssd1306_mem_transport_t *mem, uint8_t byte)
+{
+    if (mem->args_needed) {
+        mem->args[mem->arg_count++] = byte;
+        if (mem->arg_count < mem->args_needed) return;
+        mem->args_needed = 0;
+        ssd1306_mem_exec(mem);
+        return;
+    }
+    
+    mem->cmd = byte;
+    mem->arg_count = 0;
+    mem->args_needed = ssd1306_mem_arg_count(byte);
+    if (mem->args_needed == 0) {
+        ssd1306_mem_exec(mem);
+    }
+}
+
+// Horizontal addressing: the pointer wraps within the column range, then the page range
+static void ssd1306_mem_data(ssd1306_mem_transport_t *mem, uint8_t byte)
+{
+    mem->gram[mem->page * SSD1306_WIDTH + mem->col] = byte;
+    mem->stats.data_bytes++;
+    
+    if (mem->col++ >= mem->col_end) {
+        mem->col = mem->col_start;
+        if (mem->page++ >= mem->page_end) {
+            mem->page = mem->page_start;
+        }
+    }
+}
+
+static esp_err_t ssd1306_mem_transmit(ssd1306_transport_t *transport, const uint8_t *data, size_t len)
+{
+    ssd1306_mem_transport_t *mem = (ssd1306_mem_transport_t *)transport;
+    
+    if (data == NULL || len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // Start, address byte and payload at 9 clocks per byte, stop
+    mem->stats.transfers++;
+    mem->stats.bytes += len;
+    mem->stats.bus_time_us += ((uint64_t)(len + 1) * 9 + 2) * 1000000 / mem->bus_hz;
+    
+    if (data[0] == SSD1306_CONTROL_CMD_STREAM) {
+        for (size_t i = 1; i < len; i++) {
+            ssd1306_mem_command(mem, data[i]);
+        }
+    } else if (data[0] == SSD1306_CONTROL_DATA_STREAM) {
+        for (size_t i = 1; i < len; i++) {
+            ssd1306_mem_data(mem, data[i]);
+        }
+    } else {
+        ESP_LOGE(TAG, "Unknown control byte 0x%02X", data[0]);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    return ESP_OK;
+}
+
+static void ssd1306_mem_del(ssd1306_transport_t *transport)
+{
+    free(transport);
+}
+
+esp_err_t ssd1306_new_transport_mem(uint32_t bus_hz, ssd1306_transport_t **ret_transport)
+{
+    if (bus_hz == 0 || ret_transport == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    ssd1306_mem_transport_t *mem = calloc(1, sizeof(ssd1306_mem_transport_t));
+    if (mem == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate memory transport");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Controller reset state
+    mem->bus_hz = bus_hz;
+    mem->col_end = SSD1306_WIDTH - 1;
+    mem->page_end = SSD1306_MEM_PAGES - 1;
+    mem->contrast = 0x7F;
+    
+    mem->base.transmit = ssd1306_mem_transmit;
+    mem->base.del = ssd1306_mem_del;
+    *ret_transport = &mem->base;
+    return ESP_OK;
+}
+
+bool ssd1306_mem_get_pixel(ssd1306_transport_t *transport, uint8_t x, uint8_t y)
+{
+    ssd1306_mem_transport_t *mem = (ssd1306_mem_transport_t *)transport;
+    
+    if (mem == NULL || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT || !mem->display_on) {
+        return false;
+    }
+    if (mem->all_on) {
+        return true;
+    }
+    
+    // Screen row y shows GRAM row y + start line
+    uint8_t row = (y + mem->start_line) % SSD1306_HEIGHT;
+    bool lit = (mem->gram[(row / 8) * SSD1306_WIDTH + x] >> (row % 8)) & 1;
+    return lit != mem->inverted;
+}
+
+void ssd1306_mem_get_frame(ssd1306_transport_t *transport, uint8_t *frame)
+{
+    if (transport == NULL || frame == NULL) return;
+    
+    memset(frame, 0, SSD1306_BUFFER_SIZE);
+    for (uint8_t y = 0; y < SSD1306_HEIGHT; y++) {
+        for (uint8_t x = 0; x < SSD1306_WIDTH; x++) {
+            if (ssd1306_mem_get_pixel(transport, x, y)) {
+                frame[(y / 8) * SSD1306_WIDTH + x] |= 1 << (y % 8);
+            }
+        }
+    }
+}
+
+uint8_t ssd1306_mem_get_contrast(ssd1306_transport_t *transport)
+{
+    ssd1306_mem_transport_t *mem = (ssd1306_mem_transport_t *)transport;
+    return mem ? mem->contrast : 0;
+}
+
+esp_err_t ssd1306_mem_write_pbm(ssd1306_transport_t *transport, const char *path)
+{
+    if (transport == NULL || path == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        return ESP_FAIL;
+    }
+    
+    // PBM bit 1 is black; lit pixels are written white so the image looks like the panel
+    fprintf(f, "P4\n%d %d\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+    for (uint8_t y = 0; y < SSD1306_HEIGHT; y++) {
+        uint8_t row[SSD1306_WIDTH / 8];
+        for (uint8_t x = 0; x < SSD1306_WIDTH; x++) {
+            if (x % 8 == 0) row[x / 8] = 0;
+            if (!ssd1306_mem_get_pixel(transport, x, y)) {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        fwrite(row, 1, sizeof(row), f);
+    }
+    
+    esp_err_t ret = ferror(f) ? ESP_FAIL : ESP_OK;
+    fclose(f);
+    return ret;
+}
+
+void ssd1306_mem_get_stats(ssd1306_transport_t *transport, ssd1306_mem_stats_t *stats)
+{
+    ssd1306_mem_transport_t *mem = (ssd1306_mem_transport_t *)transport;
+    
+    if (mem && stats) {
+        *stats = mem->stats;
+    }
+}
+
+void ssd1306_mem_reset_stats(ssd1306_transport_t *transport)
+{
+    ssd1306_mem_transport_t *mem = (ssd1306_mem_transport_t *)transport;
+    
+    if (mem) {
+        memset(&mem->stats, 0, sizeof(mem->stats));
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef SSD1306_PRIV_H
+#define SSD1306_PRIV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "ssd1306.h"
+#include "ssd1306_transport.h"
+
+// Internal to the ssd1306 component; shared by the driver and the bus scheduler
+
+#define SSD1306_TIMEOUT_MS                  1000
+#define SSD1306_PAGES                       (SSD1306_HEIGHT / 8)
+
+// Dirty column range per page; a page is clean when x0 > x1
+typedef struct {
+    uint8_t x0[SSD1306_PAGES];
+    uint8_t x1[SSD1306_PAGES];
+} ssd1306_dirty_t;
+
+struct ssd1306_dev {
+    ssd1306_transport_t *transport;
+    uint8_t *gram;
+    ssd1306_dirty_t dirty;
+    // Control byte + one full frame, reused for every data transaction
+    uint8_t tx_buf[SSD1306_BUFFER_SIZE + 1];
+    
+    // Asynchronous refresh: gram is the back buffer, front is owned by the flush task
+    uint8_t *front;
+    ssd1306_dirty_t front_dirty;
+    TaskHandle_t flush_task;
+    SemaphoreHandle_t flush_idle;
+    volatile bool flush_exit;
+    
+    // Cost of the last frame sent, and of the one being sent (flush_start_us != 0).
+    // flush_stats is published under stats_lock so readers never wait for a flush.
+    ssd1306_flush_stats_t flush_stats;
+    portMUX_TYPE stats_lock;
+    int64_t flush_start_us;
+    uint32_t flush_bytes;
+    uint16_t flush_columns;
+    
+    // Shared bus scheduler the panel is attached to, if any; its task is flush_task
+    struct ssd1306_bus *bus;
+    uint8_t bus_slot;
+    
+    // Power state, mirrored so refreshes can be skipped while the panel is off
+    uint8_t contrast;
+    bool asleep;
+    
+    // Scrolling: start_line rotates the panel's view of GRAM, the ticker feeds in new rows
+    uint8_t start_line;
+    bool hw_scroll;
+    ssd1306_ticker_fill_t ticker_fill;
+    void *ticker_arg;
+    uint32_t ticker_seq;
+    uint8_t ticker_page[SSD1306_WIDTH];
+};
+
+static inline void ssd1306_mark_dirty(ssd1306_dirty_t *dirty, uint8_t page, uint8_t x0, uint8_t x1)
+{
+    if (x0 < dirty->x0[page]) dirty->x0[page] = x0;
+    if (x1 > dirty->x1[page]) dirty->x1[page] = x1;
+}
+
+static inline void ssd1306_mark_clean(ssd1306_dirty_t *dirty, uint8_t page)
+{
+    dirty->x0[page] = 0xFF;
+    dirty->x1[page] = 0;
+}
+
+static inline bool ssd1306_page_is_dirty(const ssd1306_dirty_t *dirty, uint8_t page)
+{
+    return dirty->x0[page] <= dirty->x1[page];
+}
+
+/**
+ * @brief Allocate the front buffer and idle semaphore used by deferred flushing
+ */
+esp_err_t ssd1306_alloc_front(ssd1306_handle_t dev);
+
+/**
+ * @brief Send the next dirty window of buf, at most max_pages pages tall
+ * @param done Set to true once no dirty page is left
+ */
+esp_err_t ssd1306_flush_window(ssd1306_handle_t dev, const uint8_t *buf, ssd1306_dirty_t *dirty,
+                               uint8_t max_pages, bool *done);
+
+/**
+ * @brief Queue the front buffer of a bus-attached panel for transmission
+ */
+void ssd1306_bus_submit(ssd1306_handle_t dev);
+
+#endif // SSD1306_PRIV_H
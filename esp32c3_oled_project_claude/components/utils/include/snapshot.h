@@ -0,0 +1,44 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Lock-free publication of a small struct from one writer to many readers
+ *
+ * The value is kept twice. The writer updates one copy while readers are
+ * steered to the other by the low bit of a sequence counter, so a reader never
+ * waits for a writer and a writer never waits at all. A reader only retries if
+ * the writer completed an update while it was copying.
+ *
+ * Writes must be serialized by the caller. A value written from a single task
+ * needs nothing more; with several writer tasks each one holds the same mutex,
+ * created and checked at init, around snapshot_write(). Readers never lock.
+ */
+typedef struct {
+    atomic_uint seq;
+    size_t size;
+    uint8_t *copies;            // Two consecutive copies of size bytes
+} snapshot_t;
+
+// Static initializer over an array of two values, e.g. `static foo_t copies[2];`
+#define SNAPSHOT_INIT(copies_array) \
+    { .seq = 0, .size = sizeof((copies_array)[0]), .copies = (uint8_t *)(copies_array) }
+
+/**
+ * @brief Publish a new value
+ * @param snap Snapshot
+ * @param value Value of snap->size bytes
+ */
+void snapshot_write(snapshot_t *snap, const void *value);
+
+/**
+ * @brief Copy out the latest complete value
+ * @param snap Snapshot
+ * @param out Buffer of snap->size bytes
+ */
+void snapshot_read(snapshot_t *snap, void *out);
+
+#endif // SNAPSHOT_H
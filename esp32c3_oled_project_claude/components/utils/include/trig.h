@@ -0,0 +1,43 @@
+#ifndef TRIG_H
+#define TRIG_H
+
+#include <stdint.h>
+
+/**
+ * @brief Fixed-point sine and cosine from a lookup table
+ *
+ * Angles are binary: a full turn is 65536 units, so angle arithmetic wraps for
+ * free in a uint16_t. Results are Q15 fractions (32767 = 1.0). The ESP32-C3 has
+ * no FPU, so these replace the soft-float sin()/cos() in per-pixel loops.
+ */
+#define TRIG_ONE                    32767
+#define TRIG_ANGLE_PER_RAD          10430.378350470453  // 65536 / (2 * pi)
+
+// Phase step for a constant below one turn in radians, e.g. TRIG_PHASE(0.1).
+// Phases are uint32_t with 2^32 per turn, so n * step wraps exactly at whole
+// turns and stays exact for any n; phase >> 16 is the angle.
+#define TRIG_PHASE(rad)             ((uint32_t)((rad) * TRIG_ANGLE_PER_RAD * 65536.0 + 0.5))
+
+/**
+ * @brief Sine of a binary angle
+ * @param angle Angle, 65536 units per turn
+ * @return Q15 sine, -32767..32767, within 4 LSB (1.2e-4) of the exact value
+ */
+int16_t trig_sin(uint16_t angle);
+
+/**
+ * @brief Cosine of a binary angle
+ * @param angle Angle, 65536 units per turn
+ * @return Q15 cosine, -32767..32767
+ */
+int16_t trig_cos(uint16_t angle);
+
+/**
+ * @brief Scale an integer by a Q15 fraction, rounding towards minus infinity
+ */
+static inline int32_t trig_mul(int32_t value, int16_t q15)
+{
+    return (value * q15) >> 15;
+}
+
+#endif // TRIG_H
@@ -0,0 +1,31 @@
+#include <string.h>
+#include "snapshot.h"
+
+void snapshot_write(snapshot_t *snap, const void *value)
+{
+    uint8_t *copies = snap->copies;
+    
+    // Odd: readers use copy 1 while copy 0 is rewritten. Copy 1 from the
+    // previous write must be complete before readers are steered to it.
+    atomic_thread_fence(memory_order_release);
+    atomic_fetch_add_explicit(&snap->seq, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(copies, value, snap->size);
+    
+    // Even: readers use copy 0 while copy 1 catches up
+    atomic_thread_fence(memory_order_release);
+    atomic_fetch_add_explicit(&snap->seq, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(copies + snap->size, value, snap->size);
+}
+
+void snapshot_read(snapshot_t *snap, void *out)
+{
+    unsigned int seq;
+    
+    do {
+        seq = atomic_load_explicit(&snap->seq, memory_order_acquire);
+        memcpy(out, snap->copies + (seq & 1) * snap->size, snap->size);
+        atomic_thread_fence(memory_order_acquire);
+    } while (atomic_load_explicit(&snap->seq, memory_order_relaxed) != seq);
+}
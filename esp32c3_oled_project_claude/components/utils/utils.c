@@ -10,9 +10,29 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "ssd1306.h"
+#include "ssd1306_gfx.h"
 
 static const char *TAG = "UTILS";
 
+// Signal strength icons for 0-4 bars, 12x9 pixels
+static const uint8_t signal_icon_data[5][24] = {
+    {0xC0, 0x40, 0xC0, 0xF0, 0x10, 0xF0, 0xFC, 0x04, 0xFC, 0xFF, 0x01, 0xFF,
+     0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01},
+    {0xC0, 0xC0, 0x00, 0xF0, 0x10, 0xF0, 0xFC, 0x04, 0xFC, 0xFF, 0x01, 0xFF,
+     0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01},
+    {0xC0, 0xC0, 0x00, 0xF0, 0xF0, 0x00, 0xFC, 0x04, 0xFC, 0xFF, 0x01, 0xFF,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01},
+    {0xC0, 0xC0, 0x00, 0xF0, 0xF0, 0x00, 0xFC, 0xFC, 0x00, 0xFF, 0x01, 0xFF,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01},
+    {0xC0, 0xC0, 0x00, 0xF0, 0xF0, 0x00, 0xFC, 0xFC, 0x00, 0xFF, 0xFF, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+};
+
+// Battery outline with terminal, 14x7 pixels
+static const uint8_t battery_icon_data[] = {
+    0x7F, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7F, 0x22, 0x3E,
+};
+
 // Math utilities
 float utils_map_float(float x, float in_min, float in_max, float out_min, float out_max)
 {
@@ -207,14 +227,12 @@ void utils_draw_progress_bar(void* display, int x, int y, int width, int height,
         height -= 2;
     }
     
+    if (width <= 0 || height <= 0) return;
+    
     int fill_width = (int)(width * progress);
     
-    for (int px = x; px < x + width; px++) {
-        for (int py = y; py < y + height; py++) {
-            int fill = (px < x + fill_width) ? 1 : 0;
-            ssd1306_draw_point(disp, px, py, fill);
-        }
-    }
+    ssd1306_fill_rect(disp, x, y, fill_width, height, 1);
+    ssd1306_fill_rect(disp, x + fill_width, y, width - fill_width, height, 0);
 }
 
 void utils_draw_signal_strength(void* display, int x, int y, int8_t rssi)
@@ -229,24 +247,12 @@ void utils_draw_signal_strength(void* display, int x, int y, int8_t rssi)
     else if (rssi > -70) bars = 2;
     else if (rssi > -80) bars = 1;
     
-    // Draw signal bars
-    for (int i = 0; i < 4; i++) {
-        int bar_height = 2 + i * 2;
-        int bar_x = x + i * 3;
-        int bar_y = y + 8 - bar_height;
-        
-        if (i < bars) {
-            // Filled bar
-            for (int px = bar_x; px < bar_x + 2; px++) {
-                for (int py = bar_y; py < y + 8; py++) {
-                    ssd1306_draw_point(disp, px, py, 1);
-                }
-            }
-        } else {
-            // Empty bar outline
-            ssd1306_draw_rectangle(disp, bar_x, bar_y, 2, bar_height, 1);
-        }
-    }
+    ssd1306_bitmap_t icon = {
+        .width = 12,
+        .height = 9,
+        .data = signal_icon_data[bars],
+    };
+    ssd1306_blit(disp, x, y, &icon, SSD1306_ROP_OR);
 }
 
 void utils_draw_battery_icon(void* display, int x, int y, float percentage)
@@ -256,15 +262,14 @@ void utils_draw_battery_icon(void* display, int x, int y, float percentage)
     
     percentage = utils_clamp_float(percentage, 0.0, 100.0);
     
-    // Battery outline (12x6 pixels)
-    ssd1306_draw_rectangle(disp, x, y, 11, 6, 1);
-    ssd1306_draw_rectangle(disp, x + 11, y + 1, 2, 4, 1);
+    static const ssd1306_bitmap_t outline = {
+        .width = sizeof(battery_icon_data),
+        .height = 7,
+        .data = battery_icon_data,
+    };
+    ssd1306_blit(disp, x, y, &outline, SSD1306_ROP_OR);
     
     // Battery fill
     int fill_width = (int)((percentage / 100.0) * 9);
-    for (int px = x + 1; px < x + 1 + fill_width; px++) {
-        for (int py = y + 1; py < y + 5; py++) {
-            ssd1306_draw_point(disp, px, py, 1);
-        }
-    }
+    ssd1306_fill_rect(disp, x + 1, y + 1, fill_width, 4, 1);
 }
@@ -0,0 +1,98 @@
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ssd1306.h"
+#include "ssd1306_gfx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WIDGET_TEXT_MAX         24
+
+/**
+ * @brief Kind of content a widget draws inside its bounding box
+ */
+typedef enum {
+    WIDGET_LABEL = 0,   // Text set with widget_set_text()
+    WIDGET_VALUE,       // Integer set with widget_set_value(), formatted on render
+    WIDGET_BAR,         // Horizontal bar filled from min to max
+    WIDGET_ICON,        // Bitmap picked from icons[] by value
+} widget_type_t;
+
+/**
+ * @brief Format a bound value into text
+ * @param buf Output buffer
+ * @param len Size of buf
+ * @param value Current value
+ */
+typedef void (*widget_format_t)(char *buf, size_t len, int32_t value);
+
+/**
+ * @brief Retained widget
+ *
+ * Layout and type are declared once; value and text are the bound state.
+ * A widget is redrawn only when its bound state changed since the last render,
+ * and only its bounding box is cleared and marked dirty.
+ */
+typedef struct {
+    widget_type_t type;
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;                      // 0 = up to the right edge
+    uint8_t height;                     // 0 = font height
+    const ssd1306_font_t *font;         // LABEL, VALUE; NULL = 8x16
+    const char *fmt;                    // VALUE: printf format for a long, if format is NULL
+    widget_format_t format;             // VALUE: custom formatter
+    int32_t min;                        // BAR: empty value
+    int32_t max;                        // BAR: full value
+    const ssd1306_bitmap_t *icons;      // ICON: bitmaps indexed by value
+    uint8_t icon_count;                 // ICON: entries in icons
+
+    // Bound state
+    int32_t value;
+    char text[WIDGET_TEXT_MAX];
+    bool dirty;
+} widget_t;
+
+/**
+ * @brief Widgets making up one screen
+ */
+typedef struct {
+    widget_t *widgets;
+    uint8_t count;
+} widget_scene_t;
+
+/**
+ * @brief Bind a new value; marks the widget dirty if it changed
+ * @return true if the value changed
+ */
+bool widget_set_value(widget_t *widget, int32_t value);
+
+/**
+ * @brief Bind new text (truncated to WIDGET_TEXT_MAX - 1); marks the widget dirty if it changed
+ * @return true if the text changed
+ */
+bool widget_set_text(widget_t *widget, const char *text);
+
+/**
+ * @brief Mark every widget of a scene dirty, e.g. after switching screens
+ */
+void widget_scene_invalidate(widget_scene_t *scene);
+
+/**
+ * @brief Redraw the dirty widgets of a scene into the display buffer
+ * @param dev SSD1306 device handle
+ * @param scene Scene to render
+ * @return Number of widgets redrawn
+ */
+uint8_t widget_scene_render(ssd1306_handle_t dev, widget_scene_t *scene);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIDGETS_H
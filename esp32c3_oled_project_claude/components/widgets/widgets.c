@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <string.h>
+#include "widgets.h"
+#include "esp_log.h"
+
+static const char *TAG = "WIDGETS";
+
+static const ssd1306_font_t *widget_font(const widget_t *widget)
+{
+    return widget->font ? widget->font : &ssd1306_font_8x16;
+}
+
+static uint8_t widget_width(const widget_t *widget)
+{
+    return widget->width ? widget->width : SSD1306_WIDTH - widget->x;
+}
+
+static uint8_t widget_height(const widget_t *widget)
+{
+    return widget->height ? widget->height : widget_font(widget)->height;
+}
+
+bool widget_set_value(widget_t *widget, int32_t value)
+{
+    if (widget == NULL || widget->value == value) {
+        return false;
+    }
+    
+    widget->value = value;
+    widget->dirty = true;
+    return true;
+}
+
+bool widget_set_text(widget_t *widget, const char *text)
+{
+    if (widget == NULL || text == NULL) {
+        return false;
+    }
+    
+    if (strncmp(widget->text, text, sizeof(widget->text) - 1) == 0) {
+        return false;
+    }
+    
+    strncpy(widget->text, text, sizeof(widget->text) - 1);
+    widget->text[sizeof(widget->text) - 1] = '\0';
+    widget->dirty = true;
+    return true;
+}
+
+void widget_scene_invalidate(widget_scene_t *scene)
+{
+    if (scene == NULL) {
+        return;
+    }
+    
+    for (uint8_t i = 0; i < scene->count; i++) {
+        scene->widgets[i].dirty = true;
+    }
+}
+
+// Draw text on one line, dropping characters that do not fit the box
+static void widget_draw_text(ssd1306_handle_t dev, const widget_t *widget, const char *text)
+{
+    const ssd1306_font_t *font = widget_font(widget);
+    uint16_t x = widget->x;
+    uint16_t end = widget->x + widget_width(widget);
+    
+    for (; *text != '\0'; text++) {
+        char glyph[2] = { *text, '\0' };
+        if (x + ssd1306_text_width(font, glyph) - font->spacing > end) {
+            break;
+        }
+        x += ssd1306_draw_glyph(dev, x, widget->y, *text, font, 1);
+    }
+}
+
+static void widget_draw_bar(ssd1306_handle_t dev, const widget_t *widget)
+{
+    uint8_t width = widget_width(widget);
+    uint8_t height = widget_height(widget);
+    int32_t range = widget->max - widget->min;
+    
+    ssd1306_gfx_rect(dev, widget->x, widget->y, width, height, 1);
+    if (range <= 0 || width < 3 || height < 3) {
+        return;
+    }
+    
+    int32_t value = widget->value;
+    if (value < widget->min) value = widget->min;
+    if (value > widget->max) value = widget->max;
+    
+    uint8_t fill = (int64_t)(value - widget->min) * (width - 2) / range;
+    ssd1306_fill_rect(dev, widget->x + 1, widget->y + 1, fill, height - 2, 1);
+}
+
+static void widget_render(ssd1306_handle_t dev, const widget_t *widget)
+{
+    char text[WIDGET_TEXT_MAX];
+    
+    ssd1306_fill_rect(dev, widget->x, widget->y, widget_width(widget), widget_height(widget), 0);
+    
+    switch (widget->type) {
+        case WIDGET_LABEL:
+            widget_draw_text(dev, widget, widget->text);
+            break;
+        case WIDGET_VALUE:
+            if (widget->format) {
+                widget->format(text, sizeof(text), widget->value);
+            } else {
+                snprintf(text, sizeof(text), widget->fmt ? widget->fmt : "%ld", (long)widget->value);
+            }
+            widget_draw_text(dev, widget, text);
+            break;
+        case WIDGET_BAR:
+            widget_draw_bar(dev, widget);
+            break;
+        case WIDGET_ICON:
+            if (widget->value >= 0 && widget->value < widget->icon_count) {
+                ssd1306_blit(dev, widget->x, widget->y, &widget->icons[widget->value], SSD1306_ROP_OR);
+            }
+            break;
+        default:
+            ESP_LOGW(TAG, "Unknown widget type %d", widget->type);
+            break;
+    }
+}
+
+uint8_t widget_scene_render(ssd1306_handle_t dev, widget_scene_t *scene)
+{
+    uint8_t drawn = 0;
+    
+    if (dev == NULL || scene == NULL) {
+        return 0;
+    }
+    
+    for (uint8_t i = 0; i < scene->count; i++) {
+        widget_t *widget = &scene->widgets[i];
+        if (!widget->dirty) {
+            continue;
+        }
+        
+        widget_render(dev, widget);
+        widget->dirty = false;
+        drawn++;
+    }
+    
+    return drawn;
+}
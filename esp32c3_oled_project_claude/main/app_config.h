@@ -6,16 +6,41 @@
 #define I2C_MASTER_SDA_IO           8
 #define I2C_MASTER_FREQ_HZ          400000
 
-#define BUTTON_GPIO                 0    // Boot button
 #define LED_GPIO                    8    // Built-in LED (if available)
 
+// Buttons, active low with the internal pull-ups
+#define BUTTON_SELECT_GPIO          0    // Boot button
+#define BUTTON_UP_GPIO              3
+#define BUTTON_DOWN_GPIO            4
+#define BUTTON_BACK_GPIO            5
+
 // Application Configuration
 #define APP_VERSION                 "2.0.0"
 #define APP_NAME                    "ESP32-C3 OLED Advanced"
 
-#define DISPLAY_UPDATE_INTERVAL_MS  100
+#define ANIMATION_FRAME_INTERVAL_MS 100     // Frame period while animating
+#define ANIMATION_STEP_MS           100     // Fixed animation simulation step
+#define ANIMATION_MAX_CATCHUP_STEPS 10      // Steps one update may take after a stall
+#define ANIMATION_CYCLE_MS          5000    // Time each animation is shown
+#define DISPLAY_TICK_INTERVAL_MS    1000    // Clock and status refresh
+#define DISPLAY_FLUSH_TASK_PRIORITY 5
+#define DISPLAY_STATS_OVERLAY       0       // 1 shows frame statistics on the bottom row
+#define DISPLAY_DIM_TIMEOUT_MS      30000   // 0 disables dimming
+#define DISPLAY_OFF_TIMEOUT_MS      120000  // 0 keeps the panel on
+#define DISPLAY_CONTRAST_DEFAULT    0xCF
+#define DISPLAY_CONTRAST_DIM        0x08
+#define DISPLAY_CONTRAST_STEP       0x20
 #define SENSOR_READ_INTERVAL_MS     1000
+#define SENSOR_CONVERSION_TIMEOUT_MS 100     // Readings not ready by then fail the update
+#define SENSOR_SIM_TEMPERATURE_US   10000   // Simulated sensor conversion times
+#define SENSOR_SIM_HUMIDITY_US      10000
+#define SENSOR_SIM_PRESSURE_US      15000
+#define SENSOR_SIM_LIGHT_US         5000
 #define MENU_TIMEOUT_MS            10000
+#define INPUT_DEBOUNCE_MS           20
+#define INPUT_LONG_PRESS_MS         600
+#define INPUT_REPEAT_MS             150     // Key repeat while held after a long press
+#define INPUT_TASK_PRIORITY         6       // Above the display task, so edges are handled first
 
 // WiFi Configuration
 #define WIFI_SSID                   "YourWiFiSSID"
@@ -27,6 +52,7 @@ typedef enum {
     DISPLAY_MODE_CLOCK = 0,
     DISPLAY_MODE_SYSTEM_INFO,
     DISPLAY_MODE_SENSOR_DATA,
+    DISPLAY_MODE_GRAPH,
     DISPLAY_MODE_NETWORK_INFO,
     DISPLAY_MODE_ANIMATIONS,
     DISPLAY_MODE_MENU,
@@ -41,6 +67,7 @@ typedef enum {
     ANIM_MATRIX_RAIN,
     ANIM_WAVE,
     ANIM_SPIRAL,
+    ANIM_FOUNTAIN,
     ANIM_MAX
 } animation_type_t;
 
@@ -1,35 +1,154 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include "esp_log.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "display_manager.h"
 #include "animations.h"
 #include "menu_system.h"
+#include "sensor_history.h"
+#include "sparkline.h"
 #include "utils.h"
+#include "widgets.h"
+#include "snapshot.h"
+#include "trig.h"
 #include <math.h>
 
 static const char *TAG = "DISPLAY_MGR";
 
+// Sensor graphs: the raw history of each quantity scrolls one column per reading
+typedef struct {
+    sensor_quantity_t quantity;
+    const char *name;
+    const char *unit;
+    sparkline_style_t style;
+    int16_t min_span;           // Smallest axis range in history units
+    uint8_t y;                  // Header row; the plot fills the three pages below it,
+                                // stopping short of the stats overlay while that is shown
+} graph_def_t;
+
+enum { GRAPH_TEMP, GRAPH_HUMIDITY, GRAPH_COUNT };
+static const graph_def_t graph_defs[GRAPH_COUNT] = {
+    [GRAPH_TEMP]     = { SENSOR_TEMPERATURE, "T", "C", SPARKLINE_LINE, 100, 0 },     // 1 C
+    [GRAPH_HUMIDITY] = { SENSOR_HUMIDITY,    "H", "%", SPARKLINE_BARS, 200, 32 },    // 2 %
+};
+
 struct display_manager_t {
     ssd1306_handle_t display;
     display_mode_t current_mode;
     uint32_t frame_count;
     uint32_t last_update;
     animation_type_t current_animation;
+    animation_t animation;
+    void *animation_arena;      // State of the running animation, sized for the largest
+    size_t animation_arena_size;
+    int64_t animation_clock_us; // Time of the last animation update
+    uint32_t last_activity;
+    display_power_state_t power_state;
+    bool redraw;                // Next update starts from a blank screen
+    time_t clock_time;          // Time shown by the clock widgets
+    int sensor_marker_x;        // Column of the sensor mode marker, -1 if none
+    sparkline_t graphs[GRAPH_COUNT];
+    uint32_t graph_seq[GRAPH_COUNT];    // History readings already pushed to each graph
+    TaskHandle_t volatile task; // Task waiting in display_manager_wait_events()
+    esp_timer_handle_t tick_timer;
+    uint32_t frame_due;         // Start time of the next animation frame, 0 if none
+    system_status_t status;     // Copy of the published status taken at each update
+    
+    // Frame instrumentation
+    frame_stats_t stats;
+    SemaphoreHandle_t stats_lock;
+    uint32_t flush_frames;      // Driver frame count at the last sample
+    bool overlay;
+    uint32_t overlay_updated;
+};
+
+// Published by other tasks, read by the display task without blocking either side
+static system_status_t g_status_copies[2];
+static snapshot_t g_status_snapshot = SNAPSHOT_INIT(g_status_copies);
+static SemaphoreHandle_t g_status_lock;    // Serializes writers of g_status_snapshot
+static volatile uint8_t g_brightness = DISPLAY_CONTRAST_DEFAULT;
+
+// Retained screens: each mode declares its widgets once and only binds new
+// values per update, so unchanged widgets are neither redrawn nor resent
+static void format_two_digits(char *buf, size_t len, int32_t value);
+static void format_date(char *buf, size_t len, int32_t value);
+static void format_uptime(char *buf, size_t len, int32_t value);
+static void format_temperature(char *buf, size_t len, int32_t value);
+static void format_humidity(char *buf, size_t len, int32_t value);
+static void format_fps(char *buf, size_t len, int32_t value);
+
+enum { CLOCK_HOURS, CLOCK_SEP1, CLOCK_MINUTES, CLOCK_SEP2, CLOCK_SECONDS, CLOCK_DATE, CLOCK_UPTIME, CLOCK_COUNT };
+static widget_t clock_widgets[CLOCK_COUNT] = {
+    [CLOCK_HOURS]   = { .type = WIDGET_VALUE, .x = 0,  .y = 8,  .width = 16, .format = format_two_digits, .value = -1 },
+    [CLOCK_SEP1]    = { .type = WIDGET_LABEL, .x = 16, .y = 8,  .width = 8,  .text = ":" },
+    [CLOCK_MINUTES] = { .type = WIDGET_VALUE, .x = 24, .y = 8,  .width = 16, .format = format_two_digits, .value = -1 },
+    [CLOCK_SEP2]    = { .type = WIDGET_LABEL, .x = 40, .y = 8,  .width = 8,  .text = ":" },
+    [CLOCK_SECONDS] = { .type = WIDGET_VALUE, .x = 48, .y = 8,  .width = 16, .format = format_two_digits, .value = -1 },
+    [CLOCK_DATE]    = { .type = WIDGET_VALUE, .x = 0,  .y = 28, .width = 80, .format = format_date, .value = -1 },
+    [CLOCK_UPTIME]  = { .type = WIDGET_VALUE, .x = 0,  .y = 48, .format = format_uptime },
+};
+
+enum { SYSINFO_TITLE, SYSINFO_HEAP, SYSINFO_CPU, SYSINFO_FPS, SYSINFO_COUNT };
+static widget_t sysinfo_widgets[SYSINFO_COUNT] = {
+    [SYSINFO_TITLE] = { .type = WIDGET_LABEL, .x = 0, .y = 0,  .text = "System Info" },
+    [SYSINFO_HEAP]  = { .type = WIDGET_VALUE, .x = 0, .y = 16, .fmt = "Heap: %ld KB" },
+    [SYSINFO_CPU]   = { .type = WIDGET_LABEL, .x = 0, .y = 32, .text = "CPU: 160 MHz" }, // Default ESP32-C3 frequency
+    [SYSINFO_FPS]   = { .type = WIDGET_VALUE, .x = 0, .y = 48, .format = format_fps },
 };
 
-static system_status_t g_system_status = {0};
+enum { SENSORS_TITLE, SENSORS_TEMP, SENSORS_HUMIDITY, SENSORS_COUNT };
+static widget_t sensor_widgets[SENSORS_COUNT] = {
+    [SENSORS_TITLE]    = { .type = WIDGET_LABEL, .x = 0, .y = 0,  .text = "Sensors" },
+    [SENSORS_TEMP]     = { .type = WIDGET_VALUE, .x = 0, .y = 16, .format = format_temperature },
+    [SENSORS_HUMIDITY] = { .type = WIDGET_VALUE, .x = 0, .y = 32, .format = format_humidity },
+};
+
+enum { NETWORK_TITLE, NETWORK_LINE1, NETWORK_LINE2, NETWORK_LINE3, NETWORK_COUNT };
+static widget_t network_widgets[NETWORK_COUNT] = {
+    [NETWORK_TITLE] = { .type = WIDGET_LABEL, .x = 0, .y = 0,  .text = "Network" },
+    [NETWORK_LINE1] = { .type = WIDGET_LABEL, .x = 0, .y = 16 },
+    [NETWORK_LINE2] = { .type = WIDGET_LABEL, .x = 0, .y = 32 },
+    [NETWORK_LINE3] = { .type = WIDGET_LABEL, .x = 0, .y = 48 },
+};
+
+// Graph headers, one per graph
+static widget_t graph_widgets[GRAPH_COUNT] = {
+    [GRAPH_TEMP]     = { .type = WIDGET_LABEL, .x = 0, .y = 0,  .font = &ssd1306_font_6x8 },
+    [GRAPH_HUMIDITY] = { .type = WIDGET_LABEL, .x = 0, .y = 32, .font = &ssd1306_font_6x8 },
+};
+
+// Frame statistics overlay on the bottom text row
+static widget_t overlay_widget = { .type = WIDGET_LABEL, .x = 0, .y = 56, .font = &ssd1306_font_6x8 };
+static widget_scene_t overlay_scene = { &overlay_widget, 1 };
+
+static widget_scene_t g_scenes[DISPLAY_MODE_MAX] = {
+    [DISPLAY_MODE_CLOCK]        = { clock_widgets, CLOCK_COUNT },
+    [DISPLAY_MODE_SYSTEM_INFO]  = { sysinfo_widgets, SYSINFO_COUNT },
+    [DISPLAY_MODE_SENSOR_DATA]  = { sensor_widgets, SENSORS_COUNT },
+    [DISPLAY_MODE_GRAPH]        = { graph_widgets, GRAPH_COUNT },
+    [DISPLAY_MODE_NETWORK_INFO] = { network_widgets, NETWORK_COUNT },
+};
 
 // Mode display functions
+static void display_init_graphs(display_manager_handle_t manager);
+static void display_apply_power_policy(display_manager_handle_t manager, uint32_t now);
+static TickType_t display_next_deadline(display_manager_handle_t manager, uint32_t now);
+static void display_tick_callback(void *arg);
+static void display_record_frame(display_manager_handle_t manager, int64_t start_us, bool late);
+static void display_update_overlay(display_manager_handle_t manager, uint32_t now);
 static void display_clock_mode(display_manager_handle_t manager);
 static void display_system_info_mode(display_manager_handle_t manager);
 static void display_sensor_data_mode(display_manager_handle_t manager);
+static int display_graph_mode(display_manager_handle_t manager);
 static void display_network_info_mode(display_manager_handle_t manager);
 static void display_animations_mode(display_manager_handle_t manager);
-static void display_menu_mode(display_manager_handle_t manager);
+static void display_menu_mode(display_manager_handle_t manager, bool cleared);
 
 display_manager_handle_t display_manager_create(ssd1306_handle_t display)
 {
@@ -49,6 +168,67 @@ display_manager_handle_t display_manager_create(ssd1306_handle_t display)
     manager->frame_count = 0;
     manager->last_update = 0;
     manager->current_animation = ANIM_BOUNCING_BALL;
+    manager->animation.def = NULL;
+    manager->animation_clock_us = 0;
+    manager->last_activity = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    manager->power_state = DISPLAY_POWER_ACTIVE;
+    manager->redraw = true;
+    manager->clock_time = 0;
+    manager->sensor_marker_x = -1;
+    manager->task = NULL;
+    manager->tick_timer = NULL;
+    manager->frame_due = 0;
+    manager->flush_frames = 0;
+    manager->overlay = DISPLAY_STATS_OVERLAY;
+    manager->overlay_updated = 0;
+    display_init_graphs(manager);
+    frame_stats_reset(&manager->stats);
+    
+    // One arena serves whichever animation runs
+    manager->animation_arena_size = animations_arena_size();
+    manager->animation_arena = malloc(manager->animation_arena_size);
+    if (manager->animation_arena == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate animation state");
+        free(manager);
+        return NULL;
+    }
+    
+    manager->stats_lock = xSemaphoreCreateMutex();
+    if (manager->stats_lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create frame statistics lock");
+        free(manager->animation_arena);
+        free(manager);
+        return NULL;
+    }
+    
+    if (g_status_lock == NULL) {
+        g_status_lock = xSemaphoreCreateMutex();
+        if (g_status_lock == NULL) {
+            ESP_LOGE(TAG, "Failed to create status lock");
+            vSemaphoreDelete(manager->stats_lock);
+            free(manager->animation_arena);
+            free(manager);
+            return NULL;
+        }
+    }
+    
+    // The clock only changes once per second, so that is all the time base static screens need
+    const esp_timer_create_args_t tick_args = {
+        .callback = display_tick_callback,
+        .arg = manager,
+        .name = "display_tick",
+    };
+    if (esp_timer_create(&tick_args, &manager->tick_timer) != ESP_OK ||
+        esp_timer_start_periodic(manager->tick_timer, DISPLAY_TICK_INTERVAL_MS * 1000ULL) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start display tick timer");
+        if (manager->tick_timer) {
+            esp_timer_delete(manager->tick_timer);
+        }
+        vSemaphoreDelete(manager->stats_lock);
+        free(manager->animation_arena);
+        free(manager);
+        return NULL;
+    }
     
     ESP_LOGI(TAG, "Display manager created successfully");
     return manager;
@@ -57,6 +237,10 @@ display_manager_handle_t display_manager_create(ssd1306_handle_t display)
 void display_manager_delete(display_manager_handle_t manager)
 {
     if (manager) {
+        esp_timer_stop(manager->tick_timer);
+        esp_timer_delete(manager->tick_timer);
+        vSemaphoreDelete(manager->stats_lock);
+        free(manager->animation_arena);
         free(manager);
         ESP_LOGI(TAG, "Display manager deleted");
     }
@@ -70,10 +254,15 @@ esp_err_t display_manager_set_mode(display_manager_handle_t manager, display_mod
     
     manager->current_mode = mode;
     manager->frame_count = 0;
+    manager->redraw = true;
+    manager->frame_due = 0;
+    menu_system_activate(mode == DISPLAY_MODE_MENU);
     
-    // Reset animation when entering animation mode
+    // Restart the animation when entering animation mode
     if (mode == DISPLAY_MODE_ANIMATIONS) {
-        animations_reset();
+        animation_start(&manager->animation, manager->current_animation,
+                        manager->animation_arena, manager->animation_arena_size);
+        manager->animation_clock_us = esp_timer_get_time();
     }
     
     return ESP_OK;
@@ -86,16 +275,38 @@ esp_err_t display_manager_update(display_manager_handle_t manager)
     }
     
     uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    
+    // Nothing is rendered or sent while the panel is off
+    display_apply_power_policy(manager, now);
+    if (manager->power_state == DISPLAY_POWER_OFF) {
+        manager->frame_due = 0;
+        return ESP_OK;
+    }
+    
+    // An animation frame is late once a whole frame slot went by without it
+    int64_t frame_start = esp_timer_get_time();
+    bool late = manager->frame_due && (int32_t)(now - manager->frame_due) >= ANIMATION_FRAME_INTERVAL_MS;
+    
     manager->last_update = now;
     manager->frame_count++;
     
     // Update system status
-    g_system_status.free_heap = esp_get_free_heap_size();
-    g_system_status.uptime_seconds = now / 1000;
-    time(&g_system_status.current_time);
+    snapshot_read(&g_status_snapshot, &manager->status);
+    manager->status.free_heap = esp_get_free_heap_size();
+    manager->status.uptime_seconds = now / 1000;
+    time(&manager->status.current_time);
     
-    // Clear screen
-    ssd1306_clear_screen(manager->display, 0x00);
+    // Widget screens and the menu only redraw what changed; the screen is
+    // cleared when the mode changes and every frame for the free-running modes
+    widget_scene_t *scene = &g_scenes[manager->current_mode];
+    bool cleared = manager->redraw || (scene->count == 0 && manager->current_mode != DISPLAY_MODE_MENU);
+    if (cleared) {
+        ssd1306_clear_screen(manager->display, 0x00);
+        widget_scene_invalidate(scene);
+        manager->sensor_marker_x = -1;
+        display_init_graphs(manager);
+        manager->redraw = false;
+    }
     
     // Display current mode
     switch (manager->current_mode) {
@@ -108,6 +319,11 @@ esp_err_t display_manager_update(display_manager_handle_t manager)
         case DISPLAY_MODE_SENSOR_DATA:
             display_sensor_data_mode(manager);
             break;
+        case DISPLAY_MODE_GRAPH:
+            if (display_graph_mode(manager) > 0) {
+                overlay_widget.dirty = true;
+            }
+            break;
         case DISPLAY_MODE_NETWORK_INFO:
             display_network_info_mode(manager);
             break;
@@ -115,17 +331,74 @@ esp_err_t display_manager_update(display_manager_handle_t manager)
             display_animations_mode(manager);
             break;
         case DISPLAY_MODE_MENU:
-            display_menu_mode(manager);
+            display_menu_mode(manager, cleared);
             break;
         default:
             ssd1306_show_string(manager->display, 0, 0, "Unknown Mode", 16, 1);
             break;
     }
     
-    // Refresh display
-    ssd1306_refresh_gram(manager->display);
+    // The overlay sits on top of the screen, so redraw it whenever something below changed
+    if (widget_scene_render(manager->display, scene) > 0 || cleared) {
+        overlay_widget.dirty = true;
+    }
+    if (manager->overlay) {
+        display_update_overlay(manager, now);
+        widget_scene_render(manager->display, &overlay_scene);
+    }
     
-    return ESP_OK;
+    manager->frame_due = (manager->current_mode == DISPLAY_MODE_ANIMATIONS) ? now + ANIMATION_FRAME_INTERVAL_MS : 0;
+    display_record_frame(manager, frame_start, late);
+    
+    // Hand the frame to the flush task; the next frame renders while it is sent
+    return ssd1306_refresh_gram_async(manager->display);
+}
+
+uint32_t display_manager_wait_events(display_manager_handle_t manager)
+{
+    if (manager == NULL) {
+        return 0;
+    }
+    
+    manager->task = xTaskGetCurrentTaskHandle();
+    
+    uint32_t events = 0;
+    while (1) {
+        uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        uint32_t posted = 0;
+        
+        // A timeout means a frame or a power state change is due
+        if (xTaskNotifyWait(0, UINT32_MAX, &posted, display_next_deadline(manager, now)) != pdTRUE) {
+            return events;
+        }
+        events |= posted;
+        
+        // While the panel is off only a button press matters; animations pick up
+        // data changes with their next frame instead of rendering extra ones
+        uint32_t wanted = DISPLAY_EVENT_BUTTON | DISPLAY_EVENT_REDRAW;
+        if (manager->power_state != DISPLAY_POWER_OFF && manager->current_mode != DISPLAY_MODE_ANIMATIONS) {
+            wanted = UINT32_MAX;
+        }
+        if (events & wanted) {
+            return events;
+        }
+    }
+}
+
+void display_manager_post_event(display_manager_handle_t manager, uint32_t events)
+{
+    TaskHandle_t task = manager ? manager->task : NULL;
+    if (task) {
+        xTaskNotify(task, events, eSetBits);
+    }
+}
+
+void display_manager_post_event_from_isr(display_manager_handle_t manager, uint32_t events, BaseType_t *higher_prio_woken)
+{
+    TaskHandle_t task = manager ? manager->task : NULL;
+    if (task) {
+        xTaskNotifyFromISR(task, events, eSetBits, higher_prio_woken);
+    }
 }
 
 esp_err_t display_manager_show_startup(display_manager_handle_t manager)
@@ -146,11 +419,8 @@ esp_err_t display_manager_show_startup(display_manager_handle_t manager)
     
     for (int i = 0; i < 3; i++) {
         int progress_width = (i + 1) * 40;
-        for (int x = 1; x < progress_width && x < 126; x++) {
-            for (int y = 51; y < 59; y++) {
-                ssd1306_draw_point(manager->display, x, y, 1);
-            }
-        }
+        if (progress_width > 126) progress_width = 126;
+        ssd1306_fill_rect(manager->display, 1, 51, progress_width - 1, 8, 1);
         ssd1306_refresh_gram(manager->display);
         vTaskDelay(pdMS_TO_TICKS(500));
     }
@@ -158,120 +428,389 @@ esp_err_t display_manager_show_startup(display_manager_handle_t manager)
     return ESP_OK;
 }
 
+esp_err_t display_manager_get_frame_stats(display_manager_handle_t manager, frame_stats_summary_t *summary)
+{
+    if (manager == NULL || summary == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(manager->stats_lock, portMAX_DELAY);
+    frame_stats_summarize(&manager->stats, summary);
+    xSemaphoreGive(manager->stats_lock);
+    return ESP_OK;
+}
+
+void display_manager_set_overlay(display_manager_handle_t manager, bool enable)
+{
+    if (manager && manager->overlay != enable) {
+        manager->overlay = enable;
+        manager->overlay_updated = 0;
+        manager->redraw = true;
+    }
+}
+
+bool display_manager_notify_activity(display_manager_handle_t manager)
+{
+    if (manager == NULL) {
+        return false;
+    }
+    
+    manager->last_activity = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    
+    display_power_state_t previous = manager->power_state;
+    if (previous == DISPLAY_POWER_ACTIVE) {
+        return false;
+    }
+    
+    manager->power_state = DISPLAY_POWER_ACTIVE;
+    ssd1306_set_contrast(manager->display, g_brightness);
+    if (previous == DISPLAY_POWER_OFF) {
+        ssd1306_set_sleep(manager->display, false);
+        if (esp_timer_start_periodic(manager->tick_timer, DISPLAY_TICK_INTERVAL_MS * 1000ULL) != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to restart display tick timer");
+        }
+        ESP_LOGI(TAG, "Display woken up");
+        return true;
+    }
+    
+    return false;
+}
+
+display_power_state_t display_manager_get_power_state(display_manager_handle_t manager)
+{
+    return manager ? manager->power_state : DISPLAY_POWER_OFF;
+}
+
+void display_manager_adjust_brightness(int delta)
+{
+    int level = g_brightness + delta;
+    if (level < 1) level = 1;
+    if (level > 255) level = 255;
+    
+    // Applied by the display task on its next update
+    g_brightness = level;
+    ESP_LOGI(TAG, "Brightness set to %d", level);
+}
+
 void display_manager_update_system_status(system_status_t *status)
 {
-    if (status) {
-        memcpy(&g_system_status, status, sizeof(system_status_t));
+    // Published before the display manager exists, there is nobody to read it
+    if (status && g_status_lock) {
+        xSemaphoreTake(g_status_lock, portMAX_DELAY);
+        snapshot_write(&g_status_snapshot, status);
+        xSemaphoreGive(g_status_lock);
     }
 }
 
-// Mode display implementations
-static void display_clock_mode(display_manager_handle_t manager)
+// Empty graphs laid out for the current overlay setting; toggling the overlay
+// redraws the screen, which lands here again
+static void display_init_graphs(display_manager_handle_t manager)
 {
-    char time_str[32];
-    char date_str[32];
-    struct tm timeinfo;
+    for (int i = 0; i < GRAPH_COUNT; i++) {
+        const graph_def_t *def = &graph_defs[i];
+        uint8_t top = def->y + 8;
+        uint8_t bottom = def->y + 32;
+        if (manager->overlay && bottom > overlay_widget.y) {
+            bottom = overlay_widget.y;
+        }
+        sparkline_init(&manager->graphs[i], 0, top, SSD1306_WIDTH, bottom - top, def->style, def->min_span);
+        manager->graph_seq[i] = 0;
+    }
+}
+
+// Dim after DISPLAY_DIM_TIMEOUT_MS without activity, then switch the panel off
+static void display_apply_power_policy(display_manager_handle_t manager, uint32_t now)
+{
+    uint32_t idle = now - manager->last_activity;
     
-    if (g_system_status.current_time > 0) {
-        localtime_r(&g_system_status.current_time, &timeinfo);
-        strftime(time_str, sizeof(time_str), "%H:%M:%S", &timeinfo);
-        strftime(date_str, sizeof(date_str), "%Y-%m-%d", &timeinfo);
-    } else {
-        strcpy(time_str, "--:--:--");
-        strcpy(date_str, "----/--/--");
+    if (DISPLAY_OFF_TIMEOUT_MS && idle >= DISPLAY_OFF_TIMEOUT_MS) {
+        if (manager->power_state != DISPLAY_POWER_OFF &&
+            ssd1306_set_sleep(manager->display, true) == ESP_OK) {
+            manager->power_state = DISPLAY_POWER_OFF;
+            // Nothing is drawn while the panel is off, so the clock tick would only wake the task
+            esp_timer_stop(manager->tick_timer);
+            ESP_LOGI(TAG, "Display off after %lu ms idle", (unsigned long)idle);
+        }
+        return;
     }
     
-    // Display large time
-    ssd1306_show_string(manager->display, 0, 8, time_str, 16, 1);
-    ssd1306_show_string(manager->display, 0, 28, date_str, 16, 1);
+    if (DISPLAY_DIM_TIMEOUT_MS && idle >= DISPLAY_DIM_TIMEOUT_MS) {
+        if (manager->power_state == DISPLAY_POWER_ACTIVE &&
+            ssd1306_set_contrast(manager->display, DISPLAY_CONTRAST_DIM) == ESP_OK) {
+            manager->power_state = DISPLAY_POWER_DIM;
+        }
+        return;
+    }
     
-    // Show uptime
-    char uptime_str[32];
-    uint32_t hours = g_system_status.uptime_seconds / 3600;
-    uint32_t minutes = (g_system_status.uptime_seconds % 3600) / 60;
-    snprintf(uptime_str, sizeof(uptime_str), "Up: %ldh %ldm", hours, minutes);
-    ssd1306_show_string(manager->display, 0, 48, uptime_str, 16, 1);
+    // Pick up brightness changes made from the menu
+    if (manager->power_state == DISPLAY_POWER_ACTIVE) {
+        ssd1306_set_contrast(manager->display, g_brightness);
+    }
 }
 
-static void display_system_info_mode(display_manager_handle_t manager)
+// Ticks until display_manager_update() has work without any event: the next
+// animation frame or the next idle timeout
+static TickType_t display_next_deadline(display_manager_handle_t manager, uint32_t now)
 {
-    char info_str[32];
+    uint32_t wait_ms = UINT32_MAX;
+    uint32_t idle = now - manager->last_activity;
     
-    ssd1306_show_string(manager->display, 0, 0, "System Info", 16, 1);
+    if (manager->power_state == DISPLAY_POWER_OFF) {
+        return portMAX_DELAY;
+    }
+    
+    if (manager->current_mode == DISPLAY_MODE_ANIMATIONS) {
+        uint32_t since_frame = now - manager->last_update;
+        wait_ms = since_frame < ANIMATION_FRAME_INTERVAL_MS ? ANIMATION_FRAME_INTERVAL_MS - since_frame : 0;
+    }
     
-    // Free heap
-    snprintf(info_str, sizeof(info_str), "Heap: %ld KB", g_system_status.free_heap / 1024);
-    ssd1306_show_string(manager->display, 0, 16, info_str, 16, 1);
+    uint32_t timeout = 0;
+    if (manager->power_state == DISPLAY_POWER_ACTIVE && DISPLAY_DIM_TIMEOUT_MS) {
+        timeout = DISPLAY_DIM_TIMEOUT_MS;
+    } else if (DISPLAY_OFF_TIMEOUT_MS) {
+        timeout = DISPLAY_OFF_TIMEOUT_MS;
+    }
+    if (timeout) {
+        // Retry at frame pace if an overdue power change could not be applied
+        uint32_t until_timeout = idle < timeout ? timeout - idle : ANIMATION_FRAME_INTERVAL_MS;
+        if (until_timeout < wait_ms) wait_ms = until_timeout;
+    }
     
-    // CPU frequency - simplified version
-    snprintf(info_str, sizeof(info_str), "CPU: %d MHz", 160); // Default ESP32-C3 frequency
-    ssd1306_show_string(manager->display, 0, 32, info_str, 16, 1);
+    return wait_ms == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(wait_ms);
+}
+
+static void display_tick_callback(void *arg)
+{
+    display_manager_post_event((display_manager_handle_t)arg, DISPLAY_EVENT_TICK);
+}
+
+static uint16_t clamp_u16(uint32_t value)
+{
+    return value > UINT16_MAX ? UINT16_MAX : value;
+}
+
+// Store one frame; the flush figures are those of the last frame the driver finished
+static void display_record_frame(display_manager_handle_t manager, int64_t start_us, bool late)
+{
+    frame_sample_t sample = {
+        .start_us = (uint32_t)start_us,
+        .render_us = clamp_u16(esp_timer_get_time() - start_us),
+        .late = late,
+    };
     
-    // Frame rate
-    uint32_t fps = 0;
-    if (manager->last_update > 0) {
-        fps = manager->frame_count * 1000 / manager->last_update;
-        if (fps > 100) fps = 100; // Cap at reasonable value
+    ssd1306_flush_stats_t flush;
+    if (ssd1306_get_flush_stats(manager->display, &flush) == ESP_OK && flush.frames != manager->flush_frames) {
+        manager->flush_frames = flush.frames;
+        sample.flushed = true;
+        sample.flush_us = clamp_u16(flush.flush_us);
+        sample.bytes = clamp_u16(flush.bytes);
+        sample.dirty_columns = flush.dirty_columns;
     }
-    snprintf(info_str, sizeof(info_str), "FPS: %ld", fps);
-    ssd1306_show_string(manager->display, 0, 48, info_str, 16, 1);
+    
+    xSemaphoreTake(manager->stats_lock, portMAX_DELAY);
+    frame_stats_record(&manager->stats, &sample);
+    xSemaphoreGive(manager->stats_lock);
 }
 
-static void display_sensor_data_mode(display_manager_handle_t manager)
+// Worst-case render and flush time in ms, real frame rate and missed frames, once per second
+static void display_update_overlay(display_manager_handle_t manager, uint32_t now)
 {
-    char sensor_str[32];
+    if (manager->overlay_updated && now - manager->overlay_updated < DISPLAY_TICK_INTERVAL_MS) {
+        return;
+    }
+    manager->overlay_updated = now;
     
-    ssd1306_show_string(manager->display, 0, 0, "Sensors", 16, 1);
+    frame_stats_summary_t summary;
+    char text[WIDGET_TEXT_MAX];
+    display_manager_get_frame_stats(manager, &summary);
+    snprintf(text, sizeof(text), "R%u.%u F%u.%u %lu.%lufps M%u",
+             summary.render_us.p99 / 1000, summary.render_us.p99 / 100 % 10,
+             summary.flush_us.p99 / 1000, summary.flush_us.p99 / 100 % 10,
+             (unsigned long)(summary.fps_x100 / 100), (unsigned long)(summary.fps_x100 / 10 % 10),
+             summary.missed);
+    widget_set_text(&overlay_widget, text);
+}
+
+// Widget formatters
+static void format_two_digits(char *buf, size_t len, int32_t value)
+{
+    if (value < 0) {
+        snprintf(buf, len, "--");
+    } else {
+        snprintf(buf, len, "%02ld", (long)value);
+    }
+}
+
+// value is YYYYMMDD
+static void format_date(char *buf, size_t len, int32_t value)
+{
+    if (value < 0) {
+        snprintf(buf, len, "----/--/--");
+    } else {
+        snprintf(buf, len, "%04ld-%02ld-%02ld", (long)(value / 10000), (long)(value / 100 % 100), (long)(value % 100));
+    }
+}
+
+// value is minutes of uptime
+static void format_uptime(char *buf, size_t len, int32_t value)
+{
+    snprintf(buf, len, "Up: %ldh %ldm", (long)(value / 60), (long)(value % 60));
+}
+
+// value is tenths of a degree
+static void format_temperature(char *buf, size_t len, int32_t value)
+{
+    snprintf(buf, len, "Temp: %.1f C", value / 10.0f);
+}
+
+// value is tenths of a percent
+static void format_humidity(char *buf, size_t len, int32_t value)
+{
+    snprintf(buf, len, "Hum: %.1f %%", value / 10.0f);
+}
+
+// value is tenths of a frame per second
+static void format_fps(char *buf, size_t len, int32_t value)
+{
+    snprintf(buf, len, "FPS: %ld.%ld", (long)(value / 10), (long)(value % 10));
+}
+
+// Mode display implementations
+static void display_clock_mode(display_manager_handle_t manager)
+{
+    // Broken-down time is only recomputed when the second changes
+    if (manager->status.current_time != manager->clock_time) {
+        manager->clock_time = manager->status.current_time;
+        
+        if (manager->clock_time > 0) {
+            struct tm timeinfo;
+            localtime_r(&manager->clock_time, &timeinfo);
+            widget_set_value(&clock_widgets[CLOCK_HOURS], timeinfo.tm_hour);
+            widget_set_value(&clock_widgets[CLOCK_MINUTES], timeinfo.tm_min);
+            widget_set_value(&clock_widgets[CLOCK_SECONDS], timeinfo.tm_sec);
+            widget_set_value(&clock_widgets[CLOCK_DATE],
+                             (timeinfo.tm_year + 1900) * 10000 + (timeinfo.tm_mon + 1) * 100 + timeinfo.tm_mday);
+        } else {
+            widget_set_value(&clock_widgets[CLOCK_HOURS], -1);
+            widget_set_value(&clock_widgets[CLOCK_MINUTES], -1);
+            widget_set_value(&clock_widgets[CLOCK_SECONDS], -1);
+            widget_set_value(&clock_widgets[CLOCK_DATE], -1);
+        }
+    }
     
-    // Temperature (simulated)
-    snprintf(sensor_str, sizeof(sensor_str), "Temp: %.1f C", g_system_status.temperature);
-    ssd1306_show_string(manager->display, 0, 16, sensor_str, 16, 1);
+    widget_set_value(&clock_widgets[CLOCK_UPTIME], manager->status.uptime_seconds / 60);
+}
+
+static void display_system_info_mode(display_manager_handle_t manager)
+{
+    widget_set_value(&sysinfo_widgets[SYSINFO_HEAP], manager->status.free_heap / 1024);
     
-    // Humidity (simulated)
-    snprintf(sensor_str, sizeof(sensor_str), "Hum: %.1f %%", g_system_status.humidity);
-    ssd1306_show_string(manager->display, 0, 32, sensor_str, 16, 1);
+    // Frame rate measured over the statistics window
+    frame_stats_summary_t summary;
+    display_manager_get_frame_stats(manager, &summary);
+    widget_set_value(&sysinfo_widgets[SYSINFO_FPS], summary.fps_x100 / 10);
+}
+
+static void display_sensor_data_mode(display_manager_handle_t manager)
+{
+    widget_set_value(&sensor_widgets[SENSORS_TEMP], lroundf(manager->status.temperature * 10.0f));
+    widget_set_value(&sensor_widgets[SENSORS_HUMIDITY], lroundf(manager->status.humidity * 10.0f));
     
-    // Some animation
-    int x = 64 + 32 * sin(manager->frame_count * 0.1);
-    ssd1306_draw_point(manager->display, x, 50, 1);
+    // Some animation: move the marker, touching only its old and new pixel
+    uint32_t phase = manager->frame_count * TRIG_PHASE(0.1);
+    int x = 64 + trig_mul(32, trig_sin(phase >> 16));
+    if (x != manager->sensor_marker_x) {
+        if (manager->sensor_marker_x >= 0) {
+            ssd1306_draw_point(manager->display, manager->sensor_marker_x, 50, 0);
+        }
+        ssd1306_draw_point(manager->display, x, 50, 1);
+        manager->sensor_marker_x = x;
+    }
 }
 
-static void display_network_info_mode(display_manager_handle_t manager)
+// Push the readings recorded since the last frame; each graph scrolls by that
+// many columns and draws only the new ones unless its axis has to change
+static int display_graph_mode(display_manager_handle_t manager)
 {
-    char net_str[64];
+    sensor_bucket_t readings[SPARKLINE_MAX_WIDTH];
+    char text[WIDGET_TEXT_MAX];
+    int columns = 0;
+    
+    for (int i = 0; i < GRAPH_COUNT; i++) {
+        const graph_def_t *def = &graph_defs[i];
+        sparkline_t *graph = &manager->graphs[i];
+        
+        int n = sensor_history_read_since(def->quantity, &manager->graph_seq[i], readings, graph->width);
+        for (int j = 0; j < n; j++) {
+            sparkline_push(graph, readings[j].avg);
+        }
+        columns += sparkline_render(graph, manager->display);
+        
+        // Header: newest reading and the range on screen
+        int16_t min, max;
+        if (n > 0 && sparkline_range(graph, &min, &max)) {
+            int16_t last = readings[n - 1].avg;
+            if (last == SENSOR_HISTORY_NO_DATA) {
+                snprintf(text, sizeof(text), "%s --", def->name);
+            } else {
+                snprintf(text, sizeof(text), "%s %.1f%s %.1f-%.1f", def->name,
+                         sensor_history_to_float(def->quantity, last), def->unit,
+                         sensor_history_to_float(def->quantity, min),
+                         sensor_history_to_float(def->quantity, max));
+            }
+            widget_set_text(&graph_widgets[i], text);
+        } else if (graph->count == 0) {
+            snprintf(text, sizeof(text), "%s --", def->name);
+            widget_set_text(&graph_widgets[i], text);
+        }
+    }
     
-    ssd1306_show_string(manager->display, 0, 0, "Network", 16, 1);
+    return columns;
+}
+
+static void display_network_info_mode(display_manager_handle_t manager)
+{
+    char net_str[WIDGET_TEXT_MAX];
     
-    if (g_system_status.wifi_connected) {
-        snprintf(net_str, sizeof(net_str), "WiFi: %s", g_system_status.wifi_ssid);
-        ssd1306_show_string(manager->display, 0, 16, net_str, 16, 1);
+    if (manager->status.wifi_connected) {
+        snprintf(net_str, sizeof(net_str), "WiFi: %s", manager->status.wifi_ssid);
+        widget_set_text(&network_widgets[NETWORK_LINE1], net_str);
         
-        snprintf(net_str, sizeof(net_str), "IP: %s", g_system_status.ip_address);
-        ssd1306_show_string(manager->display, 0, 32, net_str, 16, 1);
+        snprintf(net_str, sizeof(net_str), "IP: %s", manager->status.ip_address);
+        widget_set_text(&network_widgets[NETWORK_LINE2], net_str);
         
-        snprintf(net_str, sizeof(net_str), "RSSI: %d dBm", g_system_status.wifi_rssi);
-        ssd1306_show_string(manager->display, 0, 48, net_str, 16, 1);
+        snprintf(net_str, sizeof(net_str), "RSSI: %d dBm", manager->status.wifi_rssi);
+        widget_set_text(&network_widgets[NETWORK_LINE3], net_str);
     } else {
-        ssd1306_show_string(manager->display, 0, 16, "WiFi: Disconnected", 16, 1);
-        ssd1306_show_string(manager->display, 0, 32, "Connecting...", 16, 1);
+        widget_set_text(&network_widgets[NETWORK_LINE1], "WiFi: Offline");
+        widget_set_text(&network_widgets[NETWORK_LINE2], "Connecting...");
+        widget_set_text(&network_widgets[NETWORK_LINE3], "");
     }
 }
 
 static void display_animations_mode(display_manager_handle_t manager)
 {
-    // Cycle through animations every 5 seconds
-    if (manager->frame_count % 50 == 0) {
+    // Animations advance by elapsed time, so late or skipped frames do not slow them down
+    int64_t now = esp_timer_get_time();
+    uint32_t elapsed_us = now - manager->animation_clock_us;
+    manager->animation_clock_us = now;
+    
+    // Cycle through animations every ANIMATION_CYCLE_MS of animation time
+    if (animation_time_ms(&manager->animation) >= ANIMATION_CYCLE_MS) {
         manager->current_animation = (manager->current_animation + 1) % ANIM_MAX;
         if (manager->current_animation == ANIM_NONE) {
             manager->current_animation = ANIM_BOUNCING_BALL;
         }
-        animations_set_type(manager->current_animation);
+        animation_start(&manager->animation, manager->current_animation,
+                        manager->animation_arena, manager->animation_arena_size);
     }
     
-    animations_update(manager->display, manager->frame_count);
+    animation_update(&manager->animation, manager->display, elapsed_us);
 }
 
-static void display_menu_mode(display_manager_handle_t manager)
+static void display_menu_mode(display_manager_handle_t manager, bool cleared)
 {
-    menu_system_display(manager->display);
+    if (menu_system_display(manager->display, cleared) > 0) {
+        overlay_widget.dirty = true;
+    }
 }
@@ -1,11 +1,22 @@
 #ifndef DISPLAY_MANAGER_H
 #define DISPLAY_MANAGER_H
 
+#include <time.h>
+#include "freertos/FreeRTOS.h"
 #include "ssd1306.h"
 #include "app_config.h"
+#include "frame_stats.h"
 
 typedef struct display_manager_t* display_manager_handle_t;
 
+// Change events posted to the display task. They are task notification bits,
+// so events posted while a frame renders coalesce into one update.
+#define DISPLAY_EVENT_BUTTON        (1 << 0)    // Input events queued
+#define DISPLAY_EVENT_TICK          (1 << 1)    // Clock second tick
+#define DISPLAY_EVENT_SENSOR        (1 << 2)    // New sensor readings
+#define DISPLAY_EVENT_NETWORK       (1 << 3)    // WiFi or IP state changed
+#define DISPLAY_EVENT_REDRAW        (1 << 4)    // Anything else worth a frame
+
 typedef struct {
     float temperature;
     float humidity;
@@ -18,6 +29,12 @@ typedef struct {
     time_t current_time;
 } system_status_t;
 
+typedef enum {
+    DISPLAY_POWER_ACTIVE = 0,
+    DISPLAY_POWER_DIM,
+    DISPLAY_POWER_OFF
+} display_power_state_t;
+
 // Display Manager API
 display_manager_handle_t display_manager_create(ssd1306_handle_t display);
 void display_manager_delete(display_manager_handle_t manager);
@@ -25,6 +42,20 @@ esp_err_t display_manager_set_mode(display_manager_handle_t manager, display_mod
 esp_err_t display_manager_update(display_manager_handle_t manager);
 esp_err_t display_manager_show_startup(display_manager_handle_t manager);
 
+// Event-driven refresh
+uint32_t display_manager_wait_events(display_manager_handle_t manager);
+void display_manager_post_event(display_manager_handle_t manager, uint32_t events);
+void display_manager_post_event_from_isr(display_manager_handle_t manager, uint32_t events, BaseType_t *higher_prio_woken);
+
+// Frame instrumentation
+esp_err_t display_manager_get_frame_stats(display_manager_handle_t manager, frame_stats_summary_t *summary);
+void display_manager_set_overlay(display_manager_handle_t manager, bool enable);
+
+// Power management
+bool display_manager_notify_activity(display_manager_handle_t manager);
+display_power_state_t display_manager_get_power_state(display_manager_handle_t manager);
+void display_manager_adjust_brightness(int delta);
+
 // Status update functions
 void display_manager_update_system_status(system_status_t *status);
 
@@ -0,0 +1,107 @@
+#include <string.h>
+#include "frame_stats.h"
+
+void frame_stats_reset(frame_stats_t *stats)
+{
+    if (stats) {
+        memset(stats, 0, sizeof(frame_stats_t));
+    }
+}
+
+void frame_stats_record(frame_stats_t *stats, const frame_sample_t *sample)
+{
+    if (stats == NULL || sample == NULL) {
+        return;
+    }
+    
+    stats->samples[stats->head] = *sample;
+    stats->head = (stats->head + 1) % FRAME_STATS_DEPTH;
+    if (stats->count < FRAME_STATS_DEPTH) {
+        stats->count++;
+    }
+    
+    stats->total_frames++;
+    if (sample->late) {
+        stats->total_missed++;
+    }
+}
+
+// min/avg/p99/max of n values; sorts them in place. p99 uses the nearest-rank method.
+static void frame_metric(uint16_t *values, uint16_t n, frame_metric_t *metric)
+{
+    memset(metric, 0, sizeof(frame_metric_t));
+    if (n == 0) {
+        return;
+    }
+    
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t value = values[i];
+        uint16_t j = i;
+        for (; j > 0 && values[j - 1] > value; j--) {
+            values[j] = values[j - 1];
+        }
+        values[j] = value;
+        sum += value;
+    }
+    
+    metric->min = values[0];
+    metric->max = values[n - 1];
+    metric->avg = sum / n;
+    metric->p99 = values[(99 * n + 99) / 100 - 1];
+}
+
+void frame_stats_summarize(const frame_stats_t *stats, frame_stats_summary_t *summary)
+{
+    uint16_t values[FRAME_STATS_DEPTH];
+    uint16_t n;
+    
+    if (stats == NULL || summary == NULL) {
+        return;
+    }
+    
+    memset(summary, 0, sizeof(frame_stats_summary_t));
+    summary->frames = stats->count;
+    summary->total_frames = stats->total_frames;
+    summary->total_missed = stats->total_missed;
+    if (stats->count == 0) {
+        return;
+    }
+    
+    // Oldest sample first
+    uint16_t oldest = (stats->head + FRAME_STATS_DEPTH - stats->count) % FRAME_STATS_DEPTH;
+    const frame_sample_t *first = &stats->samples[oldest];
+    const frame_sample_t *last = &stats->samples[(stats->head + FRAME_STATS_DEPTH - 1) % FRAME_STATS_DEPTH];
+    
+    uint32_t span_us = last->start_us - first->start_us;
+    if (span_us > 0) {
+        summary->fps_x100 = (uint64_t)(stats->count - 1) * 100000000ULL / span_us;
+    }
+    
+    for (uint16_t i = 0; i < stats->count; i++) {
+        values[i] = stats->samples[i].render_us;
+        if (stats->samples[i].late) {
+            summary->missed++;
+        }
+    }
+    frame_metric(values, stats->count, &summary->render_us);
+    
+    n = 0;
+    for (uint16_t i = 0; i < stats->count; i++) {
+        if (stats->samples[i].flushed) values[n++] = stats->samples[i].flush_us;
+    }
+    summary->flushes = n;
+    frame_metric(values, n, &summary->flush_us);
+    
+    n = 0;
+    for (uint16_t i = 0; i < stats->count; i++) {
+        if (stats->samples[i].flushed) values[n++] = stats->samples[i].bytes;
+    }
+    frame_metric(values, n, &summary->bytes);
+    
+    n = 0;
+    for (uint16_t i = 0; i < stats->count; i++) {
+        if (stats->samples[i].flushed) values[n++] = stats->samples[i].dirty_columns;
+    }
+    frame_metric(values, n, &summary->dirty_columns);
+}
@@ -0,0 +1,55 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FRAME_STATS_DEPTH           128     // Frames kept for the statistics window
+
+// One rendered frame. Flush figures describe the frame sent before this one
+// and are only valid when flushed is set.
+typedef struct {
+    uint32_t start_us;          // Timestamp of the frame start
+    uint16_t render_us;         // Time spent drawing into the buffer
+    uint16_t flush_us;          // Time the previous frame spent on the bus
+    uint16_t bytes;             // Bytes the previous frame sent
+    uint16_t dirty_columns;     // Page columns the previous frame sent
+    bool flushed;               // A frame was sent since the last sample
+    bool late;                  // Started a whole frame interval after it was due
+} frame_sample_t;
+
+typedef struct {
+    uint16_t min;
+    uint16_t avg;
+    uint16_t p99;
+    uint16_t max;
+} frame_metric_t;
+
+typedef struct {
+    uint16_t frames;                // Frames in the window
+    uint16_t flushes;               // Frames in the window that sent data
+    uint16_t missed;                // Late frames in the window
+    uint32_t fps_x100;              // Frame rate over the window, in 1/100 fps
+    frame_metric_t render_us;
+    frame_metric_t flush_us;        // Over frames that sent data
+    frame_metric_t bytes;           // Over frames that sent data
+    frame_metric_t dirty_columns;   // Over frames that sent data
+    uint32_t total_frames;          // Frames since the last reset
+    uint32_t total_missed;          // Late frames since the last reset
+} frame_stats_summary_t;
+
+// Fixed-size ring of the most recent frames
+typedef struct {
+    frame_sample_t samples[FRAME_STATS_DEPTH];
+    uint16_t head;
+    uint16_t count;
+    uint32_t total_frames;
+    uint32_t total_missed;
+} frame_stats_t;
+
+// Frame statistics API
+void frame_stats_reset(frame_stats_t *stats);
+void frame_stats_record(frame_stats_t *stats, const frame_sample_t *sample);
+void frame_stats_summarize(const frame_stats_t *stats, frame_stats_summary_t *summary);
+
+#endif // FRAME_STATS_H
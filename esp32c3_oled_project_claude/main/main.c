@@ -8,18 +8,18 @@
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_wifi.h"
+#include "esp_event.h"
 #include "esp_sntp.h"
 #include "nvs_flash.h"
-#include "driver/gpio.h"
 #include "driver/i2c_master.h"
 
 #include "app_config.h"
 #include "ssd1306.h"
 #include "display_manager.h"
+#include "input.h"
 #include "menu_system.h"
 #include "sensor_manager.h"
 #include "wifi_manager.h"
-#include "animations.h"
 
 static const char *TAG = "MAIN";
 
@@ -28,19 +28,55 @@ static i2c_master_bus_handle_t i2c_bus_handle;
 static ssd1306_handle_t display_handle;
 static display_manager_handle_t display_manager;
 
+// Buttons, indexed as in input events
+enum { BUTTON_SELECT, BUTTON_UP, BUTTON_DOWN, BUTTON_BACK, BUTTON_COUNT };
+static const input_button_t buttons[BUTTON_COUNT] = {
+    [BUTTON_SELECT] = { .gpio = BUTTON_SELECT_GPIO, .active_low = true },
+    [BUTTON_UP]     = { .gpio = BUTTON_UP_GPIO,     .active_low = true },
+    [BUTTON_DOWN]   = { .gpio = BUTTON_DOWN_GPIO,   .active_low = true },
+    [BUTTON_BACK]   = { .gpio = BUTTON_BACK_GPIO,   .active_low = true },
+};
+
 // Application state
 static display_mode_t current_mode = DISPLAY_MODE_CLOCK;
-static bool button_pressed = false;
-static uint32_t last_button_press = 0;
+static int wake_button = -1;    // Button whose press woke the display, ignored until released
+
+// Runs in the input task; the display task takes the events from the input queue
+static void input_notify(void *arg)
+{
+    display_manager_post_event(display_manager, DISPLAY_EVENT_BUTTON);
+}
 
-// Button interrupt handler
-static void IRAM_ATTR button_isr_handler(void* arg)
+// Publish the latest sensor and WiFi readings for the display task. Called from
+// the sensor task and the event loop task; neither waits for the display.
+static void publish_system_status(void)
 {
-    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    if (now - last_button_press > 200) { // Debounce
-        button_pressed = true;
-        last_button_press = now;
+    system_status_t status = {0};
+    sensor_data_t sensors;
+    wifi_status_t wifi;
+    
+    if (sensor_manager_get_data(&sensors) == ESP_OK && sensors.data_valid) {
+        status.temperature = sensors.temperature;
+        status.humidity = sensors.humidity;
     }
+    
+    if (wifi_manager_get_status(&wifi) == ESP_OK && wifi.state == WIFI_STATE_CONNECTED) {
+        status.wifi_connected = true;
+        strncpy(status.wifi_ssid, wifi.ssid, sizeof(status.wifi_ssid) - 1);
+        status.wifi_rssi = wifi.rssi;
+        snprintf(status.ip_address, sizeof(status.ip_address), "%u.%u.%u.%u",
+                 wifi.ip_address[0], wifi.ip_address[1], wifi.ip_address[2], wifi.ip_address[3]);
+    }
+    
+    display_manager_update_system_status(&status);
+}
+
+// WiFi and IP events only need to tell the display that network info changed
+static void network_event_handler(void* arg, esp_event_base_t event_base,
+                                  int32_t event_id, void* event_data)
+{
+    publish_system_status();
+    display_manager_post_event(display_manager, DISPLAY_EVENT_NETWORK);
 }
 
 static esp_err_t init_hardware(void)
@@ -76,17 +112,26 @@ static esp_err_t init_hardware(void)
         return ret;
     }
     
-    // Initialize button
-    gpio_config_t button_config = {
-        .pin_bit_mask = (1ULL << BUTTON_GPIO),
-        .mode = GPIO_MODE_INPUT,
-        .pull_up_en = GPIO_PULLUP_ENABLE,
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_NEGEDGE,
+    ret = ssd1306_enable_async(display_handle, DISPLAY_FLUSH_TASK_PRIORITY);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Asynchronous refresh unavailable, using blocking refresh");
+    }
+    
+    // Initialize buttons
+    const input_config_t input_config = {
+        .buttons = buttons,
+        .button_count = BUTTON_COUNT,
+        .debounce_ms = INPUT_DEBOUNCE_MS,
+        .long_press_ms = INPUT_LONG_PRESS_MS,
+        .repeat_ms = INPUT_REPEAT_MS,
+        .task_priority = INPUT_TASK_PRIORITY,
+        .notify = input_notify,
     };
-    gpio_config(&button_config);
-    gpio_install_isr_service(0);
-    gpio_isr_handler_add(BUTTON_GPIO, button_isr_handler, NULL);
+    ret = input_init(&input_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize buttons: %s", esp_err_to_name(ret));
+        return ret;
+    }
     
     ESP_LOGI(TAG, "Hardware initialization completed");
     return ESP_OK;
@@ -104,28 +149,89 @@ static void init_time_sync(void)
     tzset();
 }
 
-static void handle_button_press(void)
+static void set_display_mode(display_mode_t mode)
 {
-    if (button_pressed) {
-        button_pressed = false;
-        
-        // Cycle through display modes
-        current_mode = (current_mode + 1) % DISPLAY_MODE_MAX;
-        display_manager_set_mode(display_manager, current_mode);
-        
-        ESP_LOGI(TAG, "Display mode changed to: %d", current_mode);
+    current_mode = mode;
+    display_manager_set_mode(display_manager, current_mode);
+    
+    ESP_LOGI(TAG, "Display mode changed to: %d", current_mode);
+}
+
+static void handle_menu_input(const input_event_t *event)
+{
+    bool step = event->type == INPUT_EVENT_PRESS || event->type == INPUT_EVENT_REPEAT;
+    
+    switch (event->button) {
+        case BUTTON_UP:
+            if (step) menu_system_navigate_up();
+            break;
+        case BUTTON_DOWN:
+            if (step) menu_system_navigate_down();
+            break;
+        case BUTTON_SELECT:
+            if (event->type == INPUT_EVENT_PRESS) menu_system_select();
+            break;
+        case BUTTON_BACK:
+            // Back climbs one level; at the main menu, or when held, it leaves the menu
+            if (event->type == INPUT_EVENT_PRESS && menu_system_depth() > 1) {
+                menu_system_back();
+            } else if (event->type == INPUT_EVENT_PRESS || event->type == INPUT_EVENT_LONG_PRESS) {
+                set_display_mode(DISPLAY_MODE_CLOCK);
+            }
+            break;
     }
 }
 
-static void display_task(void *pvParameters)
+static void handle_input_event(const input_event_t *event)
 {
-    TickType_t last_wake_time = xTaskGetTickCount();
+    // A press that wakes the display only wakes it, up to its release
+    if (event->button == wake_button) {
+        if (event->type == INPUT_EVENT_RELEASE) {
+            wake_button = -1;
+        }
+        return;
+    }
+    if (display_manager_notify_activity(display_manager) && event->type == INPUT_EVENT_PRESS) {
+        wake_button = event->button;
+        return;
+    }
     
+    if (current_mode == DISPLAY_MODE_MENU) {
+        handle_menu_input(event);
+        return;
+    }
+    
+    // Select and down cycle through display modes, up goes back, back returns to the clock
+    if (event->type != INPUT_EVENT_PRESS) {
+        return;
+    }
+    switch (event->button) {
+        case BUTTON_UP:
+            set_display_mode((current_mode + DISPLAY_MODE_MAX - 1) % DISPLAY_MODE_MAX);
+            break;
+        case BUTTON_BACK:
+            set_display_mode(DISPLAY_MODE_CLOCK);
+            break;
+        default:
+            set_display_mode((current_mode + 1) % DISPLAY_MODE_MAX);
+            break;
+    }
+}
+
+static void display_task(void *pvParameters)
+{
+    // Render only when something changed, an animation frame is due or the
+    // idle policy has to act; an idle node leaves the task blocked
     while (1) {
-        handle_button_press();
         display_manager_update(display_manager);
         
-        vTaskDelayUntil(&last_wake_time, pdMS_TO_TICKS(DISPLAY_UPDATE_INTERVAL_MS));
+        uint32_t events = display_manager_wait_events(display_manager);
+        if (events & DISPLAY_EVENT_BUTTON) {
+            input_event_t event;
+            while (input_get_event(&event, 0) == ESP_OK) {
+                handle_input_event(&event);
+            }
+        }
     }
 }
 
@@ -134,7 +240,10 @@ static void sensor_task(void *pvParameters)
     TickType_t last_wake_time = xTaskGetTickCount();
     
     while (1) {
-        sensor_manager_update();
+        if (sensor_manager_update() == ESP_OK) {
+            publish_system_status();
+            display_manager_post_event(display_manager, DISPLAY_EVENT_SENSOR);
+        }
         vTaskDelayUntil(&last_wake_time, pdMS_TO_TICKS(SENSOR_READ_INTERVAL_MS));
     }
 }
@@ -163,7 +272,6 @@ void app_main(void)
     
     sensor_manager_init();
     menu_system_init();
-    animations_init();
     
     // Show startup screen
     display_manager_show_startup(display_manager);
@@ -171,6 +279,8 @@ void app_main(void)
     
     // Initialize WiFi (non-blocking)
     wifi_manager_init();
+    esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, network_event_handler, NULL);
+    esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, network_event_handler, NULL);
     
     // Initialize time sync after WiFi
     init_time_sync();
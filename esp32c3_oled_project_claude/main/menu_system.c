@@ -2,19 +2,26 @@
 #include <string.h>
 #include <inttypes.h>
 #include "menu_system.h"
+#include "display_manager.h"
+#include "wifi_manager.h"
 #include "esp_log.h"
 #include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_wifi.h"
 #include "nvs_flash.h"
 #include "nvs.h"
 
 static const char *TAG = "MENU";
 
-static menu_type_t current_menu = MENU_MAIN;
-static int current_selection = 0;
-static int scroll_offset = 0;
-static bool menu_active = false;
-static const int ITEMS_PER_PAGE = 4;
+// Layout: title row with an underline, then MENU_ROWS item rows in the 6x8 font
+#define MENU_ROWS           4
+#define MENU_ROW_Y          16
+#define MENU_ROW_HEIGHT     12
+#define MENU_TEXT_X         2
+#define MENU_BAR_WIDTH      120     // Selection bar; the scroll marks sit right of it
+#define MENU_MARK_X         122
+#define MENU_HINT_X         84      // Position hint, right-aligned in the title row
 
 // Menu action functions
 static void action_brightness_up(void);
@@ -25,171 +32,325 @@ static void action_system_info(void);
 static void action_factory_reset(void);
 static void action_reboot(void);
 
-// Menu definitions
-static const menu_item_t main_menu[] = {
-    {"Display Settings", NULL, MENU_DISPLAY, true},
-    {"Network Settings", NULL, MENU_NETWORK, true},
-    {"System Settings", NULL, MENU_SYSTEM, true},
-    {"About", NULL, MENU_ABOUT, true},
+// Dynamic entries
+static void wifi_results_refresh(void);
+static uint8_t wifi_results_count(void);
+static void wifi_results_label(uint8_t index, char *buf, size_t len);
+
+// Menu definitions, leaves first
+static const menu_item_t display_items[] = {
+    {"Brightness +", action_brightness_up, NULL},
+    {"Brightness -", action_brightness_down, NULL},
+    {"< Back", menu_system_back, NULL},
 };
 
-static const menu_item_t display_menu[] = {
-    {"Brightness +", action_brightness_up, 0, false},
-    {"Brightness -", action_brightness_down, 0, false},
-    {"< Back", NULL, MENU_MAIN, true},
+static const menu_t display_menu = {
+    .title = "Display",
+    .items = display_items,
+    .item_count = sizeof(display_items) / sizeof(menu_item_t),
 };
 
-static const menu_item_t network_menu[] = {
-    {"WiFi Scan", action_wifi_scan, 0, false},
-    {"Disconnect WiFi", action_wifi_disconnect, 0, false},
-    {"< Back", NULL, MENU_MAIN, true},
+// Scan results come first, followed by the static items
+static const menu_item_t wifi_results_items[] = {
+    {"Rescan", action_wifi_scan, NULL},
+    {"< Back", menu_system_back, NULL},
 };
 
-static const menu_item_t system_menu[] = {
-    {"System Info", action_system_info, 0, false},
-    {"Factory Reset", action_factory_reset, 0, false},
-    {"Reboot", action_reboot, 0, false},
-    {"< Back", NULL, MENU_MAIN, true},
+static const menu_t wifi_results_menu = {
+    .title = "Networks",
+    .items = wifi_results_items,
+    .item_count = sizeof(wifi_results_items) / sizeof(menu_item_t),
+    .refresh = wifi_results_refresh,
+    .count = wifi_results_count,
+    .label = wifi_results_label,
 };
 
-static const menu_item_t about_menu[] = {
-    {"ESP32-C3 OLED", NULL, 0, false},
-    {"Version: " APP_VERSION, NULL, 0, false},
-    {"By: Your Name", NULL, 0, false},
-    {"< Back", NULL, MENU_MAIN, true},
+static const menu_item_t network_items[] = {
+    {"WiFi Scan", action_wifi_scan, &wifi_results_menu},
+    {"Disconnect WiFi", action_wifi_disconnect, NULL},
+    {"< Back", menu_system_back, NULL},
 };
 
-// Menu structure
-typedef struct {
-    const menu_item_t *items;
-    int item_count;
-} menu_definition_t;
-
-static const menu_definition_t menus[MENU_MAX] = {
-    {main_menu, sizeof(main_menu) / sizeof(menu_item_t)},
-    {NULL, 0}, // MENU_SETTINGS - unused
-    {display_menu, sizeof(display_menu) / sizeof(menu_item_t)},
-    {network_menu, sizeof(network_menu) / sizeof(menu_item_t)},
-    {system_menu, sizeof(system_menu) / sizeof(menu_item_t)},
-    {about_menu, sizeof(about_menu) / sizeof(menu_item_t)},
+static const menu_t network_menu = {
+    .title = "Network",
+    .items = network_items,
+    .item_count = sizeof(network_items) / sizeof(menu_item_t),
+};
+
+static const menu_item_t reset_items[] = {
+    {"Cancel", menu_system_back, NULL},
+    {"Erase and reboot", action_factory_reset, NULL},
+};
+
+static const menu_t reset_menu = {
+    .title = "Reset?",
+    .items = reset_items,
+    .item_count = sizeof(reset_items) / sizeof(menu_item_t),
+};
+
+static const menu_item_t system_items[] = {
+    {"System Info", action_system_info, NULL},
+    {"Factory Reset", NULL, &reset_menu},
+    {"Reboot", action_reboot, NULL},
+    {"< Back", menu_system_back, NULL},
+};
+
+static const menu_t system_menu = {
+    .title = "System",
+    .items = system_items,
+    .item_count = sizeof(system_items) / sizeof(menu_item_t),
+};
+
+static const menu_item_t about_items[] = {
+    {"ESP32-C3 OLED", NULL, NULL},
+    {"Version: " APP_VERSION, NULL, NULL},
+    {"By: Your Name", NULL, NULL},
+    {"< Back", menu_system_back, NULL},
 };
 
+static const menu_t about_menu = {
+    .title = "About",
+    .items = about_items,
+    .item_count = sizeof(about_items) / sizeof(menu_item_t),
+};
+
+static const menu_item_t main_items[] = {
+    {"Display Settings", NULL, &display_menu},
+    {"Network Settings", NULL, &network_menu},
+    {"System Settings", NULL, &system_menu},
+    {"About", NULL, &about_menu},
+};
+
+static const menu_t main_menu = {
+    .title = "Main Menu",
+    .items = main_items,
+    .item_count = sizeof(main_items) / sizeof(menu_item_t),
+};
+
+// Navigation stack; the top entry is the menu on screen
+typedef struct {
+    const menu_t *menu;
+    uint8_t selection;
+    uint8_t scroll;             // First visible item
+} menu_frame_t;
+
+static menu_frame_t stack[MENU_STACK_DEPTH];
+static int depth = 0;
+static bool menu_active = false;
+
+// What is on screen, so a frame only redraws the regions that differ
+#define ROW_SELECTED        (1 << 0)
+#define ROW_MORE_ABOVE      (1 << 1)
+#define ROW_MORE_BELOW      (1 << 2)
+#define ROW_INFO            (1 << 3)    // Dynamic entry without select(); nothing happens on select
+
+typedef struct {
+    char label[MENU_LABEL_MAX];
+    uint8_t flags;
+} menu_row_t;
+
+static menu_row_t shown_rows[MENU_ROWS];
+static const char *shown_title;
+static char shown_hint[8];
+static bool shown_valid = false;
+
+static menu_frame_t *menu_top(void)
+{
+    return (menu_active && depth > 0) ? &stack[depth - 1] : NULL;
+}
+
+static uint8_t menu_dynamic_count(const menu_t *menu)
+{
+    return menu->count ? menu->count() : 0;
+}
+
+// Keep the selection on an existing item and visible
+static void menu_clamp(menu_frame_t *frame, int total)
+{
+    if (frame->selection >= total) {
+        frame->selection = total > 0 ? total - 1 : 0;
+    }
+    if (frame->selection < frame->scroll) {
+        frame->scroll = frame->selection;
+    }
+    if (frame->selection >= frame->scroll + MENU_ROWS) {
+        frame->scroll = frame->selection - MENU_ROWS + 1;
+    }
+    if (frame->scroll > 0 && frame->scroll + MENU_ROWS > total) {
+        frame->scroll = total > MENU_ROWS ? total - MENU_ROWS : 0;
+    }
+}
+
+static void menu_get_label(const menu_t *menu, int index, uint8_t dynamic, char *buf, size_t len)
+{
+    if (index < dynamic) {
+        buf[0] = '\0';
+        menu->label(index, buf, len);
+    } else {
+        snprintf(buf, len, "%s", menu->items[index - dynamic].label);
+    }
+}
+
+// Draw text up to max_x, cut at a glyph boundary rather than wrapped
+static void menu_draw_text(ssd1306_handle_t display, uint8_t x, uint8_t y, const char *text,
+                           const ssd1306_font_t *font, uint8_t max_x)
+{
+    char glyph[2] = {0};
+    
+    for (; *text != '\0'; text++) {
+        glyph[0] = *text;
+        if (x + ssd1306_text_width(font, glyph) > max_x) {
+            break;
+        }
+        x += ssd1306_draw_glyph(display, x, y, *text, font, 1);
+    }
+}
+
+static void menu_draw_row(ssd1306_handle_t display, int row, const menu_row_t *content)
+{
+    uint8_t y = MENU_ROW_Y + row * MENU_ROW_HEIGHT;
+    
+    ssd1306_fill_rect(display, 0, y, SSD1306_WIDTH, MENU_ROW_HEIGHT, 0);
+    menu_draw_text(display, MENU_TEXT_X, y + 2, content->label, &ssd1306_font_6x8, MENU_BAR_WIDTH);
+    
+    if (content->flags & ROW_MORE_ABOVE) {
+        ssd1306_draw_glyph(display, MENU_MARK_X, y + 2, '^', &ssd1306_font_6x8, 1);
+    }
+    if (content->flags & ROW_MORE_BELOW) {
+        ssd1306_draw_glyph(display, MENU_MARK_X, y + 2, 'v', &ssd1306_font_6x8, 1);
+    }
+    // Information rows get an outline, so the cursor does not suggest an action
+    if ((content->flags & (ROW_SELECTED | ROW_INFO)) == (ROW_SELECTED | ROW_INFO)) {
+        ssd1306_draw_rectangle(display, 0, y, MENU_BAR_WIDTH - 1, MENU_ROW_HEIGHT - 1, 1);
+    } else if (content->flags & ROW_SELECTED) {
+        ssd1306_invert_rect(display, 0, y, MENU_BAR_WIDTH, MENU_ROW_HEIGHT);
+    }
+}
+
 esp_err_t menu_system_init(void)
 {
-    current_menu = MENU_MAIN;
-    current_selection = 0;
-    scroll_offset = 0;
+    depth = 0;
     menu_active = false;
+    shown_valid = false;
     
     ESP_LOGI(TAG, "Menu system initialized");
     return ESP_OK;
 }
 
-void menu_system_display(ssd1306_handle_t display)
+int menu_system_display(ssd1306_handle_t display, bool cleared)
 {
-    if (!menu_active || current_menu >= MENU_MAX) {
-        ssd1306_show_string(display, 20, 28, "Menu Inactive", 16, 1);
-        return;
+    if (cleared) {
+        shown_valid = false;
     }
     
-    const menu_definition_t *menu = &menus[current_menu];
-    if (menu->items == NULL) {
-        ssd1306_show_string(display, 20, 28, "Invalid Menu", 16, 1);
-        return;
+    menu_frame_t *frame = menu_top();
+    if (frame == NULL) {
+        if (cleared) {
+            ssd1306_show_string(display, 20, 28, "Menu Inactive", 16, 1);
+            return 1;
+        }
+        return 0;
     }
     
-    // Display menu title based on current menu
-    const char *title = "Main Menu";
-    switch (current_menu) {
-        case MENU_MAIN: title = "Main Menu"; break;
-        case MENU_DISPLAY: title = "Display"; break;
-        case MENU_NETWORK: title = "Network"; break;
-        case MENU_SYSTEM: title = "System"; break;
-        case MENU_ABOUT: title = "About"; break;
-        default: title = "Menu"; break;
+    // Dynamic entries may have come or gone since the last frame
+    const menu_t *menu = frame->menu;
+    if (menu->refresh) {
+        menu->refresh();
     }
+    uint8_t dynamic = menu_dynamic_count(menu);
+    int total = dynamic + menu->item_count;
+    menu_clamp(frame, total);
     
-    // Draw title with underline
-    ssd1306_show_string(display, 0, 0, title, 16, 1);
-    ssd1306_draw_line(display, 0, 15, 127, 15, 1);
+    bool all = !shown_valid;
+    int drawn = 0;
     
-    // Display menu items
-    for (int i = 0; i < ITEMS_PER_PAGE && (i + scroll_offset) < menu->item_count; i++) {
-        int item_index = i + scroll_offset;
-        int y_pos = 18 + i * 12;
-        
-        // Highlight selected item
-        if (item_index == current_selection) {
-            // Draw selection rectangle
-            ssd1306_draw_rectangle(display, 0, y_pos - 1, 127, 10, 1);
-            // Invert text by drawing black text on white background
-            for (int x = 1; x < 126; x++) {
-                for (int y = y_pos; y < y_pos + 8; y++) {
-                    ssd1306_draw_point(display, x, y, 1);
-                }
-            }
-            ssd1306_show_string(display, 2, y_pos, menu->items[item_index].title, 16, 0);
-        } else {
-            ssd1306_show_string(display, 2, y_pos, menu->items[item_index].title, 16, 1);
-        }
+    if (all) {
+        ssd1306_draw_hline(display, 0, MENU_ROW_Y - 1, SSD1306_WIDTH, 1);
+    }
+    
+    if (all || shown_title != menu->title) {
+        ssd1306_fill_rect(display, 0, 0, MENU_HINT_X, MENU_ROW_Y - 1, 0);
+        menu_draw_text(display, 0, 0, menu->title, &ssd1306_font_8x16, MENU_HINT_X);
+        shown_title = menu->title;
+        drawn++;
     }
     
-    // Draw scroll indicators
-    if (scroll_offset > 0) {
-        ssd1306_show_string(display, 118, 18, "^", 16, 1);
+    char hint[sizeof(shown_hint)];
+    snprintf(hint, sizeof(hint), "%d/%d", frame->selection + 1, total);
+    if (all || strcmp(hint, shown_hint) != 0) {
+        uint8_t width = ssd1306_text_width(&ssd1306_font_6x8, hint);
+        ssd1306_fill_rect(display, MENU_HINT_X, 0, SSD1306_WIDTH - MENU_HINT_X, MENU_ROW_Y - 1, 0);
+        menu_draw_text(display, SSD1306_WIDTH - width, 4, hint, &ssd1306_font_6x8, SSD1306_WIDTH);
+        strcpy(shown_hint, hint);
+        drawn++;
     }
-    if (scroll_offset + ITEMS_PER_PAGE < menu->item_count) {
-        ssd1306_show_string(display, 118, 54, "v", 16, 1);
+    
+    // Up and down change the selection flag of two rows; scrolling or another
+    // menu changes the labels of all of them
+    for (int row = 0; row < MENU_ROWS; row++) {
+        int index = frame->scroll + row;
+        menu_row_t want = {0};
+        
+        if (index < total) {
+            menu_get_label(menu, index, dynamic, want.label, sizeof(want.label));
+            if (index == frame->selection) want.flags |= ROW_SELECTED;
+            if (index < dynamic && menu->select == NULL) want.flags |= ROW_INFO;
+            if (row == 0 && frame->scroll > 0) want.flags |= ROW_MORE_ABOVE;
+            if (row == MENU_ROWS - 1 && index + 1 < total) want.flags |= ROW_MORE_BELOW;
+        }
+        
+        menu_row_t *shown = &shown_rows[row];
+        if (all || want.flags != shown->flags || strcmp(want.label, shown->label) != 0) {
+            menu_draw_row(display, row, &want);
+            *shown = want;
+            drawn++;
+        }
     }
     
-    // Draw navigation hint
-    char nav_hint[32];
-    snprintf(nav_hint, sizeof(nav_hint), "%d/%d", current_selection + 1, menu->item_count);
-    ssd1306_show_string(display, 90, 0, nav_hint, 16, 1);
+    shown_valid = true;
+    return drawn;
 }
 
 void menu_system_navigate_up(void)
 {
-    if (!menu_active) return;
-    
-    const menu_definition_t *menu = &menus[current_menu];
-    if (menu->items == NULL) return;
+    menu_frame_t *frame = menu_top();
+    if (frame == NULL) return;
     
-    if (current_selection > 0) {
-        current_selection--;
-        
-        // Adjust scroll offset
-        if (current_selection < scroll_offset) {
-            scroll_offset = current_selection;
-        }
+    if (frame->selection > 0) {
+        frame->selection--;
+        menu_clamp(frame, menu_dynamic_count(frame->menu) + frame->menu->item_count);
     }
 }
 
 void menu_system_navigate_down(void)
 {
-    if (!menu_active) return;
-    
-    const menu_definition_t *menu = &menus[current_menu];
-    if (menu->items == NULL) return;
+    menu_frame_t *frame = menu_top();
+    if (frame == NULL) return;
     
-    if (current_selection < menu->item_count - 1) {
-        current_selection++;
-        
-        // Adjust scroll offset
-        if (current_selection >= scroll_offset + ITEMS_PER_PAGE) {
-            scroll_offset = current_selection - ITEMS_PER_PAGE + 1;
-        }
+    int total = menu_dynamic_count(frame->menu) + frame->menu->item_count;
+    if (frame->selection + 1 < total) {
+        frame->selection++;
+        menu_clamp(frame, total);
     }
 }
 
 void menu_system_select(void)
 {
-    if (!menu_active) return;
+    menu_frame_t *frame = menu_top();
+    if (frame == NULL) return;
     
-    const menu_definition_t *menu = &menus[current_menu];
-    if (menu->items == NULL || current_selection >= menu->item_count) return;
+    const menu_t *menu = frame->menu;
+    uint8_t dynamic = menu_dynamic_count(menu);
     
-    const menu_item_t *item = &menu->items[current_selection];
+    if (frame->selection < dynamic) {
+        if (menu->select) {
+            menu->select(frame->selection);
+        }
+        return;
+    }
+    if (frame->selection >= dynamic + menu->item_count) return;
+    
+    const menu_item_t *item = &menu->items[frame->selection - dynamic];
     
     // Execute action if available
     if (item->action) {
@@ -197,22 +358,36 @@ void menu_system_select(void)
     }
     
     // Navigate to submenu if available
-    if (item->has_submenu) {
-        current_menu = item->submenu;
-        current_selection = 0;
-        scroll_offset = 0;
+    if (item->submenu) {
+        menu_system_push(item->submenu);
     }
 }
 
 void menu_system_back(void)
 {
-    if (!menu_active) return;
+    // The parent keeps its selection and scroll position; the main menu stays open
+    if (menu_top() && depth > 1) {
+        depth--;
+    }
+}
+
+esp_err_t menu_system_push(const menu_t *menu)
+{
+    if (menu == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (menu_top() == NULL || depth >= MENU_STACK_DEPTH) {
+        ESP_LOGW(TAG, "Cannot open %s", menu->title);
+        return ESP_ERR_INVALID_STATE;
+    }
     
-    // Always go back to main menu for simplicity
-    // In a more complex system, you'd maintain a navigation stack
-    current_menu = MENU_MAIN;
-    current_selection = 0;
-    scroll_offset = 0;
+    stack[depth++] = (menu_frame_t){ .menu = menu };
+    return ESP_OK;
+}
+
+int menu_system_depth(void)
+{
+    return menu_active ? depth : 0;
 }
 
 bool menu_system_is_active(void)
@@ -224,9 +399,31 @@ void menu_system_activate(bool active)
 {
     menu_active = active;
     if (active) {
-        current_menu = MENU_MAIN;
-        current_selection = 0;
-        scroll_offset = 0;
+        stack[0] = (menu_frame_t){ .menu = &main_menu };
+        depth = 1;
+        shown_valid = false;
+    }
+}
+
+// Dynamic entries: the results of the last WiFi scan, copied once per frame
+static wifi_status_t wifi_results;
+
+static void wifi_results_refresh(void)
+{
+    if (wifi_manager_get_status(&wifi_results) != ESP_OK) {
+        wifi_results.scan_count = 0;
+    }
+}
+
+static uint8_t wifi_results_count(void)
+{
+    return wifi_results.scan_count;
+}
+
+static void wifi_results_label(uint8_t index, char *buf, size_t len)
+{
+    if (index < wifi_results.scan_count) {
+        snprintf(buf, len, "%-13.13s%4d", wifi_results.scan_results[index].ssid, wifi_results.scan_results[index].rssi);
     }
 }
 
@@ -234,27 +431,26 @@ void menu_system_activate(bool active)
 static void action_brightness_up(void)
 {
     ESP_LOGI(TAG, "Brightness up action");
-    // In a real implementation, you would adjust display brightness
-    // For SSD1306, you can change contrast
+    display_manager_adjust_brightness(DISPLAY_CONTRAST_STEP);
 }
 
 static void action_brightness_down(void)
 {
     ESP_LOGI(TAG, "Brightness down action");
-    // Adjust brightness/contrast down
+    display_manager_adjust_brightness(-DISPLAY_CONTRAST_STEP);
 }
 
 static void action_wifi_scan(void)
 {
     ESP_LOGI(TAG, "WiFi scan action");
-    // Trigger WiFi scan
-    esp_wifi_scan_start(NULL, false);
+    // Results show up in the Networks menu when the scan completes
+    wifi_manager_scan();
 }
 
 static void action_wifi_disconnect(void)
 {
     ESP_LOGI(TAG, "WiFi disconnect action");
-    esp_wifi_disconnect();
+    wifi_manager_disconnect();
 }
 
 static void action_system_info(void)
@@ -271,13 +467,12 @@ static void action_system_info(void)
     uint32_t seconds = uptime_sec % 60;
     
     ESP_LOGI(TAG, "Uptime: %02d:%02d:%02d", hours, minutes, seconds);
-    ESP_LOGI(TAG, "Tasks running: %d", uxTaskGetNumberOfTasks());
+    ESP_LOGI(TAG, "Tasks running: %u", (unsigned)uxTaskGetNumberOfTasks());
 }
 
 static void action_factory_reset(void)
 {
-    ESP_LOGW(TAG, "Factory reset requested");
-    // In a real implementation, you'd show a confirmation dialog
+    ESP_LOGW(TAG, "Factory reset confirmed");
     nvs_flash_erase();
     esp_restart();
 }
@@ -1,33 +1,71 @@
 #ifndef MENU_SYSTEM_H
 #define MENU_SYSTEM_H
 
+#include <stddef.h>
 #include "ssd1306.h"
 #include "app_config.h"
 
-typedef enum {
-    MENU_MAIN = 0,
-    MENU_SETTINGS,
-    MENU_DISPLAY,
-    MENU_NETWORK,
-    MENU_SYSTEM,
-    MENU_ABOUT,
-    MENU_MAX
-} menu_type_t;
+#define MENU_STACK_DEPTH    8       // Deepest nesting of open menus
+#define MENU_LABEL_MAX      24      // Dynamic item label buffer, including the terminator
+
+typedef struct menu menu_t;
 
 typedef struct {
-    char title[32];
-    void (*action)(void);
-    menu_type_t submenu;
-    bool has_submenu;
+    const char *label;
+    void (*action)(void);           // Run on select; may be menu_system_back
+    const menu_t *submenu;          // Opened on select, after the action
 } menu_item_t;
 
+/**
+ * @brief Menu definition
+ *
+ * Menus are constant tables linked through menu_item_t::submenu. A dynamic
+ * menu also lists count() entries produced on demand, e.g. scan results,
+ * ahead of its static items; they are re-read every time the menu is drawn,
+ * so changes show up without any notification. refresh() runs once at the
+ * start of each drawn frame so count(), label() and select() can all index
+ * one copy of the source data instead of fetching it per call. Without
+ * select() the dynamic entries are information only: the cursor still moves
+ * over them so they can scroll into view, but it is drawn as an outline
+ * instead of a bar and selecting them does nothing.
+ */
+struct menu {
+    const char *title;
+    const menu_item_t *items;
+    uint8_t item_count;
+    void (*refresh)(void);                                  // Copy the dynamic source once per frame, may be NULL
+    uint8_t (*count)(void);                                 // Dynamic entries, NULL if none
+    void (*label)(uint8_t index, char *buf, size_t len);    // Text of dynamic entry index
+    void (*select)(uint8_t index);                          // Dynamic entry chosen, NULL for information only
+};
+
 // Menu System API
 esp_err_t menu_system_init(void);
-void menu_system_display(ssd1306_handle_t display);
+
+/**
+ * @brief Draw the menu, redrawing only the rows that changed since the last call
+ *
+ * Moving the selection redraws the two rows it moves between and the position
+ * hint; entering another menu or scrolling redraws every row.
+ * @param display Display to draw on
+ * @param cleared true if the screen was cleared since the last call
+ * @return Number of regions (title, hint, rows) redrawn
+ */
+int menu_system_display(ssd1306_handle_t display, bool cleared);
+
 void menu_system_navigate_up(void);
 void menu_system_navigate_down(void);
 void menu_system_select(void);
-void menu_system_back(void);
+void menu_system_back(void);        // Return to the parent menu and its selection
+
+/**
+ * @brief Open a menu on top of the current one
+ * @param menu Menu to open
+ * @return ESP_OK, ESP_ERR_INVALID_STATE if MENU_STACK_DEPTH menus are already open
+ */
+esp_err_t menu_system_push(const menu_t *menu);
+
+int menu_system_depth(void);        // Open menus, 1 at the main menu, 0 while inactive
 bool menu_system_is_active(void);
 void menu_system_activate(bool active);
 
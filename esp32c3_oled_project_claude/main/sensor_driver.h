@@ -0,0 +1,54 @@
+#ifndef SENSOR_DRIVER_H
+#define SENSOR_DRIVER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum {
+    SENSOR_TEMPERATURE = 0,     // Celsius
+    SENSOR_HUMIDITY,            // Relative humidity %
+    SENSOR_PRESSURE,            // hPa
+    SENSOR_LIGHT,               // 0-1000
+    SENSOR_QUANTITY_MAX
+} sensor_quantity_t;
+
+/**
+ * @brief Operations of a sensor driver
+ *
+ * A reading is split into three steps so that the sensor manager can start
+ * every conversion before waiting for any of them: the conversions overlap
+ * and one update takes as long as the slowest sensor, not the sum of all.
+ * None of the operations may block for the length of a conversion.
+ */
+typedef struct {
+    /**
+     * @brief Begin a conversion
+     * @param ctx Driver context
+     * @param conversion_us Set to the expected time until the result is ready
+     */
+    esp_err_t (*start)(void *ctx, uint32_t *conversion_us);
+    
+    /**
+     * @brief Check whether the conversion has finished
+     * @param ctx Driver context
+     * @param ready Set to true once fetch() has a result
+     */
+    esp_err_t (*poll)(void *ctx, bool *ready);
+    
+    /**
+     * @brief Read the result of a finished conversion
+     * @param ctx Driver context
+     * @param value Reading in the units of the quantity
+     */
+    esp_err_t (*fetch)(void *ctx, float *value);
+} sensor_driver_ops_t;
+
+typedef struct {
+    const char *name;
+    sensor_quantity_t quantity;
+    const sensor_driver_ops_t *ops;
+    void *ctx;
+} sensor_driver_t;
+
+#endif // SENSOR_DRIVER_H
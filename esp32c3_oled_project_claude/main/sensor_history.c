@@ -0,0 +1,299 @@
+#include <math.h>
+#include <string.h>
+#include "sensor_history.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#define ROLLUP_TIERS    2       // Tiers of buckets, after the raw tier
+
+// Readings that fall into one bucket; sum and count keep roll-ups exact
+typedef struct {
+    int32_t sum;
+    int16_t min;
+    int16_t max;
+    uint16_t count;
+} rollup_t;
+
+typedef struct {
+    sensor_bucket_t *entries;
+    uint16_t len;
+    uint16_t period_s;
+    uint16_t head;              // Next slot to write
+    uint16_t count;             // Closed buckets held
+    bool open;                  // acc holds the bucket being filled
+    uint32_t index;             // time_s / period_s of the open bucket
+    rollup_t acc;
+} tier_t;
+
+typedef struct {
+    int16_t raw[SENSOR_HISTORY_RAW_LEN];
+    uint16_t raw_head;
+    uint16_t raw_count;
+    uint32_t raw_total;         // Readings ever recorded
+    sensor_bucket_t minute[SENSOR_HISTORY_MINUTE_LEN];
+    sensor_bucket_t quarter[SENSOR_HISTORY_QUARTER_LEN];
+    tier_t tiers[ROLLUP_TIERS];
+} channel_t;
+
+// Fixed-point scale per quantity: 0.01 °C, 0.01 %, 0.1 hPa, 1 light unit
+static const float scales[SENSOR_QUANTITY_MAX] = {
+    [SENSOR_TEMPERATURE] = 100.0f,
+    [SENSOR_HUMIDITY]    = 100.0f,
+    [SENSOR_PRESSURE]    = 10.0f,
+    [SENSOR_LIGHT]       = 1.0f,
+};
+
+static const sensor_bucket_t no_data = {
+    SENSOR_HISTORY_NO_DATA, SENSOR_HISTORY_NO_DATA, SENSOR_HISTORY_NO_DATA
+};
+
+static channel_t s_channels[SENSOR_QUANTITY_MAX];
+static SemaphoreHandle_t s_lock;    // Sensor task writes, display task reads
+
+esp_err_t sensor_history_init(void)
+{
+    if (s_lock == NULL) {
+        s_lock = xSemaphoreCreateMutex();
+        if (s_lock == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    memset(s_channels, 0, sizeof(s_channels));
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        channel_t *ch = &s_channels[i];
+        
+        ch->tiers[0].entries = ch->minute;
+        ch->tiers[0].len = SENSOR_HISTORY_MINUTE_LEN;
+        ch->tiers[0].period_s = 60;
+        ch->tiers[1].entries = ch->quarter;
+        ch->tiers[1].len = SENSOR_HISTORY_QUARTER_LEN;
+        ch->tiers[1].period_s = 15 * 60;
+    }
+    xSemaphoreGive(s_lock);
+    return ESP_OK;
+}
+
+int16_t sensor_history_from_float(sensor_quantity_t quantity, float value)
+{
+    if (isnan(value)) {
+        return SENSOR_HISTORY_NO_DATA;
+    }
+    
+    float scaled = roundf(value * scales[quantity]);
+    if (scaled > INT16_MAX) return INT16_MAX;
+    if (scaled < INT16_MIN + 1) return INT16_MIN + 1;
+    return (int16_t)scaled;
+}
+
+float sensor_history_to_float(sensor_quantity_t quantity, int16_t value)
+{
+    if (value == SENSOR_HISTORY_NO_DATA) {
+        return NAN;
+    }
+    return value / scales[quantity];
+}
+
+static sensor_bucket_t rollup_bucket(const rollup_t *acc)
+{
+    if (acc->count == 0) {
+        return no_data;
+    }
+    
+    // Round half away from zero
+    int32_t half = acc->count / 2;
+    int32_t avg = (acc->sum >= 0 ? acc->sum + half : acc->sum - half) / acc->count;
+    return (sensor_bucket_t){ acc->min, acc->max, (int16_t)avg };
+}
+
+static void rollup_merge(rollup_t *into, const rollup_t *from)
+{
+    if (from->count == 0) {
+        return;
+    }
+    if (into->count == 0 || from->min < into->min) into->min = from->min;
+    if (into->count == 0 || from->max > into->max) into->max = from->max;
+    into->sum += from->sum;
+    into->count += from->count;
+}
+
+static void tier_push(tier_t *tier, sensor_bucket_t bucket)
+{
+    tier->entries[tier->head] = bucket;
+    tier->head = (tier->head + 1) % tier->len;
+    if (tier->count < tier->len) {
+        tier->count++;
+    }
+}
+
+// Add a reading to the bucket of time_s, closing the open bucket into the
+// ring first if time_s is past it
+static void tier_feed(tier_t *tier, const rollup_t *reading, uint32_t time_s)
+{
+    uint32_t index = time_s / tier->period_s;
+    
+    if (tier->open && index > tier->index) {
+        tier_push(tier, rollup_bucket(&tier->acc));
+        
+        // Buckets no reading fell into
+        uint32_t gap = index - tier->index - 1;
+        if (gap > tier->len) {
+            gap = tier->len;
+        }
+        while (gap-- > 0) {
+            tier_push(tier, no_data);
+        }
+        tier->open = false;
+    }
+    
+    if (!tier->open) {
+        memset(&tier->acc, 0, sizeof(tier->acc));
+        tier->index = index;
+        tier->open = true;
+    }
+    rollup_merge(&tier->acc, reading);
+}
+
+void sensor_history_add(sensor_quantity_t quantity, float value, uint32_t time_s)
+{
+    if (quantity >= SENSOR_QUANTITY_MAX || s_lock == NULL) {
+        return;
+    }
+    
+    channel_t *ch = &s_channels[quantity];
+    int16_t v = sensor_history_from_float(quantity, value);
+    rollup_t reading = { v, v, v, 1 };
+    
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    ch->raw[ch->raw_head] = v;
+    ch->raw_head = (ch->raw_head + 1) % SENSOR_HISTORY_RAW_LEN;
+    if (ch->raw_count < SENSOR_HISTORY_RAW_LEN) {
+        ch->raw_count++;
+    }
+    ch->raw_total++;
+    
+    // Every tier sums the readings themselves, so the open bucket of each is
+    // current; missing readings still pass time, so later buckets line up
+    if (v == SENSOR_HISTORY_NO_DATA) {
+        reading.count = 0;
+    }
+    for (int i = 0; i < ROLLUP_TIERS; i++) {
+        tier_feed(&ch->tiers[i], &reading, time_s);
+    }
+    xSemaphoreGive(s_lock);
+}
+
+// Entries in a tier, including the open bucket
+static int tier_size(const channel_t *ch, sensor_tier_t tier)
+{
+    if (tier == SENSOR_TIER_RAW) {
+        return ch->raw_count;
+    }
+    
+    const tier_t *t = &ch->tiers[tier - 1];
+    return t->count + (t->open ? 1 : 0);
+}
+
+// Entry age steps back from the newest, which is age 0
+static sensor_bucket_t tier_entry(const channel_t *ch, sensor_tier_t tier, int age)
+{
+    if (tier == SENSOR_TIER_RAW) {
+        int16_t v = ch->raw[(ch->raw_head + SENSOR_HISTORY_RAW_LEN - 1 - age) % SENSOR_HISTORY_RAW_LEN];
+        return (sensor_bucket_t){ v, v, v };
+    }
+    
+    const tier_t *t = &ch->tiers[tier - 1];
+    if (t->open) {
+        if (age == 0) {
+            return rollup_bucket(&t->acc);
+        }
+        age--;
+    }
+    return t->entries[(t->head + t->len - 1 - age) % t->len];
+}
+
+int sensor_history_read(sensor_quantity_t quantity, sensor_tier_t tier, sensor_bucket_t *out, int max_count)
+{
+    if (quantity >= SENSOR_QUANTITY_MAX || tier >= SENSOR_TIER_MAX || out == NULL || s_lock == NULL) {
+        return 0;
+    }
+    
+    const channel_t *ch = &s_channels[quantity];
+    
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int n = tier_size(ch, tier);
+    if (n > max_count) {
+        n = max_count;
+    }
+    for (int i = 0; i < n; i++) {
+        out[i] = tier_entry(ch, tier, n - 1 - i);
+    }
+    xSemaphoreGive(s_lock);
+    return n;
+}
+
+int sensor_history_read_since(sensor_quantity_t quantity, uint32_t *seq, sensor_bucket_t *out, int max_count)
+{
+    if (quantity >= SENSOR_QUANTITY_MAX || seq == NULL || out == NULL || s_lock == NULL) {
+        return 0;
+    }
+    
+    const channel_t *ch = &s_channels[quantity];
+    
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    uint32_t added = ch->raw_total - *seq;
+    int n = added < ch->raw_count ? (int)added : ch->raw_count;
+    if (n > max_count) {
+        n = max_count;
+    }
+    for (int i = 0; i < n; i++) {
+        out[i] = tier_entry(ch, SENSOR_TIER_RAW, n - 1 - i);
+    }
+    *seq = ch->raw_total;
+    xSemaphoreGive(s_lock);
+    return n;
+}
+
+esp_err_t sensor_history_stats(sensor_quantity_t quantity, sensor_tier_t tier, int count, sensor_stats_t *stats)
+{
+    if (quantity >= SENSOR_QUANTITY_MAX || tier >= SENSOR_TIER_MAX || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_lock == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    const channel_t *ch = &s_channels[quantity];
+    int16_t min = INT16_MAX;
+    int16_t max = INT16_MIN;
+    int32_t sum = 0;
+    uint16_t entries = 0;
+    
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int n = tier_size(ch, tier);
+    if (n > count) {
+        n = count;
+    }
+    for (int age = 0; age < n; age++) {
+        sensor_bucket_t b = tier_entry(ch, tier, age);
+        if (b.avg == SENSOR_HISTORY_NO_DATA) {
+            continue;
+        }
+        if (b.min < min) min = b.min;
+        if (b.max > max) max = b.max;
+        sum += b.avg;
+        entries++;
+    }
+    xSemaphoreGive(s_lock);
+    
+    if (entries == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    stats->min = sensor_history_to_float(quantity, min);
+    stats->max = sensor_history_to_float(quantity, max);
+    stats->avg = (float)sum / entries / scales[quantity];
+    stats->entries = entries;
+    return ESP_OK;
+}
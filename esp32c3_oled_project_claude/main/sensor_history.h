@@ -0,0 +1,94 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "sensor_driver.h"
+
+#define SENSOR_HISTORY_RAW_LEN      120     // Every reading, two minutes at SENSOR_READ_INTERVAL_MS
+#define SENSOR_HISTORY_MINUTE_LEN   60      // One hour of 1-minute buckets
+#define SENSOR_HISTORY_QUARTER_LEN  48      // Twelve hours of 15-minute buckets
+#define SENSOR_HISTORY_NO_DATA      INT16_MIN
+
+typedef enum {
+    SENSOR_TIER_RAW = 0,
+    SENSOR_TIER_MINUTE,
+    SENSOR_TIER_QUARTER,
+    SENSOR_TIER_MAX
+} sensor_tier_t;
+
+/**
+ * @brief One history entry, in the fixed-point units of its quantity
+ *
+ * Raw entries have min == max == avg. Buckets no reading fell into hold
+ * SENSOR_HISTORY_NO_DATA in all three fields.
+ */
+typedef struct {
+    int16_t min;
+    int16_t max;
+    int16_t avg;
+} sensor_bucket_t;
+
+typedef struct {
+    float min;
+    float max;
+    float avg;                  // Mean of the entry averages
+    uint16_t entries;           // Entries that held data
+} sensor_stats_t;
+
+/**
+ * @brief Clear the history
+ *
+ * Readings are kept per quantity in fixed memory: a ring of raw readings and
+ * two rings of min/max/avg buckets. Each bucket is rolled up from the exact
+ * sums of the readings in it, so averages do not drift with the tier.
+ */
+esp_err_t sensor_history_init(void);
+
+/**
+ * @brief Record a reading
+ * @param quantity Quantity read
+ * @param value Reading in the units of the quantity
+ * @param time_s Monotonic time of the reading, places it in its buckets
+ */
+void sensor_history_add(sensor_quantity_t quantity, float value, uint32_t time_s);
+
+/**
+ * @brief Copy the newest entries of a tier, oldest first
+ *
+ * The bucket still being filled is included as the newest entry.
+ * @param quantity Quantity
+ * @param tier Tier to read
+ * @param out Entries
+ * @param max_count Capacity of out
+ * @return Number of entries copied
+ */
+int sensor_history_read(sensor_quantity_t quantity, sensor_tier_t tier, sensor_bucket_t *out, int max_count);
+
+/**
+ * @brief Copy the raw readings recorded since an earlier call, oldest first
+ *
+ * At most max_count of the newest are copied, and none older than the raw
+ * ring holds.
+ * @param quantity Quantity
+ * @param seq Readings already seen: 0 at first, set to the number recorded so far
+ * @param out Readings
+ * @param max_count Capacity of out
+ * @return Number of readings copied
+ */
+int sensor_history_read_since(sensor_quantity_t quantity, uint32_t *seq, sensor_bucket_t *out, int max_count);
+
+/**
+ * @brief Min, max and average over the newest entries of a tier
+ * @param quantity Quantity
+ * @param tier Tier to summarize
+ * @param count Entries to cover, e.g. 60 minute buckets for the last hour
+ * @param stats Output
+ * @return ESP_OK, ESP_ERR_NOT_FOUND if none of the entries held data
+ */
+esp_err_t sensor_history_stats(sensor_quantity_t quantity, sensor_tier_t tier, int count, sensor_stats_t *stats);
+
+float sensor_history_to_float(sensor_quantity_t quantity, int16_t value);
+int16_t sensor_history_from_float(sensor_quantity_t quantity, float value);
+
+#endif // SENSOR_HISTORY_H
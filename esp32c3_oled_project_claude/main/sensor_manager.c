@@ -1,19 +1,50 @@
 #include <math.h>
 #include "sensor_manager.h"
+#include "sensor_history.h"
+#include "sensor_sim.h"
+#include "app_config.h"
 #include "esp_log.h"
-#include "esp_random.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "snapshot.h"
 
 static const char *TAG = "SENSOR_MGR";
 
+// Working copy owned by the sensor task; other tasks read the published snapshot
 static sensor_data_t g_sensor_data = {0};
+static sensor_data_t g_sensor_copies[2];
+static snapshot_t g_sensor_snapshot = SNAPSHOT_INIT(g_sensor_copies);
 static bool initialized = false;
 
+// One driver per quantity, ops NULL if none is fitted
+static sensor_driver_t g_drivers[SENSOR_QUANTITY_MAX];
+static sensor_sim_t g_sim_sensors[SENSOR_QUANTITY_MAX];
+
+static const uint32_t sim_conversion_us[SENSOR_QUANTITY_MAX] = {
+    [SENSOR_TEMPERATURE] = SENSOR_SIM_TEMPERATURE_US,
+    [SENSOR_HUMIDITY]    = SENSOR_SIM_HUMIDITY_US,
+    [SENSOR_PRESSURE]    = SENSOR_SIM_PRESSURE_US,
+    [SENSOR_LIGHT]       = SENSOR_SIM_LIGHT_US,
+};
+
+static const char *quantity_names[SENSOR_QUANTITY_MAX] = {
+    [SENSOR_TEMPERATURE] = "temperature",
+    [SENSOR_HUMIDITY]    = "humidity",
+    [SENSOR_PRESSURE]    = "pressure",
+    [SENSOR_LIGHT]       = "light",
+};
+
 esp_err_t sensor_manager_init(void)
 {
-    // Initialize sensor hardware here
-    // For this demo, we'll simulate sensors
+    esp_err_t ret = sensor_history_init();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        sensor_sim_init(&g_sim_sensors[i], i, sim_conversion_us[i], &g_drivers[i]);
+    }
     
     g_sensor_data.temperature = 22.5;
     g_sensor_data.humidity = 45.0;
@@ -21,163 +52,178 @@ esp_err_t sensor_manager_init(void)
     g_sensor_data.light_level = 500;
     g_sensor_data.data_valid = false;
     g_sensor_data.last_update = 0;
+    snapshot_write(&g_sensor_snapshot, &g_sensor_data);
     
     initialized = true;
     ESP_LOGI(TAG, "Sensor manager initialized (simulated sensors)");
     return ESP_OK;
 }
 
-esp_err_t sensor_manager_update(void)
+esp_err_t sensor_manager_register(const sensor_driver_t *driver)
 {
-    if (!initialized) {
-        return ESP_ERR_INVALID_STATE;
-    }
-    
-    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    
-    // Simulate sensor readings with realistic variations
-    esp_err_t ret = ESP_OK;
-    
-    // Temperature: 20-25°C with slow variations
-    static float temp_base = 22.5;
-    temp_base += (esp_random() % 100 - 50) * 0.01; // ±0.5°C variation
-    if (temp_base < 20.0) temp_base = 20.0;
-    if (temp_base > 25.0) temp_base = 25.0;
-    
-    ret |= sensor_read_temperature(&g_sensor_data.temperature);
-    
-    // Humidity: 40-60% with medium variations
-    static float hum_base = 45.0;
-    hum_base += (esp_random() % 100 - 50) * 0.05; // ±2.5% variation
-    if (hum_base < 40.0) hum_base = 40.0;
-    if (hum_base > 60.0) hum_base = 60.0;
-    
-    ret |= sensor_read_humidity(&g_sensor_data.humidity);
-    
-    // Pressure: 1010-1020 hPa with slow variations
-    static float pressure_base = 1013.25;
-    pressure_base += (esp_random() % 100 - 50) * 0.02; // ±1 hPa variation
-    if (pressure_base < 1010.0) pressure_base = 1010.0;
-    if (pressure_base > 1020.0) pressure_base = 1020.0;
-    
-    ret |= sensor_read_pressure(&g_sensor_data.pressure);
-    
-    // Light level: 0-1000 with day/night cycle simulation
-    uint16_t light = 500 + 400 * sin(now * 0.0001); // Simulate day/night cycle
-    light += esp_random() % 100 - 50; // Add some noise
-    if (light > 1000) light = 1000;
-    
-    ret |= sensor_read_light(&g_sensor_data.light_level);
-    
-    g_sensor_data.data_valid = (ret == ESP_OK);
-    g_sensor_data.last_update = now;
-    
-    if (ret == ESP_OK) {
-        ESP_LOGD(TAG, "Sensors updated: T=%.1f°C, H=%.1f%%, P=%.1fhPa, L=%d",
-                g_sensor_data.temperature, g_sensor_data.humidity,
-                g_sensor_data.pressure, g_sensor_data.light_level);
+    if (driver == NULL || driver->ops == NULL || driver->quantity >= SENSOR_QUANTITY_MAX) {
+        return ESP_ERR_INVALID_ARG;
     }
     
-    return ret;
+    g_drivers[driver->quantity] = *driver;
+    ESP_LOGI(TAG, "%s: %s driver", quantity_names[driver->quantity], driver->name);
+    return ESP_OK;
 }
 
-sensor_data_t* sensor_manager_get_data(void)
+static void store_reading(sensor_quantity_t quantity, float value)
 {
-    return &g_sensor_data;
+    switch (quantity) {
+        case SENSOR_TEMPERATURE:
+            g_sensor_data.temperature = value;
+            break;
+        case SENSOR_HUMIDITY:
+            g_sensor_data.humidity = value;
+            break;
+        case SENSOR_PRESSURE:
+            g_sensor_data.pressure = value;
+            break;
+        case SENSOR_LIGHT:
+            g_sensor_data.light_level = (uint16_t)lroundf(value);
+            break;
+        default:
+            break;
+    }
 }
 
-bool sensor_manager_is_data_valid(void)
+// Fetch every pending reading that is ready into values; returns the ones
+// still converting
+static uint32_t collect_readings(uint32_t pending, float *values, esp_err_t *ret)
 {
-    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    return g_sensor_data.data_valid && (now - g_sensor_data.last_update < 5000);
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        const sensor_driver_t *driver = &g_drivers[i];
+        bool ready = false;
+        float value;
+        
+        if (!(pending & (1u << i))) {
+            continue;
+        }
+        
+        esp_err_t err = driver->ops->poll(driver->ctx, &ready);
+        if (err == ESP_OK && !ready) {
+            continue;
+        }
+        if (err == ESP_OK) {
+            err = driver->ops->fetch(driver->ctx, &value);
+        }
+        if (err == ESP_OK) {
+            store_reading(i, value);
+            values[i] = value;
+        } else {
+            ESP_LOGW(TAG, "%s: %s", quantity_names[i], esp_err_to_name(err));
+            *ret = err;
+        }
+        pending &= ~(1u << i);
+    }
+    return pending;
 }
 
-// Individual sensor reading functions (simulated)
-esp_err_t sensor_read_temperature(float *temperature)
+static TickType_t us_to_ticks(int64_t us)
 {
-    if (temperature == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    // Simulate I2C/SPI communication delay
-    vTaskDelay(pdMS_TO_TICKS(10));
-    
-    // Simulate realistic temperature with noise
-    static float base_temp = 22.5;
-    base_temp += (esp_random() % 20 - 10) * 0.01; // ±0.1°C noise
-    
-    // Add some seasonal/daily variation
-    uint32_t time_factor = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    float daily_variation = 2.0 * sin(time_factor * 0.0001);
-    
-    *temperature = base_temp + daily_variation;
-    
-    return ESP_OK;
+    int64_t tick_us = portTICK_PERIOD_MS * 1000;
+    return (TickType_t)((us + tick_us - 1) / tick_us);
 }
 
-esp_err_t sensor_read_humidity(float *humidity)
+esp_err_t sensor_manager_update(void)
 {
-    if (humidity == NULL) {
-        return ESP_ERR_INVALID_ARG;
+    if (!initialized) {
+        return ESP_ERR_INVALID_STATE;
     }
     
-    vTaskDelay(pdMS_TO_TICKS(10));
+    int64_t start = esp_timer_get_time();
+    uint32_t longest_us = 0;
+    uint32_t pending = 0;
+    float values[SENSOR_QUANTITY_MAX];
+    esp_err_t ret = ESP_OK;
     
-    static float base_humidity = 45.0;
-    base_humidity += (esp_random() % 40 - 20) * 0.05; // ±1% noise
+    // Start every conversion before waiting for any, so they run concurrently
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        const sensor_driver_t *driver = &g_drivers[i];
+        uint32_t conversion_us = 0;
+        
+        values[i] = NAN;
+        if (driver->ops == NULL) {
+            continue;
+        }
+        
+        esp_err_t err = driver->ops->start(driver->ctx, &conversion_us);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "%s: start failed: %s", quantity_names[i], esp_err_to_name(err));
+            ret = err;
+            continue;
+        }
+        pending |= 1u << i;
+        if (conversion_us > longest_us) {
+            longest_us = conversion_us;
+        }
+    }
     
-    // Humidity inversely related to temperature (roughly)
-    uint32_t time_factor = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    float temp_influence = -1.0 * sin(time_factor * 0.0001);
+    // Sleep through the slowest expected conversion, then collect; sensors
+    // that are still busy are polled every tick until the timeout
+    int64_t wake_at = start + longest_us;
+    while (pending != 0) {
+        int64_t now = esp_timer_get_time();
+        if (wake_at > now) {
+            vTaskDelay(us_to_ticks(wake_at - now));
+        }
+        
+        pending = collect_readings(pending, values, &ret);
+        
+        now = esp_timer_get_time();
+        if (pending != 0 && now - start >= SENSOR_CONVERSION_TIMEOUT_MS * 1000) {
+            ESP_LOGW(TAG, "Conversion timeout, pending 0x%02lx", (unsigned long)pending);
+            ret = ESP_ERR_TIMEOUT;
+            break;
+        }
+        wake_at = now + portTICK_PERIOD_MS * 1000;
+    }
     
-    *humidity = base_humidity + temp_influence;
+    // Failed readings are recorded as gaps
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        if (g_drivers[i].ops != NULL) {
+            sensor_history_add(i, values[i], (uint32_t)(start / 1000000));
+        }
+    }
     
-    // Clamp to realistic range
-    if (*humidity < 0) *humidity = 0;
-    if (*humidity > 100) *humidity = 100;
+    g_sensor_data.data_valid = (ret == ESP_OK);
+    g_sensor_data.last_update = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    snapshot_write(&g_sensor_snapshot, &g_sensor_data);
     
-    return ESP_OK;
+    if (ret == ESP_OK) {
+        ESP_LOGD(TAG, "Sensors updated in %lld us: T=%.1f°C, H=%.1f%%, P=%.1fhPa, L=%d",
+                (long long)(esp_timer_get_time() - start),
+                g_sensor_data.temperature, g_sensor_data.humidity,
+                g_sensor_data.pressure, g_sensor_data.light_level);
+    }
+    
+    return ret;
 }
 
-esp_err_t sensor_read_pressure(float *pressure)
+esp_err_t sensor_manager_get_data(sensor_data_t *data)
 {
-    if (pressure == NULL) {
+    if (data == NULL) {
         return ESP_ERR_INVALID_ARG;
     }
+    if (!initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
     
-    vTaskDelay(pdMS_TO_TICKS(15));
-    
-    static float base_pressure = 1013.25;
-    base_pressure += (esp_random() % 10 - 5) * 0.1; // ±0.5 hPa noise
-    
-    // Slow pressure changes
-    uint32_t time_factor = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    float weather_pattern = 5.0 * sin(time_factor * 0.00005);
-    
-    *pressure = base_pressure + weather_pattern;
-    
+    snapshot_read(&g_sensor_snapshot, data);
     return ESP_OK;
 }
 
-esp_err_t sensor_read_light(uint16_t *light_level)
+bool sensor_manager_is_data_valid(void)
 {
-    if (light_level == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    vTaskDelay(pdMS_TO_TICKS(5));
-    
-    // Simulate day/night cycle
-    uint32_t time_factor = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    float day_cycle = sin(time_factor * 0.0002); // Slow day/night cycle
-    
-    uint16_t base_light = 500 + 400 * day_cycle;
-    base_light += esp_random() % 100 - 50; // Add noise
+    sensor_data_t data;
     
-    if (base_light > 1000) base_light = 1000;
-    if (base_light < 0) base_light = 0;
-    
-    *light_level = base_light;
+    if (sensor_manager_get_data(&data) != ESP_OK) {
+        return false;
+    }
     
-    return ESP_OK;
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    return data.data_valid && (now - data.last_update < 5000);
 }
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "esp_err.h"
+#include "sensor_driver.h"
 
 typedef struct {
     float temperature;
@@ -14,15 +15,18 @@ typedef struct {
 } sensor_data_t;
 
 // Sensor Manager API
-esp_err_t sensor_manager_init(void);
-esp_err_t sensor_manager_update(void);
-sensor_data_t* sensor_manager_get_data(void);
+esp_err_t sensor_manager_init(void);        // Fits the simulated sensors
+esp_err_t sensor_manager_update(void);      // Takes about as long as the slowest conversion
+esp_err_t sensor_manager_get_data(sensor_data_t *data);    // Consistent copy, safe from any task
 bool sensor_manager_is_data_valid(void);
 
-// Individual sensor functions (for future expansion)
-esp_err_t sensor_read_temperature(float *temperature);
-esp_err_t sensor_read_humidity(float *humidity);
-esp_err_t sensor_read_pressure(float *pressure);
-esp_err_t sensor_read_light(uint16_t *light_level);
+/**
+ * @brief Replace the driver of driver->quantity, e.g. a simulated sensor with real hardware
+ *
+ * Call after sensor_manager_init() and before the first update.
+ * @param driver Driver; copied, its context must outlive the sensor manager
+ * @return ESP_OK, ESP_ERR_INVALID_ARG
+ */
+esp_err_t sensor_manager_register(const sensor_driver_t *driver);
 
 #endif // SENSOR_MANAGER_H
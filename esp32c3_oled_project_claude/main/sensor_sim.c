@@ -0,0 +1,111 @@
+#include <math.h>
+#include "sensor_sim.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+
+typedef struct {
+    float initial;
+    float min_base;             // Range the random walk is kept in
+    float max_base;
+    float step;                 // Largest random walk step
+} sensor_sim_model_t;
+
+static const sensor_sim_model_t models[SENSOR_QUANTITY_MAX] = {
+    [SENSOR_TEMPERATURE] = { 22.5f, 20.0f, 25.0f, 0.1f },
+    [SENSOR_HUMIDITY]    = { 45.0f, 40.0f, 60.0f, 1.0f },
+    [SENSOR_PRESSURE]    = { 1013.25f, 1010.0f, 1020.0f, 0.5f },
+    [SENSOR_LIGHT]       = { 500.0f, 500.0f, 500.0f, 0.0f },
+};
+
+// Uniform in [-1, 1)
+static float random_unit(void)
+{
+    return (int32_t)(esp_random() % 2000 - 1000) / 1000.0f;
+}
+
+static esp_err_t sim_start(void *ctx, uint32_t *conversion_us)
+{
+    sensor_sim_t *sim = ctx;
+    
+    sim->started_at = esp_timer_get_time();
+    sim->busy = true;
+    *conversion_us = sim->conversion_us;
+    return ESP_OK;
+}
+
+static esp_err_t sim_poll(void *ctx, bool *ready)
+{
+    sensor_sim_t *sim = ctx;
+    
+    if (!sim->busy) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *ready = esp_timer_get_time() - sim->started_at >= sim->conversion_us;
+    return ESP_OK;
+}
+
+static esp_err_t sim_fetch(void *ctx, float *value)
+{
+    sensor_sim_t *sim = ctx;
+    const sensor_sim_model_t *model = &models[sim->quantity];
+    
+    if (!sim->busy) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    sim->busy = false;
+    
+    sim->base += random_unit() * model->step;
+    if (sim->base < model->min_base) sim->base = model->min_base;
+    if (sim->base > model->max_base) sim->base = model->max_base;
+    
+    // Sampled when the conversion started
+    float t = (float)(sim->started_at / 1000);
+    float v;
+    
+    switch (sim->quantity) {
+        case SENSOR_TEMPERATURE:
+            v = sim->base + 2.0f * sinf(t * 0.0001f);
+            break;
+        case SENSOR_HUMIDITY:
+            // Inversely related to temperature, roughly
+            v = sim->base - sinf(t * 0.0001f);
+            if (v < 0.0f) v = 0.0f;
+            if (v > 100.0f) v = 100.0f;
+            break;
+        case SENSOR_PRESSURE:
+            v = sim->base + 5.0f * sinf(t * 0.00005f);
+            break;
+        case SENSOR_LIGHT:
+            // Day/night cycle with noise
+            v = sim->base + 400.0f * sinf(t * 0.0002f) + random_unit() * 50.0f;
+            if (v < 0.0f) v = 0.0f;
+            if (v > 1000.0f) v = 1000.0f;
+            break;
+        default:
+            return ESP_ERR_INVALID_STATE;
+    }
+    
+    *value = v;
+    return ESP_OK;
+}
+
+const sensor_driver_ops_t sensor_sim_ops = {
+    .start = sim_start,
+    .poll = sim_poll,
+    .fetch = sim_fetch,
+};
+
+void sensor_sim_init(sensor_sim_t *sim, sensor_quantity_t quantity, uint32_t conversion_us,
+                     sensor_driver_t *driver)
+{
+    sim->quantity = quantity;
+    sim->conversion_us = conversion_us;
+    sim->base = models[quantity].initial;
+    sim->started_at = 0;
+    sim->busy = false;
+    
+    driver->name = "sim";
+    driver->quantity = quantity;
+    driver->ops = &sensor_sim_ops;
+    driver->ctx = sim;
+}
@@ -0,0 +1,34 @@
+#ifndef SENSOR_SIM_H
+#define SENSOR_SIM_H
+
+#include <stdint.h>
+#include "sensor_driver.h"
+
+/**
+ * @brief Simulated sensor
+ *
+ * Produces plausible readings for one quantity, a random walk around a slow
+ * daily cycle, and becomes ready conversion_us after start() like a sensor
+ * on a bus would.
+ */
+typedef struct {
+    sensor_quantity_t quantity;
+    uint32_t conversion_us;
+    float base;                 // Random walk the reading drifts around
+    int64_t started_at;         // esp_timer time of the running conversion
+    bool busy;
+} sensor_sim_t;
+
+extern const sensor_driver_ops_t sensor_sim_ops;
+
+/**
+ * @brief Set up a simulated sensor
+ * @param sim Sensor state, used as the driver context
+ * @param quantity Quantity it reports
+ * @param conversion_us Time from start() until the reading is ready
+ * @param driver Set to the driver for sensor_manager_register()
+ */
+void sensor_sim_init(sensor_sim_t *sim, sensor_quantity_t quantity, uint32_t conversion_us,
+                     sensor_driver_t *driver);
+
+#endif // SENSOR_SIM_H
@@ -0,0 +1,181 @@
+#include "sparkline.h"
+
+void sparkline_init(sparkline_t *spark, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                    sparkline_style_t style, int16_t min_span)
+{
+    spark->x = x;
+    spark->y = y;
+    spark->width = width > SPARKLINE_MAX_WIDTH ? SPARKLINE_MAX_WIDTH : width;
+    spark->height = height;
+    spark->style = style;
+    spark->min_span = min_span > 0 ? min_span : 1;
+    sparkline_reset(spark);
+}
+
+void sparkline_reset(sparkline_t *spark)
+{
+    spark->head = 0;
+    spark->count = 0;
+    spark->pending = 0;
+    spark->lo = 0;
+    spark->hi = 0;
+    spark->drawn = false;
+}
+
+void sparkline_invalidate(sparkline_t *spark)
+{
+    spark->drawn = false;
+}
+
+void sparkline_push(sparkline_t *spark, int16_t value)
+{
+    // One sample more than fits, so the leftmost column still joins its predecessor
+    spark->samples[spark->head] = value;
+    spark->head = (spark->head + 1) % (spark->width + 1);
+    if (spark->count <= spark->width) {
+        spark->count++;
+    }
+    if (spark->pending < spark->width) {
+        spark->pending++;
+    }
+}
+
+// Sample age steps back from the newest, which is age 0
+static int16_t sample_at(const sparkline_t *spark, int age)
+{
+    if (age >= spark->count) {
+        return SPARKLINE_GAP;
+    }
+    return spark->samples[(spark->head + spark->width - age) % (spark->width + 1)];
+}
+
+bool sparkline_range(const sparkline_t *spark, int16_t *min, int16_t *max)
+{
+    int16_t lo = INT16_MAX;
+    int16_t hi = INT16_MIN;
+    
+    for (int age = 0; age < spark->width; age++) {
+        int16_t v = sample_at(spark, age);
+        if (v == SPARKLINE_GAP) {
+            continue;
+        }
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    
+    if (lo > hi) {
+        return false;
+    }
+    *min = lo;
+    *max = hi;
+    return true;
+}
+
+// Axis for samples between min and max: at least min_span wide, padded by an eighth
+static void fit_axis(const sparkline_t *spark, int32_t min, int32_t max, int32_t *lo, int32_t *hi)
+{
+    int32_t span = max - min;
+    if (span < spark->min_span) {
+        int32_t grow = spark->min_span - span;
+        min -= grow / 2;
+        max += grow - grow / 2;
+        span = spark->min_span;
+    }
+    
+    int32_t pad = span / 8 + 1;
+    *lo = min - pad;
+    *hi = max + pad;
+    if (*lo < INT16_MIN + 1) *lo = INT16_MIN + 1;
+    if (*hi > INT16_MAX) *hi = INT16_MAX;
+}
+
+// Refit the axis if a sample is outside it or the samples use less than half of it
+static bool update_axis(sparkline_t *spark)
+{
+    int16_t min, max;
+    int32_t lo, hi;
+    
+    if (!sparkline_range(spark, &min, &max)) {
+        return false;
+    }
+    
+    fit_axis(spark, min, max, &lo, &hi);
+    if (spark->hi > spark->lo && min >= spark->lo && max <= spark->hi && spark->hi - spark->lo <= 2 * (hi - lo)) {
+        return false;
+    }
+    
+    spark->lo = lo;
+    spark->hi = hi;
+    return true;
+}
+
+// Row of a value, clamped to the plot: the sample before the leftmost column
+// is outside the fitted range and may lie beyond the axis
+static uint8_t value_row(const sparkline_t *spark, int16_t value)
+{
+    int32_t top = spark->y;
+    int32_t bottom = spark->y + spark->height - 1;
+    int32_t row = bottom - ((int32_t)value - spark->lo) * (spark->height - 1) / (spark->hi - spark->lo);
+    
+    if (row < top) return top;
+    if (row > bottom) return bottom;
+    return row;
+}
+
+// Draw one column into a blank plot area
+static void draw_column(sparkline_t *spark, ssd1306_handle_t display, int column)
+{
+    int age = spark->width - 1 - column;
+    int16_t value = sample_at(spark, age);
+    
+    if (value == SPARKLINE_GAP) {
+        return;
+    }
+    
+    uint8_t x = spark->x + column;
+    uint8_t row = value_row(spark, value);
+    uint8_t top = row;
+    uint8_t bottom = row;
+    
+    if (spark->style == SPARKLINE_BARS) {
+        bottom = spark->y + spark->height - 1;
+    } else {
+        // Join the previous sample with a vertical span
+        int16_t previous = sample_at(spark, age + 1);
+        if (previous != SPARKLINE_GAP) {
+            uint8_t prev_row = value_row(spark, previous);
+            if (prev_row < top) top = prev_row;
+            if (prev_row > bottom) bottom = prev_row;
+        }
+    }
+    
+    ssd1306_draw_vline(display, x, top, bottom - top + 1, 1);
+}
+
+int sparkline_render(sparkline_t *spark, ssd1306_handle_t display)
+{
+    if (spark->drawn && spark->pending == 0) {
+        return 0;
+    }
+    
+    bool rescaled = update_axis(spark);
+    int first = spark->width - spark->pending;
+    
+    // A new axis moves every sample, so start over
+    if (!spark->drawn || rescaled) {
+        ssd1306_fill_rect(display, spark->x, spark->y, spark->width, spark->height, 0);
+        first = 0;
+    } else {
+        ssd1306_shift_left(display, spark->x, spark->y, spark->width, spark->height, spark->pending);
+    }
+    
+    if (spark->count > 0) {
+        for (int column = first; column < spark->width; column++) {
+            draw_column(spark, display, column);
+        }
+    }
+    
+    spark->pending = 0;
+    spark->drawn = true;
+    return spark->width - first;
+}
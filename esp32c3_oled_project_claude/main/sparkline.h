@@ -0,0 +1,62 @@
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+#define SPARKLINE_MAX_WIDTH     SSD1306_WIDTH
+#define SPARKLINE_GAP           INT16_MIN   // Sample without data, drawn as an empty column
+
+typedef enum {
+    SPARKLINE_LINE = 0,         // Each column spans from the previous sample to its own
+    SPARKLINE_BARS,             // Each column is filled from the bottom up to its sample
+} sparkline_style_t;
+
+/**
+ * @brief Scrolling graph of the newest samples, one column each
+ *
+ * The newest sample is drawn in the rightmost column. Pushing a sample
+ * shifts the plot left and draws only the new column, unless the vertical
+ * axis has to change: the axis fits the visible samples and is refitted once
+ * one falls outside it or the samples use less than half of it.
+ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;              // At most SPARKLINE_MAX_WIDTH
+    uint8_t height;
+    sparkline_style_t style;
+    int16_t min_span;           // Smallest axis range, so noise is not blown up to full height
+    
+    int16_t samples[SPARKLINE_MAX_WIDTH + 1];   // Ring of the visible samples and the one before
+    uint8_t head;               // Slot of the next sample
+    uint8_t count;              // Samples held, at most width + 1
+    uint8_t pending;            // Samples pushed since the last render
+    int16_t lo;                 // Axis at the bottom and top rows
+    int16_t hi;
+    bool drawn;                 // The plot on screen shows samples up to pending
+} sparkline_t;
+
+void sparkline_init(sparkline_t *spark, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                    sparkline_style_t style, int16_t min_span);
+
+void sparkline_push(sparkline_t *spark, int16_t value);
+void sparkline_reset(sparkline_t *spark);           // Forget every sample
+void sparkline_invalidate(sparkline_t *spark);      // Redraw in full on the next render, e.g. after a clear
+
+/**
+ * @brief Bring the plot up to date with the pushed samples
+ * @param spark Sparkline
+ * @param display Display to draw on
+ * @return Number of columns drawn, 0 if nothing changed
+ */
+int sparkline_render(sparkline_t *spark, ssd1306_handle_t display);
+
+/**
+ * @brief Smallest and largest visible sample
+ * @return false if no visible sample holds data
+ */
+bool sparkline_range(const sparkline_t *spark, int16_t *min, int16_t *max);
+
+#endif // SPARKLINE_H
@@ -9,6 +9,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "freertos/semphr.h"
+#include "snapshot.h"
 
 static const char *TAG = "WIFI_MGR";
 
@@ -18,6 +20,9 @@ static const char *TAG = "WIFI_MGR";
 
 static EventGroupHandle_t s_wifi_event_group;
 static wifi_status_t g_wifi_status = {0};
+static wifi_status_t g_wifi_copies[2];
+static snapshot_t g_wifi_snapshot = SNAPSHOT_INIT(g_wifi_copies);
+static SemaphoreHandle_t s_status_lock;     // Serializes writers of g_wifi_status
 static bool initialized = false;
 static int s_retry_num = 0;
 
@@ -25,6 +30,19 @@ static int s_retry_num = 0;
 static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                               int32_t event_id, void* event_data);
 
+// g_wifi_status is changed from API callers and the event loop task. Writers
+// hold s_status_lock and publish on commit; readers only see the snapshot.
+static void wifi_status_begin(void)
+{
+    xSemaphoreTake(s_status_lock, portMAX_DELAY);
+}
+
+static void wifi_status_commit(void)
+{
+    snapshot_write(&g_wifi_snapshot, &g_wifi_status);
+    xSemaphoreGive(s_status_lock);
+}
+
 esp_err_t wifi_manager_init(void)
 {
     if (initialized) {
@@ -42,8 +60,21 @@ esp_err_t wifi_manager_init(void)
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
     
-    // Create event group
+    // Create event group and status lock
     s_wifi_event_group = xEventGroupCreate();
+    s_status_lock = xSemaphoreCreateMutex();
+    if (s_wifi_event_group == NULL || s_status_lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create WiFi event group or status lock");
+        if (s_wifi_event_group) {
+            vEventGroupDelete(s_wifi_event_group);
+            s_wifi_event_group = NULL;
+        }
+        if (s_status_lock) {
+            vSemaphoreDelete(s_status_lock);
+            s_status_lock = NULL;
+        }
+        return ESP_ERR_NO_MEM;
+    }
     
     // Register event handlers
     ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT,
@@ -56,6 +87,7 @@ esp_err_t wifi_manager_init(void)
                                              NULL));
     
     // Initialize status
+    wifi_status_begin();
     g_wifi_status.state = WIFI_STATE_IDLE;
     g_wifi_status.rssi = 0;
     g_wifi_status.connect_time = 0;
@@ -63,6 +95,7 @@ esp_err_t wifi_manager_init(void)
     g_wifi_status.scan_count = 0;
     memset(g_wifi_status.ssid, 0, sizeof(g_wifi_status.ssid));
     memset(g_wifi_status.ip_address, 0, sizeof(g_wifi_status.ip_address));
+    wifi_status_commit();
     
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
     
@@ -90,7 +123,9 @@ esp_err_t wifi_manager_stop(void)
         return ESP_ERR_INVALID_STATE;
     }
     
+    wifi_status_begin();
     g_wifi_status.state = WIFI_STATE_IDLE;
+    wifi_status_commit();
     return esp_wifi_stop();
 }
 
@@ -113,8 +148,10 @@ esp_err_t wifi_manager_connect(const char* ssid, const char* password)
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
     ESP_ERROR_CHECK(esp_wifi_start());
     
+    wifi_status_begin();
     g_wifi_status.state = WIFI_STATE_CONNECTING;
     strncpy(g_wifi_status.ssid, ssid, sizeof(g_wifi_status.ssid) - 1);
+    wifi_status_commit();
     s_retry_num = 0;
     
     ESP_LOGI(TAG, "Connecting to WiFi SSID: %s", ssid);
@@ -143,7 +180,9 @@ esp_err_t wifi_manager_disconnect(void)
         return ESP_ERR_INVALID_STATE;
     }
     
+    wifi_status_begin();
     g_wifi_status.state = WIFI_STATE_DISCONNECTED;
+    wifi_status_commit();
     return esp_wifi_disconnect();
 }
 
@@ -159,14 +198,22 @@ esp_err_t wifi_manager_scan(void)
     return esp_wifi_scan_start(&scan_config, false);
 }
 
-wifi_status_t* wifi_manager_get_status(void)
+esp_err_t wifi_manager_get_status(wifi_status_t *status)
 {
-    return &g_wifi_status;
+    if (status == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    snapshot_read(&g_wifi_snapshot, status);
+    return ESP_OK;
 }
 
 bool wifi_manager_is_connected(void)
 {
-    return (g_wifi_status.state == WIFI_STATE_CONNECTED);
+    wifi_status_t status;
+    
+    wifi_manager_get_status(&status);
+    return (status.state == WIFI_STATE_CONNECTED);
 }
 
 esp_err_t wifi_manager_save_config(const char* ssid, const char* password)
@@ -252,28 +299,32 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                 ESP_LOGI(TAG, "WiFi station started");
                 esp_wifi_connect();
                 break;
-                
+            
             case WIFI_EVENT_STA_DISCONNECTED:
                 {
                     wifi_event_sta_disconnected_t* disconnected = (wifi_event_sta_disconnected_t*) event_data;
                     ESP_LOGI(TAG, "WiFi disconnected, reason: %d", disconnected->reason);
                     
-                    g_wifi_status.state = WIFI_STATE_DISCONNECTED;
+                    bool retry = s_retry_num < 5;
+                    wifi_status_begin();
+                    g_wifi_status.state = retry ? WIFI_STATE_DISCONNECTED : WIFI_STATE_ERROR;
                     g_wifi_status.rssi = 0;
                     memset(g_wifi_status.ip_address, 0, sizeof(g_wifi_status.ip_address));
+                    if (retry) {
+                        g_wifi_status.reconnect_count++;
+                    }
+                    wifi_status_commit();
                     
-                    if (s_retry_num < 5) {
+                    if (retry) {
                         esp_wifi_connect();
                         s_retry_num++;
-                        g_wifi_status.reconnect_count++;
                         ESP_LOGI(TAG, "Retry to connect to the AP");
                     } else {
                         xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
-                        g_wifi_status.state = WIFI_STATE_ERROR;
                     }
                 }
                 break;
-                
+            
             case WIFI_EVENT_SCAN_DONE:
                 {
                     wifi_event_sta_scan_done_t* scan_done = (wifi_event_sta_scan_done_t*) event_data;
@@ -288,6 +339,7 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                             esp_wifi_scan_get_ap_records(&ap_count, ap_records);
                             
                             // Copy to our extended format (limited to 10 entries)
+                            wifi_status_begin();
                             g_wifi_status.scan_count = (ap_count > 10) ? 10 : ap_count;
                             for (int i = 0; i < g_wifi_status.scan_count; i++) {
                                 strncpy(g_wifi_status.scan_results[i].ssid, 
@@ -295,13 +347,14 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                                 g_wifi_status.scan_results[i].rssi = ap_records[i].rssi;
                                 g_wifi_status.scan_results[i].authmode = ap_records[i].authmode;
                             }
+                            wifi_status_commit();
                             
                             free(ap_records);
                         }
                     }
                 }
                 break;
-                
+            
             default:
                 break;
         }
@@ -309,6 +362,11 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
         ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
         ESP_LOGI(TAG, "Got IP address: " IPSTR, IP2STR(&event->ip_info.ip));
         
+        // Get signal strength
+        wifi_ap_record_t ap_info;
+        bool have_ap_info = (esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK);
+        
+        wifi_status_begin();
         g_wifi_status.state = WIFI_STATE_CONNECTED;
         g_wifi_status.connect_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
         
@@ -317,12 +375,10 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
         g_wifi_status.ip_address[1] = esp_ip4_addr2_16(&event->ip_info.ip);
         g_wifi_status.ip_address[2] = esp_ip4_addr3_16(&event->ip_info.ip);
         g_wifi_status.ip_address[3] = esp_ip4_addr4_16(&event->ip_info.ip);
-        
-        // Get signal strength
-        wifi_ap_record_t ap_info;
-        if (esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK) {
+        if (have_ap_info) {
             g_wifi_status.rssi = ap_info.rssi;
         }
+        wifi_status_commit();
         
         s_retry_num = 0;
         xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
@@ -37,7 +37,7 @@ esp_err_t wifi_manager_connect(const char* ssid, const char* password);
 esp_err_t wifi_manager_disconnect(void);
 esp_err_t wifi_manager_scan(void);
 
-wifi_status_t* wifi_manager_get_status(void);
+esp_err_t wifi_manager_get_status(wifi_status_t *status);  // Consistent copy, safe from any task
 bool wifi_manager_is_connected(void);
 
 // Configuration
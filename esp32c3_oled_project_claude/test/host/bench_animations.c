@@ -0,0 +1,55 @@
+#include <ctype.h>
+#include <sys/stat.h>
+#include "bench_common.h"
+#include "animations.h"
+
+// Every registered animation at 30 FPS: time per frame, and the frames
+// written as PBM images for a visual check.
+// Usage: bench_animations [output directory] [frames]
+
+#define FRAME_US    33333
+
+int main(int argc, char **argv)
+{
+    const char *dir = argc > 1 ? argv[1] : "animation_frames";
+    int frames = argc > 2 ? atoi(argv[2]) : 90;
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    size_t arena_size = animations_arena_size();
+    void *arena = malloc(arena_size);
+    animation_t anim;
+    char path[256];
+    char name[48];
+    
+    mkdir(dir, 0755);
+    printf("arena: %u bytes, frames in %s/\n", (unsigned)arena_size, dir);
+    for (int type = ANIM_NONE + 1; type < ANIM_MAX; type++) {
+        const animation_def_t *def = animations_get(type);
+        uint64_t render_ns = 0;
+        
+        // File names from the animation name, e.g. "Matrix Rain" -> matrix_rain
+        size_t len = 0;
+        for (const char *c = def->name; *c && len < sizeof(name) - 1; c++) {
+            name[len++] = isalnum((unsigned char)*c) ? tolower((unsigned char)*c) : '_';
+        }
+        name[len] = '\0';
+        
+        animation_start(&anim, type, arena, arena_size);
+        for (int frame = 0; frame < frames; frame++) {
+            uint64_t start = bench_now_ns();
+            ssd1306_clear_screen(dev, 0);
+            animation_update(&anim, dev, FRAME_US);
+            render_ns += bench_now_ns() - start;
+            
+            ssd1306_refresh_gram(dev);
+            snprintf(path, sizeof(path), "%s/%s_%03d.pbm", dir, name, frame);
+            ssd1306_mem_write_pbm(panel, path);
+        }
+        snprintf(path, sizeof(path), "%s (%u B state)", def->name, (unsigned)def->state_size);
+        bench_report(path, frames, render_ns);
+    }
+    
+    free(arena);
+    ssd1306_delete(dev);
+    return 0;
+}
@@ -0,0 +1,95 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ssd1306.h"
+#include "ssd1306_mem.h"
+
+// Benchmarks print their figures and always succeed; host times are only
+// comparable with each other, not with the target
+
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// One result line: time per operation and operations per second
+static inline void bench_report(const char *name, uint64_t ops, uint64_t elapsed_ns)
+{
+    double per_op = ops ? (double)elapsed_ns / ops : 0;
+    printf("%-36s %12.1f ns/op %14.0f ops/s\n", name, per_op, per_op > 0 ? 1e9 / per_op : 0);
+}
+
+// Keeps a computed value alive without the compiler dropping the work
+static volatile uint32_t bench_sink;
+
+// Initialized panel on the memory transport, first frame sent
+static inline ssd1306_handle_t bench_panel_create(ssd1306_transport_t **ret_panel)
+{
+    if (ssd1306_new_transport_mem(400000, ret_panel) != ESP_OK) {
+        return NULL;
+    }
+    ssd1306_handle_t dev = ssd1306_create_with_transport(*ret_panel);
+    if (dev == NULL || ssd1306_init(dev) != ESP_OK) {
+        return NULL;
+    }
+    ssd1306_refresh_gram(dev);
+    return dev;
+}
+
+// Memory transport that takes as long as the transfer would on the wire
+typedef struct {
+    ssd1306_transport_t base;
+    ssd1306_transport_t *panel;
+} bench_wire_transport_t;
+
+static inline esp_err_t bench_wire_transmit(ssd1306_transport_t *transport, const uint8_t *data, size_t len)
+{
+    bench_wire_transport_t *wire = (bench_wire_transport_t *)transport;
+    ssd1306_mem_stats_t before, after;
+    
+    ssd1306_mem_get_stats(wire->panel, &before);
+    esp_err_t ret = wire->panel->transmit(wire->panel, data, len);
+    ssd1306_mem_get_stats(wire->panel, &after);
+    usleep(after.bus_time_us - before.bus_time_us);
+    return ret;
+}
+
+static inline void bench_wire_del(ssd1306_transport_t *transport)
+{
+    bench_wire_transport_t *wire = (bench_wire_transport_t *)transport;
+    
+    wire->panel->del(wire->panel);
+    free(wire);
+}
+
+// Initialized panel behind a wire-speed transport at bus_hz, first frame sent
+static inline ssd1306_handle_t bench_wire_panel_create(uint32_t bus_hz, ssd1306_transport_t **ret_panel)
+{
+    bench_wire_transport_t *wire = calloc(1, sizeof(*wire));
+    if (wire == NULL || ssd1306_new_transport_mem(bus_hz, &wire->panel) != ESP_OK) {
+        free(wire);
+        return NULL;
+    }
+    wire->base.transmit = bench_wire_transmit;
+    wire->base.del = bench_wire_del;
+    
+    ssd1306_handle_t dev = ssd1306_create_with_transport(&wire->base);
+    if (dev == NULL || ssd1306_init(dev) != ESP_OK) {
+        return NULL;
+    }
+    ssd1306_refresh_gram(dev);
+    if (ret_panel) {
+        *ret_panel = wire->panel;
+    }
+    return dev;
+}
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,62 @@
+#include "bench_common.h"
+#include "display_manager.h"
+
+// CPU time one display_manager_update() spends rendering each mode, with the
+// sensor readings changing every frame. The flush runs on the async task, so
+// the thread CPU time of the caller is the render cost alone.
+
+#define FRAMES      500
+
+static const char *const s_mode_names[DISPLAY_MODE_MAX] = {
+    "clock", "system info", "sensor data", "graph", "network info", "animations", "menu",
+};
+
+static uint64_t thread_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    system_status_t status = {
+        .wifi_ssid = "bench",
+        .wifi_rssi = -60,
+        .wifi_connected = true,
+        .ip_address = "192.168.1.20",
+    };
+    char name[48];
+    
+    ssd1306_enable_async(dev, 5);
+    display_manager_handle_t manager = display_manager_create(dev);
+    
+    for (int mode = 0; mode < DISPLAY_MODE_MAX; mode++) {
+        frame_stats_summary_t summary;
+        uint64_t cpu_ns = 0;
+        
+        display_manager_set_mode(manager, mode);
+        for (int frame = 0; frame < FRAMES; frame++) {
+            status.temperature = 20.0f + (frame % 100) * 0.1f;
+            status.humidity = 40.0f + (frame % 37) * 0.5f;
+            display_manager_update_system_status(&status);
+            
+            uint64_t start = thread_cpu_ns();
+            display_manager_update(manager);
+            cpu_ns += thread_cpu_ns() - start;
+        }
+        ssd1306_wait_flush(dev, 1000);
+        
+        snprintf(name, sizeof(name), "update, %s", s_mode_names[mode]);
+        bench_report(name, FRAMES, cpu_ns);
+        display_manager_get_frame_stats(manager, &summary);
+        printf("%-36s %8u us p99 render, %5u dirty columns p99\n", "",
+               summary.render_us.p99, summary.dirty_columns.p99);
+    }
+    
+    display_manager_delete(manager);
+    ssd1306_delete(dev);
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "bench_common.h"
+#include "menu_system.h"
+
+// Render cost of one menu navigation step: moving within the visible rows,
+// sweeping through a menu longer than the screen, and entering and leaving a
+// submenu, with the bytes each step sends
+
+#define STEPS       20000
+#define ITEMS       12
+
+static const menu_item_t s_items[ITEMS] = {
+    {"Brightness +"}, {"Brightness -"}, {"Contrast"}, {"Timeout"}, {"Overlay"}, {"Rotation"},
+    {"Invert"}, {"Font size"}, {"Scroll speed"}, {"Sleep"}, {"Reset"}, {"< Back"},
+};
+
+static const menu_t s_menu = { "Settings", s_items, ITEMS };
+
+static void bench_steps(const char *name, ssd1306_handle_t dev, ssd1306_transport_t *panel,
+                        void (*step)(int i))
+{
+    ssd1306_mem_stats_t stats;
+    uint64_t render_ns = 0;
+    
+    ssd1306_mem_reset_stats(panel);
+    for (int i = 0; i < STEPS; i++) {
+        step(i);
+        uint64_t start = bench_now_ns();
+        menu_system_display(dev, false);
+        render_ns += bench_now_ns() - start;
+        ssd1306_refresh_gram(dev);
+    }
+    ssd1306_mem_get_stats(panel, &stats);
+    bench_report(name, STEPS, render_ns);
+    printf("  %-34s %12.1f bytes/step\n", name, (double)stats.bytes / STEPS);
+}
+
+// Between the first two rows: no scrolling
+static void step_in_view(int i)
+{
+    if (i & 1) {
+        menu_system_navigate_up();
+    } else {
+        menu_system_navigate_down();
+    }
+}
+
+// End to end and back: past the fourth row each step scrolls
+static void step_sweep(int i)
+{
+    if ((i / (ITEMS - 1)) & 1) {
+        menu_system_navigate_up();
+    } else {
+        menu_system_navigate_down();
+    }
+}
+
+static void step_submenu(int i)
+{
+    if (i & 1) {
+        menu_system_back();
+    } else {
+        menu_system_push(&s_menu);
+    }
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    
+    menu_system_init();
+    menu_system_activate(true);
+    menu_system_push(&s_menu);
+    menu_system_display(dev, true);
+    bench_steps("up/down within view", dev, panel, step_in_view);
+    
+    bench_steps("sweep, 8 of 11 steps scroll", dev, panel, step_sweep);
+    
+    menu_system_back();
+    menu_system_display(dev, false);
+    bench_steps("enter/leave submenu", dev, panel, step_submenu);
+    
+    menu_system_activate(false);
+    ssd1306_delete(dev);
+    return 0;
+}
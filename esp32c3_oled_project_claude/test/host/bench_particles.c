@@ -0,0 +1,74 @@
+#include "bench_common.h"
+#include "particles.h"
+
+// Particle pool cost per particle for a step, point rendering and glyph
+// rendering, and how many particles that leaves room for in a 30 FPS frame.
+// The pool is topped up every frame so it stays full.
+
+#define FRAMES      2000
+#define FRAME_NS    33333333ULL
+
+static const uint8_t s_glyph_data[] = { 0x02, 0x07, 0x02 };
+static const ssd1306_bitmap_t s_glyph = { .width = 3, .height = 3, .data = s_glyph_data };
+
+static const particle_emitter_t s_emitter = {
+    .x = 64 * PARTICLE_ONE,
+    .y = 32 * PARTICLE_ONE,
+    .spread_x = 60 * PARTICLE_ONE,
+    .spread_y = 30 * PARTICLE_ONE,
+    .spread_vx = PARTICLE_ONE,
+    .spread_vy = PARTICLE_ONE,
+    .life = 60,
+    .spread_life = 30,
+};
+
+int main(void)
+{
+    static const uint16_t capacities[] = { 64, 256, 1024, 4096 };
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    char name[48];
+    
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+        uint16_t capacity = capacities[c];
+        particle_pool_t *pool = malloc(PARTICLE_POOL_SIZE(capacity));
+        uint64_t step_ns = 0, points_ns = 0, glyphs_ns = 0, particles = 0;
+        
+        particles_init(pool, capacity, 1);
+        pool->ay = 1;
+        for (int frame = 0; frame < FRAMES; frame++) {
+            particles_emit(pool, &s_emitter, capacity - pool->count);
+            particles += pool->count;
+            
+            uint64_t start = bench_now_ns();
+            particles_step(pool);
+            step_ns += bench_now_ns() - start;
+            
+            ssd1306_clear_screen(dev, 0);
+            start = bench_now_ns();
+            particles_render_points(pool, dev, frame & 0xFF);
+            points_ns += bench_now_ns() - start;
+            
+            ssd1306_clear_screen(dev, 0);
+            start = bench_now_ns();
+            particles_render_glyphs(pool, dev, frame & 0xFF, &s_glyph, SSD1306_ROP_OR);
+            glyphs_ns += bench_now_ns() - start;
+        }
+        
+        snprintf(name, sizeof(name), "step, %u particles", capacity);
+        bench_report(name, particles, step_ns);
+        snprintf(name, sizeof(name), "render points, %u particles", capacity);
+        bench_report(name, particles, points_ns);
+        snprintf(name, sizeof(name), "render glyphs, %u particles", capacity);
+        bench_report(name, particles, glyphs_ns);
+        
+        // Whole 33 ms frame spent on particles, at the measured cost per particle
+        printf("%-36s %12.0f points %12.0f glyphs\n", "  per 30 FPS frame",
+               (double)FRAME_NS * particles / (step_ns + points_ns),
+               (double)FRAME_NS * particles / (step_ns + glyphs_ns));
+        free(pool);
+    }
+    
+    ssd1306_delete(dev);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "bench_common.h"
+#include "sensor_history.h"
+
+// Sensor history cost per call: recording a reading, including the minute and
+// quarter-hour roll-overs it triggers, and every query on a full history
+
+#define INSERTS     2000000
+#define QUERIES     200000
+
+static const char *tier_names[SENSOR_TIER_MAX] = { "raw", "minute", "quarter" };
+static const int tier_lens[SENSOR_TIER_MAX] = {
+    SENSOR_HISTORY_RAW_LEN, SENSOR_HISTORY_MINUTE_LEN, SENSOR_HISTORY_QUARTER_LEN,
+};
+
+static float reading(uint32_t t)
+{
+    return 20.0f + (float)(t % 500) / 100.0f;
+}
+
+int main(void)
+{
+    sensor_bucket_t out[SENSOR_HISTORY_RAW_LEN];
+    sensor_stats_t stats;
+    char name[48];
+    uint32_t t = 0;
+    
+    sensor_history_init();
+    
+    // One reading per second, so every 60th and 900th insert rolls a bucket
+    // over; the inserts alone fill every tier for the queries
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < INSERTS; i++, t++) {
+        sensor_history_add(SENSOR_TEMPERATURE, reading(t), t);
+    }
+    bench_report("insert", INSERTS, bench_now_ns() - start);
+    
+    for (int tier = 0; tier < SENSOR_TIER_MAX; tier++) {
+        start = bench_now_ns();
+        for (int i = 0; i < QUERIES; i++) {
+            bench_sink += sensor_history_read(SENSOR_TEMPERATURE, tier, out, tier_lens[tier]);
+        }
+        snprintf(name, sizeof(name), "read %s, %d entries", tier_names[tier], tier_lens[tier]);
+        bench_report(name, QUERIES, bench_now_ns() - start);
+        
+        start = bench_now_ns();
+        for (int i = 0; i < QUERIES; i++) {
+            bench_sink += sensor_history_stats(SENSOR_TEMPERATURE, tier, tier_lens[tier], &stats);
+        }
+        snprintf(name, sizeof(name), "stats %s, %d entries", tier_names[tier], tier_lens[tier]);
+        bench_report(name, QUERIES, bench_now_ns() - start);
+    }
+    
+    // The graph mode's query: the one reading recorded since the last frame
+    uint32_t seq = 0;
+    sensor_history_read_since(SENSOR_TEMPERATURE, &seq, out, SENSOR_HISTORY_RAW_LEN);
+    uint64_t query_ns = 0;
+    for (int i = 0; i < QUERIES; i++, t++) {
+        sensor_history_add(SENSOR_TEMPERATURE, reading(t), t);
+        start = bench_now_ns();
+        bench_sink += sensor_history_read_since(SENSOR_TEMPERATURE, &seq, out, SENSOR_HISTORY_RAW_LEN);
+        query_ns += bench_now_ns() - start;
+    }
+    bench_report("read_since, 1 new reading", QUERIES, query_ns);
+    
+    return 0;
+}
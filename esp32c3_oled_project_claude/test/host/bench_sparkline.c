@@ -0,0 +1,80 @@
+#include "bench_common.h"
+#include "sparkline.h"
+
+// Render time of a full-width sparkline per frame, for each style: new samples
+// that only scroll, a steep ramp that keeps outgrowing the axis, and a full
+// redraw after a clear. Also the columns drawn and bytes sent per frame.
+
+#define FRAMES      20000
+#define PLOT_H      24
+
+static const char *style_names[] = { "line", "bars" };
+
+// Small steps stay within the axis
+static int16_t sample_scroll(int frame)
+{
+    return (frame * 7) % 41;
+}
+
+// Outgrows the axis padding every few samples; each refit redraws every column
+static int16_t sample_refit(int frame)
+{
+    return (frame % 600) * 50;
+}
+
+static void bench_frames(const char *name, ssd1306_handle_t dev, ssd1306_transport_t *panel,
+                         sparkline_t *spark, int16_t (*sample)(int), bool redraw)
+{
+    ssd1306_mem_stats_t stats;
+    uint64_t render_ns = 0, columns = 0;
+    
+    for (int i = 0; i <= SPARKLINE_MAX_WIDTH; i++) {
+        sparkline_push(spark, sample(i));
+    }
+    sparkline_render(spark, dev);
+    ssd1306_refresh_gram(dev);
+    
+    ssd1306_mem_reset_stats(panel);
+    for (int frame = 0; frame < FRAMES; frame++) {
+        sparkline_push(spark, sample(frame));
+        if (redraw) {
+            sparkline_invalidate(spark);
+        }
+        uint64_t start = bench_now_ns();
+        if (redraw) {
+            ssd1306_clear_screen(dev, 0);
+        }
+        columns += sparkline_render(spark, dev);
+        render_ns += bench_now_ns() - start;
+        ssd1306_refresh_gram(dev);
+    }
+    ssd1306_mem_get_stats(panel, &stats);
+    bench_report(name, FRAMES, render_ns);
+    printf("  %-34s %12.1f columns/frame %8.1f bytes/frame\n", name,
+           (double)columns / FRAMES, (double)stats.bytes / FRAMES);
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    sparkline_t spark;
+    char name[48];
+    
+    for (int style = SPARKLINE_LINE; style <= SPARKLINE_BARS; style++) {
+        sparkline_init(&spark, 0, SSD1306_HEIGHT - PLOT_H, SSD1306_WIDTH, PLOT_H, style, 20);
+        snprintf(name, sizeof(name), "%s, scroll", style_names[style]);
+        bench_frames(name, dev, panel, &spark, sample_scroll, false);
+        
+        sparkline_reset(&spark);
+        snprintf(name, sizeof(name), "%s, ramp refitting the axis", style_names[style]);
+        bench_frames(name, dev, panel, &spark, sample_refit, false);
+        
+        sparkline_reset(&spark);
+        snprintf(name, sizeof(name), "%s, clear and redraw", style_names[style]);
+        bench_frames(name, dev, panel, &spark, sample_scroll, true);
+    }
+    
+    ssd1306_delete(dev);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "bench_common.h"
+
+// Frame period of blocking and double-buffered refresh on a bus that takes
+// real time: full-screen frames at 400 kHz, with a fixed render cost each
+
+#define FRAMES          60
+#define RENDER_US       15000
+
+// Redraw every page, then spin until the render budget is used up
+static void render_frame(ssd1306_handle_t dev, int frame)
+{
+    uint64_t until = bench_now_ns() + RENDER_US * 1000ULL;
+    
+    ssd1306_clear_screen(dev, 0);
+    for (int y = 0; y < SSD1306_HEIGHT; y += 8) {
+        for (int x = 0; x < SSD1306_WIDTH; x++) {
+            ssd1306_draw_point(dev, x, y + frame % 8, 1);
+        }
+    }
+    while (bench_now_ns() < until) {
+        continue;
+    }
+}
+
+static uint64_t run(ssd1306_handle_t dev, bool async)
+{
+    uint64_t start = bench_now_ns();
+    
+    for (int frame = 0; frame < FRAMES; frame++) {
+        render_frame(dev, frame);
+        if (async) {
+            ssd1306_refresh_gram_async(dev);
+        } else {
+            ssd1306_refresh_gram(dev);
+        }
+    }
+    if (async) {
+        ssd1306_wait_flush(dev, 1000);
+    }
+    return bench_now_ns() - start;
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel = NULL;
+    ssd1306_handle_t dev = bench_wire_panel_create(400000, &panel);
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_mem_reset_stats(panel);
+    uint64_t sync_ns = run(dev, false);
+    ssd1306_mem_get_stats(panel, &stats);
+    uint64_t bus_us = stats.bus_time_us / FRAMES;
+    ssd1306_enable_async(dev, 5);
+    uint64_t async_ns = run(dev, true);
+    
+    printf("render %u us, bus %u us per frame\n", RENDER_US, (unsigned)bus_us);
+    bench_report("blocking refresh (per frame)", FRAMES, sync_ns);
+    bench_report("async refresh (per frame)", FRAMES, async_ns);
+    printf("bus time hidden behind rendering: %.0f%%\n",
+           100.0 * (sync_ns - async_ns) / ((double)FRAMES * bus_us * 1000));
+    ssd1306_delete(dev);
+    return 0;
+}
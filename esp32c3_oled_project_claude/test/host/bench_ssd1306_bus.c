@@ -0,0 +1,62 @@
+#include "bench_common.h"
+#include "ssd1306_bus.h"
+
+// Frame latency of panels sharing one 400 kHz bus: one panel redraws the
+// whole screen each frame, the others change a few pixels. With pages
+// interleaved, the small updates should not wait for a full frame to finish.
+
+#define PANELS      3
+#define TICKS       200
+#define TICK_US     10000
+#define FULL_EVERY  4           // The busy panel redraws every 40 ms
+
+int main(void)
+{
+    ssd1306_bus_handle_t bus;
+    ssd1306_handle_t dev[PANELS];
+    ssd1306_bus_stats_t stats;
+    ssd1306_flush_stats_t flush;
+    
+    ssd1306_bus_create(5, &bus);
+    for (int i = 0; i < PANELS; i++) {
+        dev[i] = bench_wire_panel_create(400000, NULL);
+        ssd1306_bus_add_panel(bus, dev[i]);
+    }
+    
+    uint64_t start = bench_now_ns();
+    for (int tick = 0; tick < TICKS; tick++) {
+        if (tick % FULL_EVERY == 0) {
+            ssd1306_clear_screen(dev[0], (tick / FULL_EVERY) & 1 ? 0xFF : 0x00);
+            ssd1306_refresh_gram_async(dev[0]);
+        }
+        for (int i = 1; i < PANELS; i++) {
+            ssd1306_draw_point(dev[i], tick % SSD1306_WIDTH, (tick * 5 + i * 8) % SSD1306_HEIGHT, 1);
+            ssd1306_refresh_gram_async(dev[i]);
+        }
+        uint64_t due = start + (uint64_t)(tick + 1) * TICK_US * 1000;
+        uint64_t now = bench_now_ns();
+        if (now < due) {
+            usleep((due - now) / 1000);
+        }
+    }
+    for (int i = 0; i < PANELS; i++) {
+        ssd1306_wait_flush(dev[i], 1000);
+    }
+    
+    ssd1306_get_flush_stats(dev[0], &flush);
+    printf("full frame on the wire: %u us\n", (unsigned)flush.flush_us);
+    for (int i = 0; i < PANELS; i++) {
+        ssd1306_bus_get_stats(dev[i], &stats);
+        printf("panel %d (%s): %4u frames, latency avg %6u us, max %6u us\n", i,
+               i == 0 ? "full redraws" : "small updates", (unsigned)stats.frames,
+               (unsigned)stats.avg_latency_us, (unsigned)stats.max_latency_us);
+    }
+    
+    for (int i = 1; i < PANELS; i++) {
+        ssd1306_bus_remove_panel(bus, dev[i]);
+        ssd1306_delete(dev[i]);
+    }
+    ssd1306_bus_delete(bus);
+    ssd1306_delete(dev[0]);
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "bench_common.h"
+
+// Page-packed fill primitives against the same shapes drawn point by point
+
+#define ITERATIONS  20000
+
+static void fill_points(ssd1306_handle_t dev, int x, int y, int w, int h, uint8_t mode)
+{
+    for (int j = y; j < y + h; j++) {
+        for (int i = x; i < x + w; i++) {
+            ssd1306_draw_point(dev, i, j, mode);
+        }
+    }
+}
+
+static void bench_rect(ssd1306_handle_t dev, const char *name, int x, int y, int w, int h)
+{
+    char label[48];
+    
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_fill_rect(dev, x, y, w, h, i & 1);
+    }
+    uint64_t fill_ns = bench_now_ns() - start;
+    
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        fill_points(dev, x, y, w, h, i & 1);
+    }
+    uint64_t points_ns = bench_now_ns() - start;
+    
+    snprintf(label, sizeof(label), "%s fill_rect", name);
+    bench_report(label, ITERATIONS, fill_ns);
+    snprintf(label, sizeof(label), "%s point loop", name);
+    bench_report(label, ITERATIONS, points_ns);
+    printf("%-36s %12.1fx\n", "  speedup", (double)points_ns / fill_ns);
+}
+
+static void bench_lines(ssd1306_handle_t dev)
+{
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_draw_hline(dev, 0, i % SSD1306_HEIGHT, SSD1306_WIDTH, i & 1);
+        ssd1306_draw_vline(dev, i % SSD1306_WIDTH, 0, SSD1306_HEIGHT, i & 1);
+    }
+    uint64_t lines_ns = bench_now_ns() - start;
+    
+    start = bench_now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        fill_points(dev, 0, i % SSD1306_HEIGHT, SSD1306_WIDTH, 1, i & 1);
+        fill_points(dev, i % SSD1306_WIDTH, 0, 1, SSD1306_HEIGHT, i & 1);
+    }
+    uint64_t points_ns = bench_now_ns() - start;
+    
+    bench_report("hline+vline", ITERATIONS, lines_ns);
+    bench_report("hline+vline point loop", ITERATIONS, points_ns);
+    printf("%-36s %12.1fx\n", "  speedup", (double)points_ns / lines_ns);
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    
+    bench_rect(dev, "full screen", 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT);
+    bench_rect(dev, "40x20 unaligned", 13, 5, 40, 20);
+    bench_rect(dev, "8x8 aligned", 16, 8, 8, 8);
+    bench_lines(dev);
+    ssd1306_delete(dev);
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "bench_common.h"
+#include "ssd1306_gfx.h"
+
+// Rasterizer and blit throughput: shapes and bitmaps at random coordinates,
+// a quarter of them reaching past the panel edges so the clipping paths are
+// timed too
+
+#define SHAPES      100000
+#define COORDS      1024
+
+static int16_t s_coords[COORDS];
+
+static void random_coords(void)
+{
+    srand(11);
+    for (int i = 0; i < COORDS; i++) {
+        // x and y alternate; roughly one in four falls off the panel
+        int range = (i & 1) ? SSD1306_HEIGHT : SSD1306_WIDTH;
+        s_coords[i] = rand() % (range + range / 2) - range / 4;
+    }
+}
+
+static inline int16_t coord(int i)
+{
+    return s_coords[i % COORDS];
+}
+
+static uint8_t s_sprite_data[32 * 24 / 8];
+static uint8_t s_sprite_mask[32 * 24 / 8];
+
+static const char *const s_rop_names[] = { "copy", "or", "and_not", "xor" };
+
+#define BENCH_SHAPES(name, draw) do { \
+        uint64_t start_ = bench_now_ns(); \
+        for (int i = 0; i < SHAPES; i++) { \
+            draw; \
+        } \
+        bench_report(name, SHAPES, bench_now_ns() - start_); \
+    } while (0)
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    
+    random_coords();
+    BENCH_SHAPES("gfx_line", ssd1306_gfx_line(dev, coord(4 * i), coord(4 * i + 1),
+                                              coord(4 * i + 2), coord(4 * i + 3), i & 1));
+    BENCH_SHAPES("draw_line (on-panel only)", ssd1306_draw_line(dev, coord(4 * i) & 127, coord(4 * i + 1) & 63,
+                                                                coord(4 * i + 2) & 127, coord(4 * i + 3) & 63, i & 1));
+    BENCH_SHAPES("gfx_rect", ssd1306_gfx_rect(dev, coord(2 * i), coord(2 * i + 1), 30, 20, i & 1));
+    BENCH_SHAPES("gfx_fill_rect 30x20", ssd1306_gfx_fill_rect(dev, coord(2 * i), coord(2 * i + 1), 30, 20, i & 1));
+    BENCH_SHAPES("gfx_circle r=12", ssd1306_gfx_circle(dev, coord(2 * i), coord(2 * i + 1), 12, i & 1));
+    BENCH_SHAPES("gfx_fill_circle r=12", ssd1306_gfx_fill_circle(dev, coord(2 * i), coord(2 * i + 1), 12, i & 1));
+    BENCH_SHAPES("gfx_fill_round_rect 30x20 r=4",
+                 ssd1306_gfx_fill_round_rect(dev, coord(2 * i), coord(2 * i + 1), 30, 20, 4, i & 1));
+    BENCH_SHAPES("gfx_triangle", ssd1306_gfx_triangle(dev, coord(6 * i), coord(6 * i + 1), coord(6 * i + 2),
+                                                      coord(6 * i + 3), coord(6 * i + 4), coord(6 * i + 5), i & 1));
+    BENCH_SHAPES("gfx_fill_triangle", ssd1306_gfx_fill_triangle(dev, coord(6 * i), coord(6 * i + 1), coord(6 * i + 2),
+                                                                coord(6 * i + 3), coord(6 * i + 4), coord(6 * i + 5),
+                                                                i & 1));
+    
+    // Random sprites; the mask keeps the top and bottom row of each page opaque
+    for (size_t i = 0; i < sizeof(s_sprite_data); i++) {
+        s_sprite_data[i] = rand();
+        s_sprite_mask[i] = rand() | 0x81;
+    }
+    const ssd1306_bitmap_t sprite8 = { .width = 8, .height = 8, .data = s_sprite_data };
+    const ssd1306_bitmap_t sprite32 = { .width = 32, .height = 24, .data = s_sprite_data };
+    const ssd1306_bitmap_t masked32 = { .width = 32, .height = 24, .data = s_sprite_data, .mask = s_sprite_mask };
+    char name[48];
+    
+    for (int rop = SSD1306_ROP_COPY; rop <= SSD1306_ROP_XOR; rop++) {
+        snprintf(name, sizeof(name), "blit 8x8 %s, aligned, on panel", s_rop_names[rop]);
+        BENCH_SHAPES(name, ssd1306_blit(dev, coord(2 * i) & 0x78, coord(2 * i + 1) & 0x38, &sprite8, rop));
+        snprintf(name, sizeof(name), "blit 8x8 %s", s_rop_names[rop]);
+        BENCH_SHAPES(name, ssd1306_blit(dev, coord(2 * i), coord(2 * i + 1), &sprite8, rop));
+        snprintf(name, sizeof(name), "blit 32x24 %s", s_rop_names[rop]);
+        BENCH_SHAPES(name, ssd1306_blit(dev, coord(2 * i), coord(2 * i + 1), &sprite32, rop));
+    }
+    BENCH_SHAPES("blit 32x24 copy, masked", ssd1306_blit(dev, coord(2 * i), coord(2 * i + 1), &masked32,
+                                                         SSD1306_ROP_COPY));
+    ssd1306_delete(dev);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "bench_common.h"
+#include "font8x16_rows.h"
+
+// Glyph rendering throughput for each built-in font, on page-aligned rows and
+// on rows that straddle two pages, plus whole strings and text measurement.
+// ssd1306_show_string() in the 8x16 size is compared with the renderer it
+// replaced, which set each pixel of the row-major font with draw_point.
+
+#define GLYPHS      200000
+#define STRINGS     20000
+
+static const char s_text[] = "Temp 23.5C Hum 41%";
+static const char s_line[] = "Temp 23.5C H 41%";      // One 8x16 line, 16 glyphs
+
+// The 8x16 renderer before the column-major font, for one line of text
+static void show_string_points(ssd1306_handle_t dev, uint8_t x, uint8_t y, const char *text)
+{
+    for (; *text; text++, x += 8) {
+        const uint8_t *rows = font8x16_rows[*text - ' '];
+        for (int row = 0; row < 16; row++) {
+            for (int col = 0; col < 8; col++) {
+                if (rows[row] & (0x80 >> col)) {
+                    ssd1306_draw_point(dev, x + col, y + row, 1);
+                }
+            }
+        }
+    }
+}
+
+static void bench_show_string(ssd1306_handle_t dev, const char *name, uint8_t y)
+{
+    char label[48];
+    uint64_t glyphs = (uint64_t)STRINGS * (sizeof(s_line) - 1);
+    
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < STRINGS; i++) {
+        ssd1306_show_string(dev, 0, y, s_line, 16, 1);
+    }
+    uint64_t blit_ns = bench_now_ns() - start;
+    
+    start = bench_now_ns();
+    for (int i = 0; i < STRINGS; i++) {
+        show_string_points(dev, 0, y, s_line);
+    }
+    uint64_t points_ns = bench_now_ns() - start;
+    
+    snprintf(label, sizeof(label), "show_string size 16, %s", name);
+    bench_report(label, glyphs, blit_ns);
+    snprintf(label, sizeof(label), "point loop size 16, %s", name);
+    bench_report(label, glyphs, points_ns);
+    printf("%-36s %12.1fx\n", "  speedup", (double)points_ns / blit_ns);
+}
+
+static void bench_glyphs(const char *name, ssd1306_handle_t dev, const ssd1306_font_t *font, uint8_t y)
+{
+    uint8_t x = 0;
+    
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < GLYPHS; i++) {
+        x += ssd1306_draw_glyph(dev, x, y, ' ' + i % 95, font, 1);
+        if (x > SSD1306_WIDTH - 8) {
+            x = 0;
+        }
+    }
+    bench_report(name, GLYPHS, bench_now_ns() - start);
+}
+
+static void bench_strings(const char *name, ssd1306_handle_t dev, const ssd1306_font_t *font)
+{
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < STRINGS; i++) {
+        ssd1306_show_string_font(dev, 0, 24, s_text, font, 1);
+    }
+    bench_report(name, STRINGS, bench_now_ns() - start);
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    
+    bench_show_string(dev, "page aligned", 16);
+    bench_show_string(dev, "unaligned", 19);
+    
+    bench_glyphs("8x16 glyph, page aligned", dev, &ssd1306_font_8x16, 16);
+    bench_glyphs("8x16 glyph, unaligned", dev, &ssd1306_font_8x16, 19);
+    bench_glyphs("6x8 glyph, page aligned", dev, &ssd1306_font_6x8, 16);
+    bench_glyphs("6x8 glyph, unaligned", dev, &ssd1306_font_6x8, 19);
+    bench_glyphs("prop8 glyph, page aligned", dev, &ssd1306_font_prop8, 16);
+    bench_glyphs("prop8 glyph, unaligned", dev, &ssd1306_font_prop8, 19);
+    
+    bench_strings("18-char string, 8x16", dev, &ssd1306_font_8x16);
+    bench_strings("18-char string, prop8", dev, &ssd1306_font_prop8);
+    
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < STRINGS; i++) {
+        bench_sink += ssd1306_text_width(&ssd1306_font_prop8, s_text);
+    }
+    bench_report("18-char text_width, prop8", STRINGS, bench_now_ns() - start);
+    ssd1306_delete(dev);
+    return 0;
+}
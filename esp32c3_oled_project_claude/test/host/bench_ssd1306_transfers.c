@@ -0,0 +1,81 @@
+#include "bench_common.h"
+
+// Bus transactions, heap allocations and CPU time per refresh for a few
+// typical frames. Allocations are counted by wrapping malloc at link time.
+
+#define FRAMES      2000
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+static uint32_t s_allocs;
+
+void *__wrap_malloc(size_t size)
+{
+    s_allocs++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size)
+{
+    s_allocs++;
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    s_allocs++;
+    return __real_realloc(ptr, size);
+}
+
+typedef void (*draw_fn_t)(ssd1306_handle_t dev, int frame);
+
+static void draw_full(ssd1306_handle_t dev, int frame)
+{
+    ssd1306_clear_screen(dev, (frame & 1) ? 0xFF : 0x00);
+}
+
+static void draw_pixel(ssd1306_handle_t dev, int frame)
+{
+    ssd1306_draw_point(dev, 64, 32, frame & 1);
+}
+
+static void draw_scattered(ssd1306_handle_t dev, int frame)
+{
+    for (int i = 0; i < 8; i++) {
+        ssd1306_draw_point(dev, (frame / 2 * 7 + i * 37) % SSD1306_WIDTH, i * 8 + frame / 2 % 8, !(frame & 1));
+    }
+}
+
+static void run(const char *name, ssd1306_handle_t dev, ssd1306_transport_t *panel, draw_fn_t draw)
+{
+    ssd1306_mem_stats_t stats;
+    uint64_t refresh_ns = 0;
+    
+    ssd1306_mem_reset_stats(panel);
+    s_allocs = 0;
+    for (int frame = 0; frame < FRAMES; frame++) {
+        draw(dev, frame);
+        uint64_t start = bench_now_ns();
+        ssd1306_refresh_gram(dev);
+        refresh_ns += bench_now_ns() - start;
+    }
+    ssd1306_mem_get_stats(panel, &stats);
+    
+    printf("%-12s %5.2f transfers, %7.1f bytes, %4.2f allocations per frame\n", name,
+           (double)stats.transfers / FRAMES, (double)stats.bytes / FRAMES, (double)s_allocs / FRAMES);
+    bench_report("  refresh_gram", FRAMES, refresh_ns);
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    
+    run("full frame", dev, panel, draw_full);
+    run("one pixel", dev, panel, draw_pixel);
+    run("scattered", dev, panel, draw_scattered);
+    ssd1306_delete(dev);
+    return 0;
+}
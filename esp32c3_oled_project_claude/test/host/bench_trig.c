@@ -0,0 +1,97 @@
+#include <math.h>
+#include "bench_common.h"
+#include "animations.h"
+#include "trig.h"
+
+// Table trigonometry against libm, per call and per frame of the wave and
+// spiral animations. The host has an FPU, so the gap on the ESP32-C3, which
+// emulates floating point, is larger than shown here.
+
+#define CALLS       10000000
+#define FRAMES      100000
+
+// The float renderers the table versions replaced, frame = time_ms / 100
+static void float_wave_render(ssd1306_handle_t display, int frame)
+{
+    for (int x = 0; x < 128; x++) {
+        int y1 = 32 + 20 * sin((x + frame * 2) * 0.1);
+        int y2 = 32 + 15 * sin((x + frame * 3) * 0.08 + 1);
+        ssd1306_draw_point(display, x, y1, 1);
+        ssd1306_draw_point(display, x, y2, 1);
+    }
+    for (int i = 0; i < 5; i++) {
+        int x = (frame * 2 + i * 25) % 128;
+        int y = 32 + 10 * sin((x + frame) * 0.15 + i);
+        ssd1306_draw_point(display, x, y, 1);
+    }
+}
+
+static void float_spiral_render(ssd1306_handle_t display, int frame)
+{
+    for (float angle = 0; angle < 6.28 * 3; angle += 0.2) {
+        float radius = angle * 3 + frame * 0.5;
+        if (radius > 40) continue;
+        
+        int x = 64 + radius * cos(angle);
+        int y = 32 + radius * sin(angle);
+        if (x >= 0 && x < 128 && y >= 0 && y < 64) {
+            ssd1306_draw_point(display, x, y, 1);
+        }
+    }
+}
+
+static void bench_table_frames(const char *name, ssd1306_handle_t dev, animation_type_t type)
+{
+    const animation_def_t *def = animations_get(type);
+    
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        // Spirals regrow every 8 s so every frame draws points
+        def->render(NULL, NULL, 0, dev, i * 100 % 8000);
+    }
+    bench_report(name, FRAMES, bench_now_ns() - start);
+}
+
+int main(void)
+{
+    ssd1306_transport_t *panel;
+    ssd1306_handle_t dev = bench_panel_create(&panel);
+    uint64_t start;
+    int32_t sum = 0;
+    
+    start = bench_now_ns();
+    for (int i = 0; i < CALLS; i++) {
+        sum += trig_sin(i * 40503u);
+    }
+    bench_report("trig_sin", CALLS, bench_now_ns() - start);
+    
+    start = bench_now_ns();
+    for (int i = 0; i < CALLS; i++) {
+        sum += (int32_t)(32767 * sin((uint16_t)(i * 40503u) / TRIG_ANGLE_PER_RAD));
+    }
+    bench_report("sin (double)", CALLS, bench_now_ns() - start);
+    
+    start = bench_now_ns();
+    for (int i = 0; i < CALLS; i++) {
+        sum += (int32_t)(32767 * sinf((uint16_t)(i * 40503u) / (float)TRIG_ANGLE_PER_RAD));
+    }
+    bench_report("sinf", CALLS, bench_now_ns() - start);
+    bench_sink = sum;
+    
+    bench_table_frames("wave frame, table", dev, ANIM_WAVE);
+    start = bench_now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        float_wave_render(dev, i);
+    }
+    bench_report("wave frame, double", FRAMES, bench_now_ns() - start);
+    
+    bench_table_frames("spiral frame, table", dev, ANIM_SPIRAL);
+    start = bench_now_ns();
+    for (int i = 0; i < FRAMES; i++) {
+        float_spiral_render(dev, i % 80);
+    }
+    bench_report("spiral frame, double", FRAMES, bench_now_ns() - start);
+    
+    ssd1306_delete(dev);
+    return 0;
+}
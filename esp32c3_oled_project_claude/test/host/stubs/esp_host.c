@@ -0,0 +1,244 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "esp_err.h"
+#include "esp_random.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "driver/i2c_master.h"
+#include "nvs_flash.h"
+
+struct esp_timer {
+    esp_timer_create_args_t args;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint64_t period_us;
+    bool periodic;
+    bool active;
+};
+
+static atomic_uint s_timer_expiries;
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+        case ESP_OK:                return "ESP_OK";
+        case ESP_FAIL:              return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+        default:                    return "UNKNOWN ERROR";
+    }
+}
+
+// Figures in the range of an ESP32-C3 running the application
+uint32_t esp_get_free_heap_size(void)
+{
+    return 200 * 1024;
+}
+
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    return 180 * 1024;
+}
+
+void esp_restart(void)
+{
+    // Nothing should restart during a test
+    fprintf(stderr, "esp_restart() called\n");
+    abort();
+}
+
+uint32_t esp_random(void)
+{
+    // Deterministic, so test runs repeat; xorshift32
+    static uint32_t state = 0x12345678;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void timespec_add_us(struct timespec *ts, uint64_t us)
+{
+    ts->tv_sec += us / 1000000;
+    ts->tv_nsec += (long)(us % 1000000) * 1000;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+// Runs the callback at each expiry until the timer is stopped
+static void *timer_thread(void *arg)
+{
+    esp_timer_handle_t timer = arg;
+    struct timespec due;
+    
+    pthread_mutex_lock(&timer->lock);
+    clock_gettime(CLOCK_MONOTONIC, &due);
+    while (timer->active) {
+        timespec_add_us(&due, timer->period_us);
+        while (timer->active && pthread_cond_timedwait(&timer->cond, &timer->lock, &due) == 0) {
+            continue;
+        }
+        if (!timer->active) {
+            break;
+        }
+        timer->active = timer->periodic;
+        pthread_mutex_unlock(&timer->lock);
+        s_timer_expiries++;
+        timer->args.callback(timer->args.arg);
+        pthread_mutex_lock(&timer->lock);
+    }
+    pthread_mutex_unlock(&timer->lock);
+    return NULL;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle)
+{
+    if (args == NULL || args->callback == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    esp_timer_handle_t timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&timer->lock, NULL);
+    timer->args = *args;
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+static esp_err_t timer_start(esp_timer_handle_t timer, uint64_t period_us, bool periodic)
+{
+    if (timer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (timer->active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // A one-shot timer that already fired leaves its thread behind to reap
+    if (timer->thread) {
+        pthread_join(timer->thread, NULL);
+        timer->thread = 0;
+    }
+    timer->period_us = period_us;
+    timer->periodic = periodic;
+    timer->active = true;
+    if (pthread_create(&timer->thread, NULL, timer_thread, timer) != 0) {
+        timer->active = false;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    return timer_start(timer, timeout_us, false);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us)
+{
+    return timer_start(timer, period_us, true);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (timer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    pthread_mutex_lock(&timer->lock);
+    bool was_active = timer->active;
+    timer->active = false;
+    pthread_cond_broadcast(&timer->cond);
+    pthread_mutex_unlock(&timer->lock);
+    
+    if (timer->thread) {
+        pthread_join(timer->thread, NULL);
+        timer->thread = 0;
+    }
+    return was_active ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (timer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (timer->active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (timer->thread) {
+        pthread_join(timer->thread, NULL);
+    }
+    pthread_cond_destroy(&timer->cond);
+    pthread_mutex_destroy(&timer->lock);
+    free(timer);
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer)
+{
+    return timer && timer->active;
+}
+
+uint32_t host_esp_timer_expiries(void)
+{
+    return s_timer_expiries;
+}
+
+// There is no I2C bus on the host; tests use the memory transport
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config,
+                                    i2c_master_dev_handle_t *ret_handle)
+{
+    (void)bus_handle;
+    (void)dev_config;
+    (void)ret_handle;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle)
+{
+    (void)handle;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, size_t write_size,
+                              int xfer_timeout_ms)
+{
+    (void)handle;
+    (void)write_buffer;
+    (void)write_size;
+    (void)xfer_timeout_ms;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    return ESP_OK;
+}
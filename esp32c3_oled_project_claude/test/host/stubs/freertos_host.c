@@ -0,0 +1,406 @@
+#define _GNU_SOURCE     // PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+// Every task is a detached pthread; blocking calls wait on a condition
+// variable with an absolute CLOCK_MONOTONIC deadline
+
+struct host_task {
+    pthread_t thread;
+    TaskFunction_t entry;
+    void *arg;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t value;
+    bool pending;
+};
+
+struct host_semaphore {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    unsigned count;
+    unsigned max;
+};
+
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t *items;
+    size_t item_size;
+    size_t length;
+    size_t head;
+    size_t count;
+};
+
+static struct host_task s_main_task;     // Any thread not started by xTaskCreate()
+static atomic_int s_created_tasks;       // Started by xTaskCreate() and not deleted
+static pthread_once_t s_main_once = PTHREAD_ONCE_INIT;
+static __thread struct host_task *s_current;
+static atomic_uint s_tick_offset;       // Added by host_advance_ticks()
+static pthread_mutex_t s_critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static void cond_init(pthread_mutex_t *lock, pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    
+    pthread_mutex_init(lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static void deadline_after(TickType_t ticks, struct timespec *deadline)
+{
+    uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000ULL;
+    
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += ns / 1000000000ULL;
+    deadline->tv_nsec += ns % 1000000000ULL;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+// Wait for a broadcast on cond with the lock held; false once the deadline has passed
+static bool cond_wait_until(pthread_mutex_t *lock, pthread_cond_t *cond, TickType_t ticks,
+                            const struct timespec *deadline)
+{
+    if (ticks == 0) {
+        return false;
+    }
+    if (ticks == portMAX_DELAY) {
+        pthread_cond_wait(cond, lock);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, lock, deadline) != ETIMEDOUT;
+}
+
+void host_enter_critical(void)
+{
+    pthread_mutex_lock(&s_critical);
+}
+
+void host_exit_critical(void)
+{
+    pthread_mutex_unlock(&s_critical);
+}
+
+static void *task_entry(void *arg)
+{
+    s_current = arg;
+    s_current->entry(s_current->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stack_depth, void *arg,
+                       UBaseType_t priority, TaskHandle_t *created_task)
+{
+    (void)name;
+    (void)stack_depth;
+    (void)priority;
+    
+    struct host_task *t = calloc(1, sizeof(*t));
+    if (t == NULL) {
+        return pdFAIL;
+    }
+    t->entry = task;
+    t->arg = arg;
+    cond_init(&t->lock, &t->cond);
+    if (created_task) {
+        *created_task = t;
+    }
+    if (pthread_create(&t->thread, NULL, task_entry, t) != 0) {
+        free(t);
+        return pdFAIL;
+    }
+    pthread_detach(t->thread);
+    atomic_fetch_add(&s_created_tasks, 1);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // Another task stops at its next blocking call. The task struct is leaked
+    // like a zombie TCB, and a cancelled task leaves its lock held.
+    if (task == NULL || task == s_current) {
+        if (s_current) {
+            atomic_fetch_sub(&s_created_tasks, 1);
+        }
+        pthread_exit(NULL);
+    }
+    if (task != &s_main_task) {
+        atomic_fetch_sub(&s_created_tasks, 1);
+        pthread_cancel(task->thread);
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec ts = {
+        .tv_sec = ticks * portTICK_PERIOD_MS / 1000,
+        .tv_nsec = (long)(ticks * portTICK_PERIOD_MS % 1000) * 1000000L,
+    };
+    nanosleep(&ts, NULL);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)((ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000) / portTICK_PERIOD_MS) + s_tick_offset;
+}
+
+void host_advance_ticks(TickType_t ticks)
+{
+    s_tick_offset += ticks;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void)
+{
+    // The main thread plus the tasks still running
+    return 1 + atomic_load(&s_created_tasks);
+}
+
+static void main_task_init(void)
+{
+    cond_init(&s_main_task.lock, &s_main_task.cond);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (s_current) {
+        return s_current;
+    }
+    pthread_once(&s_main_once, main_task_init);
+    return &s_main_task;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+    pthread_mutex_lock(&task->lock);
+    switch (action) {
+        case eSetBits:
+            task->value |= value;
+            break;
+        case eIncrement:
+            task->value++;
+            break;
+        case eSetValueWithOverwrite:
+            task->value = value;
+            break;
+        case eSetValueWithoutOverwrite:
+            if (!task->pending) {
+                task->value = value;
+            }
+            break;
+        case eNoAction:
+            break;
+    }
+    task->pending = true;
+    pthread_cond_broadcast(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t *woken)
+{
+    if (woken) {
+        *woken = pdTRUE;
+    }
+    return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t ticks)
+{
+    struct host_task *t = xTaskGetCurrentTaskHandle();
+    
+    struct timespec deadline;
+    
+    deadline_after(ticks, &deadline);
+    pthread_mutex_lock(&t->lock);
+    t->value &= ~clear_on_entry;
+    while (!t->pending && cond_wait_until(&t->lock, &t->cond, ticks, &deadline)) {
+        continue;
+    }
+    bool notified = t->pending;
+    if (value) {
+        *value = t->value;
+    }
+    if (notified) {
+        t->value &= ~clear_on_exit;
+        t->pending = false;
+    }
+    pthread_mutex_unlock(&t->lock);
+    return notified ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken)
+{
+    xTaskNotifyFromISR(task, 0, eIncrement, woken);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    struct host_task *t = xTaskGetCurrentTaskHandle();
+    
+    struct timespec deadline;
+    
+    deadline_after(ticks, &deadline);
+    pthread_mutex_lock(&t->lock);
+    while (t->value == 0 && cond_wait_until(&t->lock, &t->cond, ticks, &deadline)) {
+        continue;
+    }
+    uint32_t value = t->value;
+    if (value) {
+        t->value = clear_on_exit ? 0 : value - 1;
+    }
+    t->pending = false;
+    pthread_mutex_unlock(&t->lock);
+    return value;
+}
+
+static SemaphoreHandle_t semaphore_create(unsigned count, unsigned max)
+{
+    struct host_semaphore *sem = calloc(1, sizeof(*sem));
+    if (sem) {
+        cond_init(&sem->lock, &sem->cond);
+        sem->count = count;
+        sem->max = max;
+    }
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return semaphore_create(0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return semaphore_create(1, 1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    struct timespec deadline;
+    
+    deadline_after(ticks, &deadline);
+    pthread_mutex_lock(&sem->lock);
+    while (sem->count == 0 && cond_wait_until(&sem->lock, &sem->cond, ticks, &deadline)) {
+        continue;
+    }
+    bool taken = sem->count > 0;
+    if (taken) {
+        sem->count--;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return taken ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    pthread_mutex_lock(&sem->lock);
+    bool given = sem->count < sem->max;
+    if (given) {
+        sem->count++;
+        pthread_cond_broadcast(&sem->cond);
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return given ? pdTRUE : pdFALSE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->lock);
+    free(sem);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct host_queue *queue = calloc(1, sizeof(*queue));
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->items = malloc(length * item_size);
+    if (queue->items == NULL) {
+        free(queue);
+        return NULL;
+    }
+    cond_init(&queue->lock, &queue->cond);
+    queue->item_size = item_size;
+    queue->length = length;
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    struct timespec deadline;
+    
+    deadline_after(ticks, &deadline);
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->length && cond_wait_until(&queue->lock, &queue->cond, ticks, &deadline)) {
+        continue;
+    }
+    bool sent = queue->count < queue->length;
+    if (sent) {
+        size_t slot = (queue->head + queue->count) % queue->length;
+        memcpy(queue->items + slot * queue->item_size, item, queue->item_size);
+        queue->count++;
+        pthread_cond_broadcast(&queue->cond);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return sent ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *woken)
+{
+    if (woken) {
+        *woken = pdTRUE;
+    }
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    struct timespec deadline;
+    
+    deadline_after(ticks, &deadline);
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0 && cond_wait_until(&queue->lock, &queue->cond, ticks, &deadline)) {
+        continue;
+    }
+    bool received = queue->count > 0;
+    if (received) {
+        memcpy(item, queue->items + queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        pthread_cond_broadcast(&queue->cond);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return received ? pdTRUE : pdFALSE;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    pthread_cond_destroy(&queue->cond);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->items);
+    free(queue);
+}
@@ -0,0 +1,110 @@
+#include <stddef.h>
+#include "driver/gpio.h"
+
+typedef struct {
+    volatile int level;
+    bool pull_up;
+    gpio_isr_t handler;
+    void *arg;
+    esp_err_t add_err;          // Next gpio_isr_handler_add() result
+} host_pin_t;
+
+static host_pin_t s_pins[GPIO_PIN_COUNT];
+static bool s_isr_service;
+static esp_err_t s_isr_service_err = ESP_OK;
+
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+    if (config == NULL || config->pin_bit_mask == 0 || (config->pin_bit_mask >> GPIO_PIN_COUNT) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // A pulled-up input idles high, anything else low
+    for (int gpio = 0; gpio < GPIO_PIN_COUNT; gpio++) {
+        if ((config->pin_bit_mask >> gpio) & 1) {
+            s_pins[gpio].pull_up = config->pull_up_en == GPIO_PULLUP_ENABLE;
+            s_pins[gpio].level = s_pins[gpio].pull_up;
+        }
+    }
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio)
+{
+    return (gpio >= 0 && gpio < GPIO_PIN_COUNT) ? s_pins[gpio].level : 0;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    (void)intr_alloc_flags;
+    
+    esp_err_t err = s_isr_service_err;
+    s_isr_service_err = ESP_OK;
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (s_isr_service) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_isr_service = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t handler, void *arg)
+{
+    if (!s_isr_service) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (gpio < 0 || gpio >= GPIO_PIN_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = s_pins[gpio].add_err;
+    s_pins[gpio].add_err = ESP_OK;
+    if (err != ESP_OK) {
+        return err;
+    }
+    s_pins[gpio].arg = arg;
+    s_pins[gpio].handler = handler;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio)
+{
+    if (!s_isr_service) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (gpio < 0 || gpio >= GPIO_PIN_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_pins[gpio].handler = NULL;
+    s_pins[gpio].arg = NULL;
+    return ESP_OK;
+}
+
+void host_gpio_set_level(gpio_num_t gpio, int level)
+{
+    s_pins[gpio].level = level;
+    if (s_pins[gpio].handler) {
+        s_pins[gpio].handler(s_pins[gpio].arg);
+    }
+}
+
+bool host_gpio_pulled_up(gpio_num_t gpio)
+{
+    return s_pins[gpio].pull_up;
+}
+
+void host_gpio_fail_isr_service(esp_err_t err)
+{
+    s_isr_service_err = err;
+}
+
+void host_gpio_fail_isr_handler(gpio_num_t gpio, esp_err_t err)
+{
+    s_pins[gpio].add_err = err;
+}
+
+bool host_gpio_has_handler(gpio_num_t gpio)
+{
+    return s_pins[gpio].handler != NULL;
+}
@@ -0,0 +1,56 @@
+#ifndef GPIO_H
+#define GPIO_H
+
+// Host stand-in: simulated input pins whose levels tests set, calling the
+// installed ISR handler the way an edge interrupt would
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#define GPIO_PIN_COUNT              32
+
+typedef int gpio_num_t;
+typedef void (*gpio_isr_t)(void *arg);
+
+typedef enum {
+    GPIO_MODE_INPUT = 1,
+} gpio_mode_t;
+
+typedef enum {
+    GPIO_PULLUP_DISABLE = 0,
+    GPIO_PULLUP_ENABLE,
+} gpio_pullup_t;
+
+typedef enum {
+    GPIO_PULLDOWN_DISABLE = 0,
+    GPIO_PULLDOWN_ENABLE,
+} gpio_pulldown_t;
+
+typedef enum {
+    GPIO_INTR_DISABLE = 0,
+    GPIO_INTR_ANYEDGE = 3,
+} gpio_int_type_t;
+
+typedef struct {
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    gpio_pullup_t pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+esp_err_t gpio_config(const gpio_config_t *config);
+int gpio_get_level(gpio_num_t gpio);
+esp_err_t gpio_install_isr_service(int intr_alloc_flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t handler, void *arg);
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio);
+
+// Test controls
+void host_gpio_set_level(gpio_num_t gpio, int level);   // Runs the pin's ISR handler, if any
+bool host_gpio_pulled_up(gpio_num_t gpio);
+void host_gpio_fail_isr_service(esp_err_t err);         // Next gpio_install_isr_service() result
+void host_gpio_fail_isr_handler(gpio_num_t gpio, esp_err_t err);   // Next gpio_isr_handler_add() result for gpio
+bool host_gpio_has_handler(gpio_num_t gpio);
+
+#endif // GPIO_H
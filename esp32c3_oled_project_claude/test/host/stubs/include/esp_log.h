@@ -0,0 +1,14 @@
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+// Host stand-in: errors and warnings go to stderr, the rest is compiled but not printed
+
+#include <stdio.h>
+
+#define ESP_LOGE(tag, fmt, ...)     fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)     fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...)     do { if (0) printf("%s" fmt, tag, ##__VA_ARGS__); } while (0)
+#define ESP_LOGD(tag, fmt, ...)     do { if (0) printf("%s" fmt, tag, ##__VA_ARGS__); } while (0)
+#define ESP_LOGV(tag, fmt, ...)     do { if (0) printf("%s" fmt, tag, ##__VA_ARGS__); } while (0)
+
+#endif // ESP_LOG_H
@@ -0,0 +1,12 @@
+#ifndef ESP_SYSTEM_H
+#define ESP_SYSTEM_H
+
+// Host stand-in: fixed heap figures, and a restart that ends the process
+
+#include <stdint.h>
+
+uint32_t esp_get_free_heap_size(void);
+uint32_t esp_get_minimum_free_heap_size(void);
+void esp_restart(void) __attribute__((noreturn));
+
+#endif // ESP_SYSTEM_H
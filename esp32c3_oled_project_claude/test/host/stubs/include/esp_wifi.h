@@ -0,0 +1,14 @@
+#ifndef ESP_WIFI_H
+#define ESP_WIFI_H
+
+// Host stand-in: only the types the WiFi manager's interface uses
+
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+} wifi_auth_mode_t;
+
+#endif // ESP_WIFI_H
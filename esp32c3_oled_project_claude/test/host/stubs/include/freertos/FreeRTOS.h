@@ -0,0 +1,44 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+// Host stand-in for the FreeRTOS subset the components use, backed by pthreads
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdTRUE                      1
+#define pdFALSE                     0
+#define pdPASS                      pdTRUE
+#define pdFAIL                      pdFALSE
+
+#define configTICK_RATE_HZ          1000
+#define configMAX_PRIORITIES        25
+#define portTICK_PERIOD_MS          (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY               ((TickType_t)0xFFFFFFFF)
+#define pdMS_TO_TICKS(ms)           ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define portYIELD_FROM_ISR(woken)   ((void)(woken))
+
+// Critical sections lock one process-wide recursive mutex
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { 0 }
+#define portMUX_INITIALIZE(mux)         ((mux)->unused = 0)
+
+void host_enter_critical(void);
+void host_exit_critical(void);
+
+#define portENTER_CRITICAL(mux)         ((void)(mux), host_enter_critical())
+#define portEXIT_CRITICAL(mux)          ((void)(mux), host_exit_critical())
+#define portENTER_CRITICAL_ISR(mux)     portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux)      portEXIT_CRITICAL(mux)
+#define taskENTER_CRITICAL(mux)         portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux)          portEXIT_CRITICAL(mux)
+
+#endif // FREERTOS_H
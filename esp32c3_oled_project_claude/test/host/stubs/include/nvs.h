@@ -0,0 +1,8 @@
+#ifndef NVS_H
+#define NVS_H
+
+// Host stand-in: nothing on the host reads or writes NVS
+
+#include "esp_err.h"
+
+#endif // NVS_H
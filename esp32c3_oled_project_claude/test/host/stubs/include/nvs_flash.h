@@ -0,0 +1,8 @@
+#ifndef NVS_FLASH_H
+#define NVS_FLASH_H
+
+#include "esp_err.h"
+
+esp_err_t nvs_flash_erase(void);
+
+#endif // NVS_FLASH_H
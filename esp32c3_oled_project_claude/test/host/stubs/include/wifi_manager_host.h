@@ -0,0 +1,11 @@
+#ifndef WIFI_MANAGER_HOST_H
+#define WIFI_MANAGER_HOST_H
+
+// Test controls of the WiFi manager stand-in (stubs/wifi_manager_host.c)
+
+#include "wifi_manager.h"
+
+void host_wifi_set_status(const wifi_status_t *status);    // Returned by wifi_manager_get_status()
+int host_wifi_scan_count(void);                             // wifi_manager_scan() calls so far
+
+#endif // WIFI_MANAGER_HOST_H
@@ -0,0 +1,48 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "wifi_manager_host.h"
+
+// WiFi manager stand-in: there is no radio, the status is whatever a test set
+
+static wifi_status_t s_status;
+static int s_scans;
+
+esp_err_t wifi_manager_get_status(wifi_status_t *status)
+{
+    if (status == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    host_enter_critical();
+    *status = s_status;
+    host_exit_critical();
+    return ESP_OK;
+}
+
+bool wifi_manager_is_connected(void)
+{
+    return s_status.state == WIFI_STATE_CONNECTED;
+}
+
+esp_err_t wifi_manager_scan(void)
+{
+    s_scans++;
+    return ESP_OK;
+}
+
+esp_err_t wifi_manager_disconnect(void)
+{
+    s_status.state = WIFI_STATE_DISCONNECTED;
+    return ESP_OK;
+}
+
+void host_wifi_set_status(const wifi_status_t *status)
+{
+    host_enter_critical();
+    s_status = *status;
+    host_exit_critical();
+}
+
+int host_wifi_scan_count(void)
+{
+    return s_scans;
+}
@@ -0,0 +1,192 @@
+#include "test_common.h"
+#include "animations.h"
+
+// Animation registry, the shared state arena, and fixed-step timing
+
+#define GUARD       64
+#define GUARD_BYTE  0xA5
+#define TOTAL_US    9600000     // Animation time every frame sequence adds up to
+#define MAX_STATE   64
+
+// Where an animation ends up after a sequence of frame intervals
+typedef struct {
+    uint32_t steps;
+    uint32_t acc_us;
+    uint8_t state[MAX_STATE];
+    uint8_t prev[MAX_STATE];
+    uint8_t frame[SSD1306_BUFFER_SIZE];
+} run_result_t;
+
+typedef uint32_t (*interval_fn_t)(int frame, uint32_t remaining_us);
+
+static void test_arena_fits_every_animation(void)
+{
+    size_t arena_size = animations_arena_size();
+    size_t largest = 0;
+    
+    TEST_CHECK(animations_get(ANIM_NONE) == NULL);
+    TEST_CHECK(animations_get(ANIM_MAX) == NULL);
+    for (int type = ANIM_NONE + 1; type < ANIM_MAX; type++) {
+        const animation_def_t *def = animations_get(type);
+        TEST_CHECK(def != NULL);
+        if (def == NULL) {
+            continue;
+        }
+        TEST_CHECK(def->name != NULL);
+        TEST_CHECK(def->render != NULL);
+        TEST_CHECK(ANIMATION_ARENA_SIZE(def->state_size) <= arena_size);
+        if (ANIMATION_ARENA_SIZE(def->state_size) > largest) {
+            largest = ANIMATION_ARENA_SIZE(def->state_size);
+        }
+    }
+    
+    // The bound is tight: current and previous state of the largest animation
+    TEST_CHECK_EQ(largest, arena_size);
+    
+    // Padding only where the size is not already a multiple of the alignment
+    TEST_CHECK_EQ(2 * ANIMATION_STATE_ALIGN, ANIMATION_ARENA_SIZE(ANIMATION_STATE_ALIGN));
+    TEST_CHECK_EQ(ANIMATION_STATE_ALIGN + 3, ANIMATION_ARENA_SIZE(3));
+}
+
+static void test_state_stays_in_its_arena(void)
+{
+    ssd1306_transport_t *transport;
+    ssd1306_handle_t dev = test_panel_create(&transport);
+    uint8_t *arena = malloc(animations_arena_size() + GUARD);
+    animation_t anim;
+    
+    // Each animation gets exactly its own two states; nothing past them may be written
+    for (int type = ANIM_NONE + 1; type < ANIM_MAX; type++) {
+        const animation_def_t *def = animations_get(type);
+        size_t size = ANIMATION_ARENA_SIZE(def->state_size);
+        
+        memset(arena, GUARD_BYTE, size + GUARD);
+        TEST_CHECK_EQ(ESP_OK, animation_start(&anim, type, arena, size));
+        TEST_CHECK_EQ(0, (uintptr_t)anim.prev % ANIMATION_STATE_ALIGN);
+        for (int frame = 0; frame < 200; frame++) {
+            ssd1306_clear_screen(dev, 0);
+            animation_update(&anim, dev, 33333);
+        }
+        int touched = 0;
+        for (size_t i = size; i < size + GUARD; i++) {
+            touched += arena[i] != GUARD_BYTE;
+        }
+        TEST_CHECK_EQ(0, touched);
+        
+        // One byte short is refused
+        if (size > 0) {
+            TEST_CHECK_EQ(ESP_ERR_NO_MEM, animation_start(&anim, type, arena, size - 1));
+        }
+    }
+    TEST_CHECK_EQ(ESP_ERR_NOT_FOUND, animation_start(&anim, ANIM_NONE, arena, animations_arena_size()));
+    free(arena);
+    ssd1306_delete(dev);
+}
+
+static uint32_t interval_16ms(int frame, uint32_t remaining_us)
+{
+    return 16000;
+}
+
+static uint32_t interval_32ms(int frame, uint32_t remaining_us)
+{
+    return 32000;
+}
+
+static uint32_t interval_jittered(int frame, uint32_t remaining_us)
+{
+    // 1..60 ms, uncorrelated with the step
+    uint32_t hash = (frame + 1) * 2654435761u;
+    return 1000 + (hash >> 8) % 59000 + frame % 7;
+}
+
+static uint32_t interval_stalls(int frame, uint32_t remaining_us)
+{
+    // Stalls as long as the catch-up limit allows, then frames at odd times
+    return frame < 9 ? ANIMATION_MAX_CATCHUP_STEPS * ANIMATION_STEP_MS * 1000 : 7777;
+}
+
+static void run_animation(ssd1306_handle_t dev, ssd1306_transport_t *transport, animation_type_t type,
+                          interval_fn_t interval, run_result_t *result)
+{
+    static _Alignas(max_align_t) uint8_t arena[ANIMATION_ARENA_SIZE(MAX_STATE)];
+    animation_t anim;
+    uint32_t remaining = TOTAL_US;
+    
+    memset(result, 0, sizeof(*result));
+    animation_start(&anim, type, arena, sizeof(arena));
+    for (int frame = 0; remaining > 0; frame++) {
+        uint32_t elapsed = interval(frame, remaining);
+        if (elapsed > remaining) {
+            elapsed = remaining;
+        }
+        remaining -= elapsed;
+        ssd1306_clear_screen(dev, 0);
+        animation_update(&anim, dev, elapsed);
+    }
+    ssd1306_refresh_gram(dev);
+    
+    result->steps = anim.steps;
+    result->acc_us = anim.acc_us;
+    memcpy(result->state, anim.state, anim.def->state_size);
+    memcpy(result->prev, anim.prev, anim.def->state_size);
+    ssd1306_mem_get_frame(transport, result->frame);
+}
+
+static void test_frame_rate_independent(void)
+{
+    static const animation_type_t types[] = { ANIM_BOUNCING_BALL, ANIM_WAVE, ANIM_SPIRAL };
+    static const interval_fn_t intervals[] = { interval_32ms, interval_jittered, interval_stalls };
+    ssd1306_transport_t *transport;
+    ssd1306_handle_t dev = test_panel_create(&transport);
+    run_result_t reference, result;
+    
+    // Same animation time, any frame pacing: same state, same step count, same image
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        TEST_CHECK(animations_get(types[t])->state_size <= MAX_STATE);
+        run_animation(dev, transport, types[t], interval_16ms, &reference);
+        TEST_CHECK_EQ(TOTAL_US / (ANIMATION_STEP_MS * 1000), reference.steps);
+        TEST_CHECK_EQ(0, reference.acc_us);
+        
+        for (size_t i = 0; i < sizeof(intervals) / sizeof(intervals[0]); i++) {
+            run_animation(dev, transport, types[t], intervals[i], &result);
+            TEST_CHECK_EQ(reference.steps, result.steps);
+            TEST_CHECK_EQ(reference.acc_us, result.acc_us);
+            TEST_CHECK(memcmp(reference.state, result.state, sizeof(result.state)) == 0);
+            TEST_CHECK(memcmp(reference.prev, result.prev, sizeof(result.prev)) == 0);
+            TEST_CHECK(memcmp(reference.frame, result.frame, sizeof(result.frame)) == 0);
+        }
+    }
+    ssd1306_delete(dev);
+}
+
+static void test_catch_up_is_capped(void)
+{
+    static _Alignas(max_align_t) uint8_t arena[ANIMATION_ARENA_SIZE(MAX_STATE)];
+    ssd1306_transport_t *transport;
+    ssd1306_handle_t dev = test_panel_create(&transport);
+    animation_t anim;
+    
+    // A 5 s stall resumes ANIMATION_MAX_CATCHUP_STEPS steps later, not 50
+    animation_start(&anim, ANIM_BOUNCING_BALL, arena, sizeof(arena));
+    animation_update(&anim, dev, 5000000);
+    TEST_CHECK_EQ(ANIMATION_MAX_CATCHUP_STEPS, anim.steps);
+    TEST_CHECK_EQ(0, anim.acc_us);
+    
+    // Short frames carry their remainder over to the next step
+    animation_update(&anim, dev, ANIMATION_STEP_MS * 1000 - 1);
+    TEST_CHECK_EQ(ANIMATION_MAX_CATCHUP_STEPS, anim.steps);
+    animation_update(&anim, dev, 1);
+    TEST_CHECK_EQ(ANIMATION_MAX_CATCHUP_STEPS + 1, anim.steps);
+    TEST_CHECK_EQ(0, anim.acc_us);
+    ssd1306_delete(dev);
+}
+
+int main(void)
+{
+    RUN_TEST(test_arena_fits_every_animation);
+    RUN_TEST(test_state_stays_in_its_arena);
+    RUN_TEST(test_frame_rate_independent);
+    RUN_TEST(test_catch_up_is_capped);
+    return test_summary();
+}
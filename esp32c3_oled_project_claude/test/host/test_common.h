@@ -0,0 +1,98 @@
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_mem.h"
+
+// Minimal check macros: a failed check is reported and counted, the test goes on
+
+static int test_failures;
+
+#define TEST_CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_CHECK_EQ(expected, actual) do { \
+        long long e_ = (long long)(expected); \
+        long long a_ = (long long)(actual); \
+        if (e_ != a_) { \
+            fprintf(stderr, "%s:%d: %s == %s failed: expected %lld, got %lld\n", \
+                    __FILE__, __LINE__, #expected, #actual, e_, a_); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define RUN_TEST(fn) do { \
+        int before_ = test_failures; \
+        fn(); \
+        printf("%s %s\n", test_failures == before_ ? "PASS" : "FAIL", #fn); \
+    } while (0)
+
+static inline int test_summary(void)
+{
+    printf("%d failure(s)\n", test_failures);
+    return test_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Panel on the memory transport, initialized and with the first full frame sent
+static inline ssd1306_handle_t test_panel_create(ssd1306_transport_t **transport)
+{
+    if (ssd1306_new_transport_mem(400000, transport) != ESP_OK) {
+        return NULL;
+    }
+    ssd1306_handle_t dev = ssd1306_create_with_transport(*transport);
+    if (dev == NULL || ssd1306_init(dev) != ESP_OK) {
+        return NULL;
+    }
+    ssd1306_refresh_gram(dev);
+    ssd1306_mem_reset_stats(*transport);
+    return dev;
+}
+
+// Reference image in GRAM layout, one bit per pixel
+typedef struct {
+    uint8_t bytes[SSD1306_BUFFER_SIZE];
+} test_image_t;
+
+static inline bool test_image_get(const test_image_t *img, int x, int y)
+{
+    return (img->bytes[(y / 8) * SSD1306_WIDTH + x] >> (y % 8)) & 1;
+}
+
+static inline void test_image_set(test_image_t *img, int x, int y, bool on)
+{
+    if (x < 0 || y < 0 || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) {
+        return;
+    }
+    uint8_t bit = 1 << (y % 8);
+    if (on) {
+        img->bytes[(y / 8) * SSD1306_WIDTH + x] |= bit;
+    } else {
+        img->bytes[(y / 8) * SSD1306_WIDTH + x] &= ~bit;
+    }
+}
+
+// Number of pixels where the panel differs from the image; the first few are printed
+static inline int test_panel_diff(ssd1306_transport_t *transport, const test_image_t *img)
+{
+    int diffs = 0;
+    for (int y = 0; y < SSD1306_HEIGHT; y++) {
+        for (int x = 0; x < SSD1306_WIDTH; x++) {
+            if (ssd1306_mem_get_pixel(transport, x, y) != test_image_get(img, x, y)) {
+                if (diffs++ < 3) {
+                    fprintf(stderr, "  pixel %d,%d differs\n", x, y);
+                }
+            }
+        }
+    }
+    return diffs;
+}
+
+#endif // TEST_COMMON_H
@@ -0,0 +1,255 @@
+#include <pthread.h>
+#include <unistd.h>
+#include "test_common.h"
+#include "display_manager.h"
+#include "ssd1306_mem.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+// Event-driven display task: posts from several threads coalesce into one
+// render, nothing renders while idle, and animations keep their frame pace
+// however many events arrive. Idle, the panel dims and then switches off, and
+// the first press after that only wakes it; menu brightness reaches the panel.
+
+#define POSTERS         4
+#define POSTS           25
+#define MAX_RENDERS     256
+
+// Bits the burst posts; the clock tick can arrive at any time and is left out
+#define BURST_EVENTS    (DISPLAY_EVENT_BUTTON | DISPLAY_EVENT_SENSOR | DISPLAY_EVENT_NETWORK | DISPLAY_EVENT_REDRAW)
+
+static display_manager_handle_t s_manager;
+static ssd1306_handle_t s_dev;
+static ssd1306_transport_t *s_transport;
+static SemaphoreHandle_t s_render_gate;     // Held by the test to stretch a render
+static SemaphoreHandle_t s_stopped;
+static volatile bool s_stop;
+
+static pthread_mutex_t s_log_lock = PTHREAD_MUTEX_INITIALIZER;
+static int s_renders;
+static uint32_t s_events[MAX_RENDERS];
+static int64_t s_times[MAX_RENDERS];
+
+static void display_task(void *arg)
+{
+    while (!s_stop) {
+        uint32_t events = display_manager_wait_events(s_manager);
+        xSemaphoreTake(s_render_gate, portMAX_DELAY);
+        pthread_mutex_lock(&s_log_lock);
+        if (s_renders < MAX_RENDERS) {
+            s_events[s_renders] = events;
+            s_times[s_renders] = esp_timer_get_time();
+        }
+        s_renders++;
+        pthread_mutex_unlock(&s_log_lock);
+        display_manager_update(s_manager);
+        xSemaphoreGive(s_render_gate);
+    }
+    xSemaphoreGive(s_stopped);
+    vTaskDelete(NULL);
+}
+
+static int renders(void)
+{
+    pthread_mutex_lock(&s_log_lock);
+    int count = s_renders;
+    pthread_mutex_unlock(&s_log_lock);
+    return count;
+}
+
+// Change the mode while the task is held outside the display manager
+static void switch_mode(display_mode_t mode)
+{
+    xSemaphoreTake(s_render_gate, portMAX_DELAY);
+    display_manager_post_event(s_manager, DISPLAY_EVENT_REDRAW);
+    usleep(20000);
+    display_manager_set_mode(s_manager, mode);
+    xSemaphoreGive(s_render_gate);
+    usleep(20000);
+}
+
+static void *poster(void *arg)
+{
+    uint32_t event = (uintptr_t)arg;
+    
+    for (int i = 0; i < POSTS; i++) {
+        display_manager_post_event(s_manager, event);
+        usleep(100);
+    }
+    return NULL;
+}
+
+static void test_burst_renders_once(void)
+{
+    static const uint32_t events[POSTERS] = {
+        DISPLAY_EVENT_BUTTON, DISPLAY_EVENT_SENSOR, DISPLAY_EVENT_NETWORK, DISPLAY_EVENT_REDRAW,
+    };
+    pthread_t threads[POSTERS];
+    
+    // Hold the task in a render so the whole burst lands while it is busy
+    xSemaphoreTake(s_render_gate, portMAX_DELAY);
+    display_manager_post_event(s_manager, DISPLAY_EVENT_REDRAW);
+    usleep(20000);
+    int first = renders();
+    for (int i = 0; i < POSTERS; i++) {
+        pthread_create(&threads[i], NULL, poster, (void *)(uintptr_t)events[i]);
+    }
+    for (int i = 0; i < POSTERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    xSemaphoreGive(s_render_gate);
+    usleep(50000);
+    
+    // The held render, then one for all POSTERS * POSTS events
+    int burst = 0;
+    pthread_mutex_lock(&s_log_lock);
+    for (int i = first; i < s_renders; i++) {
+        if (i > first && (s_events[i] & BURST_EVENTS)) {
+            burst++;
+            TEST_CHECK_EQ(BURST_EVENTS, s_events[i] & BURST_EVENTS);
+        }
+    }
+    pthread_mutex_unlock(&s_log_lock);
+    TEST_CHECK_EQ(1, burst);
+}
+
+static void test_idle_renders_nothing(void)
+{
+    // Right after a clock tick, nothing is due for most of a second
+    int count = renders();
+    for (int i = 0; i < 150 && renders() == count; i++) {
+        usleep(10000);
+    }
+    TEST_CHECK(renders() > count);
+    count = renders();
+    usleep(DISPLAY_TICK_INTERVAL_MS * 1000 / 2);
+    TEST_CHECK_EQ(count, renders());
+}
+
+static void test_animation_keeps_pace(void)
+{
+    const int frames = 10;
+    
+    switch_mode(DISPLAY_MODE_ANIMATIONS);
+    
+    // Sensor and tick events flood in; frames still come once per interval
+    int first = renders();
+    int64_t start = esp_timer_get_time();
+    while (esp_timer_get_time() - start < frames * ANIMATION_FRAME_INTERVAL_MS * 1000LL) {
+        display_manager_post_event(s_manager, DISPLAY_EVENT_SENSOR | DISPLAY_EVENT_TICK);
+        usleep(1000);
+    }
+    int last = renders();
+    TEST_CHECK(last - first >= frames - 2);
+    TEST_CHECK(last - first <= frames + 1);
+    
+    pthread_mutex_lock(&s_log_lock);
+    for (int i = first + 1; i < last && i < MAX_RENDERS; i++) {
+        int64_t interval_ms = (s_times[i] - s_times[i - 1]) / 1000;
+        TEST_CHECK(interval_ms >= ANIMATION_FRAME_INTERVAL_MS - 2 * portTICK_PERIOD_MS);
+    }
+    pthread_mutex_unlock(&s_log_lock);
+    switch_mode(DISPLAY_MODE_CLOCK);
+}
+
+// Let idle time pass at once, then have the task run an update
+static void idle_for(uint32_t ms)
+{
+    host_advance_ticks(pdMS_TO_TICKS(ms));
+    display_manager_post_event(s_manager, DISPLAY_EVENT_REDRAW);
+    usleep(20000);
+}
+
+static void test_brightness_follows_menu(void)
+{
+    display_manager_adjust_brightness(DISPLAY_CONTRAST_STEP);
+    idle_for(0);
+    TEST_CHECK_EQ(DISPLAY_CONTRAST_DEFAULT + DISPLAY_CONTRAST_STEP, ssd1306_mem_get_contrast(s_transport));
+    
+    display_manager_adjust_brightness(-DISPLAY_CONTRAST_STEP);
+    idle_for(0);
+    TEST_CHECK_EQ(DISPLAY_CONTRAST_DEFAULT, ssd1306_mem_get_contrast(s_transport));
+}
+
+static void test_idle_dims_then_sleeps(void)
+{
+    ssd1306_mem_stats_t stats;
+    
+    TEST_CHECK_EQ(DISPLAY_POWER_ACTIVE, display_manager_get_power_state(s_manager));
+    TEST_CHECK_EQ(DISPLAY_CONTRAST_DEFAULT, ssd1306_mem_get_contrast(s_transport));
+    
+    idle_for(DISPLAY_DIM_TIMEOUT_MS);
+    TEST_CHECK_EQ(DISPLAY_POWER_DIM, display_manager_get_power_state(s_manager));
+    TEST_CHECK_EQ(DISPLAY_CONTRAST_DIM, ssd1306_mem_get_contrast(s_transport));
+    TEST_CHECK(!ssd1306_is_sleeping(s_dev));
+    
+    idle_for(DISPLAY_OFF_TIMEOUT_MS - DISPLAY_DIM_TIMEOUT_MS);
+    TEST_CHECK_EQ(DISPLAY_POWER_OFF, display_manager_get_power_state(s_manager));
+    TEST_CHECK(ssd1306_is_sleeping(s_dev));
+    
+    // The clock tick is stopped and data changes leave the task asleep; a
+    // redraw runs an update that renders and sends nothing, so a frame drawn
+    // now is still whole on wake
+    test_image_t lit;
+    memset(&lit, 0xFF, sizeof(lit));
+    ssd1306_clear_screen(s_dev, 0xFF);
+    ssd1306_mem_reset_stats(s_transport);
+    int count = renders();
+    uint32_t expiries = host_esp_timer_expiries();
+    display_manager_post_event(s_manager, DISPLAY_EVENT_SENSOR | DISPLAY_EVENT_NETWORK);
+    usleep(DISPLAY_TICK_INTERVAL_MS * 1500);
+    TEST_CHECK_EQ(expiries, host_esp_timer_expiries());
+    TEST_CHECK_EQ(count, renders());
+    display_manager_post_event(s_manager, DISPLAY_EVENT_REDRAW);
+    usleep(20000);
+    TEST_CHECK_EQ(count + 1, renders());
+    ssd1306_mem_get_stats(s_transport, &stats);
+    TEST_CHECK_EQ(0, stats.data_bytes);
+    
+    // The first press wakes the panel and is not passed on; the next one is
+    xSemaphoreTake(s_render_gate, portMAX_DELAY);
+    TEST_CHECK(display_manager_notify_activity(s_manager));
+    TEST_CHECK(!display_manager_notify_activity(s_manager));
+    xSemaphoreGive(s_render_gate);
+    TEST_CHECK_EQ(DISPLAY_POWER_ACTIVE, display_manager_get_power_state(s_manager));
+    TEST_CHECK_EQ(DISPLAY_CONTRAST_DEFAULT, ssd1306_mem_get_contrast(s_transport));
+    TEST_CHECK(!ssd1306_is_sleeping(s_dev));
+    TEST_CHECK_EQ(0, test_panel_diff(s_transport, &lit));
+    
+    display_manager_post_event(s_manager, DISPLAY_EVENT_REDRAW);
+    usleep(20000);
+    ssd1306_mem_get_stats(s_transport, &stats);
+    TEST_CHECK(stats.data_bytes > 0);
+    
+    // The clock tick is running again
+    count = renders();
+    expiries = host_esp_timer_expiries();
+    usleep(DISPLAY_TICK_INTERVAL_MS * 1500);
+    TEST_CHECK(host_esp_timer_expiries() > expiries);
+    TEST_CHECK(renders() > count);
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    s_manager = display_manager_create(s_dev);
+    s_render_gate = xSemaphoreCreateBinary();
+    s_stopped = xSemaphoreCreateBinary();
+    xSemaphoreGive(s_render_gate);
+    xTaskCreate(display_task, "display", 4096, NULL, 5, NULL);
+    usleep(20000);
+    
+    RUN_TEST(test_burst_renders_once);
+    RUN_TEST(test_idle_renders_nothing);
+    RUN_TEST(test_animation_keeps_pace);
+    RUN_TEST(test_brightness_follows_menu);
+    RUN_TEST(test_idle_dims_then_sleeps);
+    
+    s_stop = true;
+    display_manager_post_event(s_manager, DISPLAY_EVENT_REDRAW);
+    xSemaphoreTake(s_stopped, portMAX_DELAY);
+    display_manager_delete(s_manager);
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
@@ -0,0 +1,165 @@
+#include "test_common.h"
+#include "frame_stats.h"
+
+// Frame statistics on synthetic samples with fixed timestamps
+
+#define FRAME_US    33333       // 30 fps
+
+static frame_stats_t s_stats;
+
+static void record(uint32_t start_us, uint16_t render_us, bool late)
+{
+    frame_sample_t sample = {
+        .start_us = start_us,
+        .render_us = render_us,
+        .late = late,
+    };
+    frame_stats_record(&s_stats, &sample);
+}
+
+static void test_empty(void)
+{
+    frame_stats_summary_t summary;
+    
+    frame_stats_reset(&s_stats);
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(0, summary.frames);
+    TEST_CHECK_EQ(0, summary.fps_x100);
+    TEST_CHECK_EQ(0, summary.render_us.max);
+    TEST_CHECK_EQ(0, summary.flushes);
+    
+    // One frame has no span to measure a rate over
+    record(1000, 50, false);
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(1, summary.frames);
+    TEST_CHECK_EQ(0, summary.fps_x100);
+    TEST_CHECK_EQ(50, summary.render_us.p99);
+}
+
+static void test_partial_window(void)
+{
+    frame_stats_summary_t summary;
+    
+    frame_stats_reset(&s_stats);
+    for (int i = 0; i < 10; i++) {
+        record(5000 + i * FRAME_US, 100 - i * 10, false);
+    }
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(10, summary.frames);
+    TEST_CHECK_EQ(10, summary.render_us.min);
+    TEST_CHECK_EQ(55, summary.render_us.avg);
+    TEST_CHECK_EQ(100, summary.render_us.p99);
+    TEST_CHECK_EQ(100, summary.render_us.max);
+    TEST_CHECK_EQ(3000, summary.fps_x100);
+}
+
+static void test_nearest_rank_p99(void)
+{
+    frame_stats_summary_t summary;
+    
+    // 100 samples: rank 99 of 1..100, recorded in reverse
+    frame_stats_reset(&s_stats);
+    for (int i = 0; i < 100; i++) {
+        record(i * FRAME_US, 100 - i, false);
+    }
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(99, summary.render_us.p99);
+    
+    // A full window: rank ceil(0.99 * 128) = 127, so one outlier is ignored
+    frame_stats_reset(&s_stats);
+    for (int i = 0; i < FRAME_STATS_DEPTH; i++) {
+        record(i * FRAME_US, i == 40 ? 9000 : 200 + i % 7, false);
+    }
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(206, summary.render_us.p99);
+    TEST_CHECK_EQ(9000, summary.render_us.max);
+    TEST_CHECK_EQ(200, summary.render_us.min);
+    
+    // Two outliers are more than 1% of the window
+    record(FRAME_STATS_DEPTH * FRAME_US, 8000, false);
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(8000, summary.render_us.p99);
+}
+
+static void test_ring_wrap(void)
+{
+    const int frames = FRAME_STATS_DEPTH + 72;
+    frame_stats_summary_t summary;
+    
+    // Every tenth frame is late; the window keeps only the last FRAME_STATS_DEPTH
+    frame_stats_reset(&s_stats);
+    for (int i = 0; i < frames; i++) {
+        record(i * FRAME_US, i, i % 10 == 0);
+    }
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(FRAME_STATS_DEPTH, summary.frames);
+    TEST_CHECK_EQ(frames, summary.total_frames);
+    TEST_CHECK_EQ(20, summary.total_missed);
+    TEST_CHECK_EQ(12, summary.missed);
+    TEST_CHECK_EQ(72, summary.render_us.min);
+    TEST_CHECK_EQ(135, summary.render_us.avg);
+    TEST_CHECK_EQ(198, summary.render_us.p99);
+    TEST_CHECK_EQ(frames - 1, summary.render_us.max);
+    TEST_CHECK_EQ(3000, summary.fps_x100);
+}
+
+static void test_flush_metrics(void)
+{
+    frame_stats_summary_t summary;
+    
+    // Only frames that sent data count towards the flush figures
+    frame_stats_reset(&s_stats);
+    for (int i = 0; i < 20; i++) {
+        frame_sample_t sample = {
+            .start_us = i * FRAME_US,
+            .render_us = 100,
+            .flushed = i % 4 == 0,
+            .flush_us = i % 4 == 0 ? 1000 + i * 100 : 60000,
+            .bytes = i % 4 == 0 ? 200 : 9999,
+            .dirty_columns = i % 4 == 0 ? 20 + i : 9999,
+        };
+        frame_stats_record(&s_stats, &sample);
+    }
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(20, summary.frames);
+    TEST_CHECK_EQ(5, summary.flushes);
+    TEST_CHECK_EQ(1000, summary.flush_us.min);
+    TEST_CHECK_EQ(1800, summary.flush_us.avg);
+    TEST_CHECK_EQ(2600, summary.flush_us.max);
+    TEST_CHECK_EQ(200, summary.bytes.max);
+    TEST_CHECK_EQ(20, summary.dirty_columns.min);
+    TEST_CHECK_EQ(36, summary.dirty_columns.max);
+}
+
+static void test_fps_across_timer_wrap(void)
+{
+    frame_stats_summary_t summary;
+    
+    // start_us is the low 32 bits of the microsecond clock and wraps every 71 minutes
+    frame_stats_reset(&s_stats);
+    uint32_t start = UINT32_MAX - 50 * FRAME_US;
+    for (int i = 0; i < 100; i++) {
+        record(start + i * FRAME_US, 100, false);
+    }
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(3000, summary.fps_x100);
+    
+    // Half the rate: 15 fps
+    frame_stats_reset(&s_stats);
+    for (int i = 0; i < 100; i++) {
+        record(start + i * 2 * FRAME_US, 100, false);
+    }
+    frame_stats_summarize(&s_stats, &summary);
+    TEST_CHECK_EQ(1500, summary.fps_x100);
+}
+
+int main(void)
+{
+    RUN_TEST(test_empty);
+    RUN_TEST(test_partial_window);
+    RUN_TEST(test_nearest_rank_p99);
+    RUN_TEST(test_ring_wrap);
+    RUN_TEST(test_flush_metrics);
+    RUN_TEST(test_fps_across_timer_wrap);
+    return test_summary();
+}
@@ -0,0 +1,170 @@
+#include <unistd.h>
+#include "test_common.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "input.h"
+
+// The input component end to end on simulated pins: ISR, edge ring, input
+// task and event queue, plus its setup and failure paths
+
+#define GPIO_A      3       // Active low
+#define GPIO_B      4       // Active low
+#define GPIO_C      5       // Active high
+
+static const input_button_t s_buttons[] = {
+    { .gpio = GPIO_A, .active_low = true },
+    { .gpio = GPIO_B, .active_low = true },
+    { .gpio = GPIO_C, .active_low = false },
+};
+
+static volatile int s_notified;
+
+static void notify(void *arg)
+{
+    s_notified++;
+}
+
+static const input_config_t s_config = {
+    .buttons = s_buttons,
+    .button_count = 3,
+    .debounce_ms = 20,
+    .long_press_ms = 600,
+    .repeat_ms = 150,
+    .task_priority = 6,
+    .notify = notify,
+};
+
+static bool next_event(input_event_type_t type, uint8_t button, uint32_t timeout_ms, input_event_t *event)
+{
+    input_event_t local;
+    if (event == NULL) event = &local;
+    return input_get_event(event, timeout_ms) == ESP_OK && event->type == type && event->button == button;
+}
+
+// These run first: a failed init must leave nothing behind and allow a retry
+static void test_handler_failure_cleans_up(void)
+{
+    input_event_t event;
+    UBaseType_t tasks = uxTaskGetNumberOfTasks();
+    
+    // The last button fails after the task is up and two handlers are in
+    host_gpio_fail_isr_handler(GPIO_C, ESP_ERR_NO_MEM);
+    TEST_CHECK_EQ(ESP_ERR_NO_MEM, input_init(&s_config));
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, input_get_event(&event, 0));
+    TEST_CHECK(!host_gpio_has_handler(GPIO_A));
+    TEST_CHECK(!host_gpio_has_handler(GPIO_B));
+    TEST_CHECK(!host_gpio_has_handler(GPIO_C));
+    TEST_CHECK_EQ(tasks, uxTaskGetNumberOfTasks());
+}
+
+static void test_isr_service_failure_cleans_up(void)
+{
+    input_event_t event;
+    
+    host_gpio_fail_isr_service(ESP_ERR_NO_MEM);
+    TEST_CHECK_EQ(ESP_ERR_NO_MEM, input_init(&s_config));
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, input_get_event(&event, 0));
+    TEST_CHECK(!host_gpio_has_handler(GPIO_A));
+    
+    TEST_CHECK_EQ(ESP_OK, input_init(&s_config));
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, input_init(&s_config));
+    TEST_CHECK(host_gpio_has_handler(GPIO_A));
+}
+
+static void test_pull_up_per_pin(void)
+{
+    TEST_CHECK(host_gpio_pulled_up(GPIO_A));
+    TEST_CHECK(host_gpio_pulled_up(GPIO_B));
+    TEST_CHECK(!host_gpio_pulled_up(GPIO_C));
+}
+
+static void test_bouncy_presses(void)
+{
+    input_event_t event;
+    int64_t worst = 0;
+    
+    TEST_CHECK_EQ(ESP_ERR_TIMEOUT, input_get_event(&event, 0));
+    for (int round = 0; round < 20; round++) {
+        // The press is reported on its first edge, the bounce after it is ignored
+        int64_t start = esp_timer_get_time();
+        host_gpio_set_level(GPIO_A, 0);
+        TEST_CHECK(next_event(INPUT_EVENT_PRESS, 0, 100, &event));
+        int64_t latency = esp_timer_get_time() - start;
+        if (latency > worst) worst = latency;
+        host_gpio_set_level(GPIO_A, 1);
+        usleep(300);
+        host_gpio_set_level(GPIO_A, 0);
+        
+        // Active-high button taps meanwhile
+        host_gpio_set_level(GPIO_C, 1);
+        usleep(100);
+        host_gpio_set_level(GPIO_C, 0);
+        usleep(100);
+        host_gpio_set_level(GPIO_C, 1);
+        usleep(30000);
+        host_gpio_set_level(GPIO_C, 0);
+        TEST_CHECK(next_event(INPUT_EVENT_PRESS, 2, 100, NULL));
+        TEST_CHECK(next_event(INPUT_EVENT_RELEASE, 2, 100, &event));
+        TEST_CHECK(event.held_us >= 29000 && event.held_us < 60000);
+        
+        host_gpio_set_level(GPIO_A, 1);
+        TEST_CHECK(next_event(INPUT_EVENT_RELEASE, 0, 100, NULL));
+        host_gpio_set_level(GPIO_A, 0);
+        usleep(100);
+        host_gpio_set_level(GPIO_A, 1);
+        
+        // Bounce only; nothing more once the window has passed
+        usleep(25000);
+        TEST_CHECK_EQ(ESP_ERR_TIMEOUT, input_get_event(&event, 0));
+    }
+    TEST_CHECK(worst < 20000);
+    TEST_CHECK(s_notified > 0);
+}
+
+static void test_long_press_and_repeat(void)
+{
+    int64_t start = esp_timer_get_time();
+    
+    host_gpio_set_level(GPIO_B, 0);
+    TEST_CHECK(next_event(INPUT_EVENT_PRESS, 1, 100, NULL));
+    TEST_CHECK(next_event(INPUT_EVENT_LONG_PRESS, 1, 1000, NULL));
+    int64_t long_at = esp_timer_get_time() - start;
+    TEST_CHECK(next_event(INPUT_EVENT_REPEAT, 1, 1000, NULL));
+    int64_t repeat_at = esp_timer_get_time() - start;
+    host_gpio_set_level(GPIO_B, 1);
+    TEST_CHECK(next_event(INPUT_EVENT_RELEASE, 1, 100, NULL));
+    
+    TEST_CHECK(long_at >= 600000 && long_at < 650000);
+    TEST_CHECK(repeat_at >= 750000 && repeat_at < 800000);
+}
+
+// More edges than the ring holds: the task resynchronizes to the real level
+static void test_edge_flood(void)
+{
+    input_event_t event;
+    
+    for (int i = 0; i < 1000; i++) {
+        host_gpio_set_level(GPIO_B, i & 1);
+    }
+    usleep(50000);
+    while (input_get_event(&event, 0) == ESP_OK) {
+        continue;
+    }
+    
+    host_gpio_set_level(GPIO_B, 0);
+    TEST_CHECK(next_event(INPUT_EVENT_PRESS, 1, 100, NULL));
+    host_gpio_set_level(GPIO_B, 1);
+    TEST_CHECK(next_event(INPUT_EVENT_RELEASE, 1, 100, NULL));
+}
+
+int main(void)
+{
+    RUN_TEST(test_handler_failure_cleans_up);
+    RUN_TEST(test_isr_service_failure_cleans_up);
+    RUN_TEST(test_pull_up_per_pin);
+    RUN_TEST(test_bouncy_presses);
+    RUN_TEST(test_long_press_and_repeat);
+    RUN_TEST(test_edge_flood);
+    return test_summary();
+}
@@ -0,0 +1,161 @@
+#include "test_common.h"
+#include "input_debounce.h"
+
+// Recorded contact timelines replayed through the debouncer on a virtual
+// clock, once from an early base time and once across the clock wrap
+
+typedef struct {
+    uint32_t t;
+    bool pressed;
+} edge_t;
+
+// Event as expected, times relative to the timeline start; emitted is the
+// virtual clock when the debouncer reported it
+typedef struct {
+    input_event_type_t type;
+    uint32_t time;
+    uint32_t held;
+    uint32_t emitted;
+} expected_t;
+
+#define MAX_EVENTS  16
+
+static const input_timing_t s_timing = {
+    .debounce_us = 20000,
+    .long_press_us = 600000,
+    .repeat_us = 150000,
+};
+
+static expected_t s_got[MAX_EVENTS];
+static int s_got_count;
+static uint32_t s_now;
+
+static void record(const input_event_t *event, void *arg)
+{
+    if (s_got_count < MAX_EVENTS) {
+        s_got[s_got_count++] = (expected_t){ event->type, event->time_us, event->held_us, s_now };
+    }
+}
+
+// Feed the edges in time order, running every timer that falls due before them
+static void replay(const edge_t *edges, int count, uint32_t base, uint32_t duration)
+{
+    input_debouncer_t db;
+    uint32_t end = base + duration;
+    int i = 0;
+    
+    input_debounce_init(&db, 0, false);
+    s_got_count = 0;
+    
+    while (1) {
+        uint32_t due;
+        bool pending = input_debounce_next(&db, &due);
+        uint32_t edge_time = (i < count) ? base + edges[i].t : 0;
+        
+        if (i < count && (!pending || (int32_t)(edge_time - due) <= 0)) {
+            s_now = edge_time;
+            input_debounce_edge(&db, &s_timing, edges[i].pressed, edge_time, record, NULL);
+            i++;
+        } else if (pending && (int32_t)(due - end) <= 0) {
+            s_now = due;
+            input_debounce_poll(&db, &s_timing, due, record, NULL);
+        } else {
+            break;
+        }
+    }
+}
+
+static void expect(const char *name, const expected_t *want, int count, uint32_t base)
+{
+    bool ok = s_got_count == count;
+    for (int i = 0; ok && i < count; i++) {
+        ok = s_got[i].type == want[i].type && s_got[i].time == base + want[i].time &&
+             s_got[i].held == want[i].held && s_got[i].emitted == base + want[i].emitted;
+    }
+    if (!ok) {
+        fprintf(stderr, "  %s at base %u, got:", name, base);
+        for (int i = 0; i < s_got_count; i++) {
+            fprintf(stderr, " [%d t%u h%u e%u]", s_got[i].type, s_got[i].time - base, s_got[i].held,
+                    s_got[i].emitted - base);
+        }
+        fprintf(stderr, "\n");
+        TEST_CHECK(!"events differ from the expected timeline");
+    }
+}
+
+#define P   INPUT_EVENT_PRESS
+#define R   INPUT_EVENT_RELEASE
+#define L   INPUT_EVENT_LONG_PRESS
+#define RP  INPUT_EVENT_REPEAT
+#define REPLAY(edges, base, duration)   replay(edges, sizeof(edges) / sizeof(edges[0]), base, duration)
+#define EXPECT(name, want, base)        expect(name, want, sizeof(want) / sizeof(want[0]), base)
+
+static void run_timelines(uint32_t base)
+{
+    {
+        static const edge_t e[] = { {0, 1}, {100000, 0} };
+        static const expected_t w[] = { {P, 0, 0, 0}, {R, 100000, 100000, 100000} };
+        REPLAY(e, base, 2000000);
+        EXPECT("clean", w, base);
+    }
+    {
+        static const edge_t e[] = { {0, 1}, {300, 0}, {700, 1}, {1200, 0}, {1500, 1},
+                                    {200000, 0}, {200400, 1}, {200900, 0} };
+        static const expected_t w[] = { {P, 0, 0, 0}, {R, 200000, 200000, 200000} };
+        REPLAY(e, base, 2000000);
+        EXPECT("bouncy", w, base);
+    }
+    {
+        // A quick tap that is already released inside the debounce window
+        static const edge_t e[] = { {0, 1}, {800, 0}, {1100, 1}, {5000, 0} };
+        static const expected_t w[] = { {P, 0, 0, 0}, {R, 25000, 25000, 25000} };
+        REPLAY(e, base, 2000000);
+        EXPECT("tap", w, base);
+    }
+    {
+        // Bounce straddling the end of the window settles pressed
+        static const edge_t e[] = { {0, 1}, {19000, 0}, {21000, 1} };
+        static const expected_t w[] = { {P, 0, 0, 0} };
+        REPLAY(e, base, 200000);
+        EXPECT("late bounce", w, base);
+    }
+    {
+        static const edge_t e[] = { {0, 1}, {1000000, 0}, {1000300, 1}, {1000600, 0} };
+        static const expected_t w[] = { {P, 0, 0, 0}, {L, 600000, 600000, 600000}, {RP, 750000, 750000, 750000},
+                                        {RP, 900000, 900000, 900000}, {R, 1000000, 1000000, 1000000} };
+        REPLAY(e, base, 3000000);
+        EXPECT("long press and repeat", w, base);
+    }
+    {
+        // Repeated levels are not changes
+        static const edge_t e[] = { {0, 1}, {0, 1}, {50000, 1}, {90000, 0}, {90000, 0} };
+        static const expected_t w[] = { {P, 0, 0, 0}, {R, 90000, 90000, 90000} };
+        REPLAY(e, base, 2000000);
+        EXPECT("duplicates", w, base);
+    }
+    {
+        // The window after the release ends at 50 ms with the contact pressed
+        // since 41.5 ms: the press is reported once it has been quiet
+        static const edge_t e[] = { {0, 1}, {30000, 0}, {30100, 1}, {30300, 0}, {40000, 1}, {41000, 0}, {41500, 1} };
+        static const expected_t w[] = { {P, 0, 0, 0}, {R, 30000, 30000, 30000}, {P, 61500, 0, 61500} };
+        REPLAY(e, base, 200000);
+        EXPECT("re-press in window", w, base);
+    }
+}
+
+static void test_timelines(void)
+{
+    run_timelines(1000);
+}
+
+static void test_timelines_across_wrap(void)
+{
+    run_timelines(UINT32_MAX - 500000);
+}
+
+int main(void)
+{
+    RUN_TEST(test_timelines);
+    RUN_TEST(test_timelines_across_wrap);
+    return test_summary();
+}
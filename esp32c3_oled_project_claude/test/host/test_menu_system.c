@@ -0,0 +1,216 @@
+#include "test_common.h"
+#include "menu_system.h"
+#include "wifi_manager_host.h"
+
+// Menu navigation stack, partial redraws and information-only entries,
+// checked on the emulated panel
+
+// Layout of menu_system.c
+#define ROW_Y(row)      (16 + (row) * 12)
+#define BAR_PROBE_X     116     // Inside the selection bar, right of any label drawn here
+#define ITEMS           7
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+static int s_selected;
+
+#define SELECT_ACTION(n) static void select_##n(void) { s_selected = n; }
+SELECT_ACTION(0) SELECT_ACTION(1) SELECT_ACTION(2) SELECT_ACTION(3)
+SELECT_ACTION(4) SELECT_ACTION(5) SELECT_ACTION(6)
+
+static const menu_item_t s_items[ITEMS] = {
+    {"Zero", select_0, NULL}, {"One", select_1, NULL}, {"Two", select_2, NULL},
+    {"Three", select_3, NULL}, {"Four", select_4, NULL}, {"Five", select_5, NULL},
+    {"Six", select_6, NULL},
+};
+
+static const menu_t s_menus[MENU_STACK_DEPTH] = {
+    {"Level 1", s_items, ITEMS}, {"Level 2", s_items, ITEMS}, {"Level 3", s_items, ITEMS},
+    {"Level 4", s_items, ITEMS}, {"Level 5", s_items, ITEMS}, {"Level 6", s_items, ITEMS},
+    {"Level 7", s_items, ITEMS}, {"Level 8", s_items, ITEMS},
+};
+
+static void setup(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    menu_system_init();
+    menu_system_activate(true);
+}
+
+static void teardown(void)
+{
+    menu_system_activate(false);
+    ssd1306_delete(s_dev);
+}
+
+static void render(bool cleared)
+{
+    if (cleared) {
+        ssd1306_clear_screen(s_dev, 0);
+    }
+    menu_system_display(s_dev, cleared);
+    ssd1306_refresh_gram(s_dev);
+}
+
+// Row whose selection bar is lit, -1 if none
+static int selected_row(void)
+{
+    int found = -1;
+    for (int row = 0; row < 4; row++) {
+        if (ssd1306_mem_get_pixel(s_transport, BAR_PROBE_X, ROW_Y(row) + 1)) {
+            found = found < 0 ? row : -2;
+        }
+    }
+    return found;
+}
+
+static void move_down(int n)
+{
+    for (int i = 0; i < n; i++) {
+        menu_system_navigate_down();
+    }
+}
+
+// Selection at each level, with scrolled ones among them
+static int level_selection(int level)
+{
+    return (level * 3 + 1) % ITEMS;
+}
+
+static void test_back_restores_selection(void)
+{
+    setup();
+    move_down(2);
+    
+    // The main menu is level 0; seven more fill the stack
+    for (int level = 1; level < MENU_STACK_DEPTH; level++) {
+        TEST_CHECK_EQ(ESP_OK, menu_system_push(&s_menus[level]));
+        TEST_CHECK_EQ(level + 1, menu_system_depth());
+        move_down(level_selection(level));
+        render(level == 1);
+    }
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, menu_system_push(&s_menus[0]));
+    TEST_CHECK_EQ(MENU_STACK_DEPTH, menu_system_depth());
+    
+    for (int level = MENU_STACK_DEPTH - 1; level >= 1; level--) {
+        int selection = level_selection(level);
+        int scroll = selection > 3 ? selection - 3 : 0;
+        
+        render(false);
+        TEST_CHECK_EQ(selection - scroll, selected_row());
+        s_selected = -1;
+        menu_system_select();
+        TEST_CHECK_EQ(selection, s_selected);
+        menu_system_back();
+        TEST_CHECK_EQ(level, menu_system_depth());
+    }
+    
+    // Back on the main menu, which stays open
+    render(false);
+    TEST_CHECK_EQ(2, selected_row());
+    menu_system_back();
+    TEST_CHECK_EQ(1, menu_system_depth());
+    teardown();
+}
+
+// Pages whose content changed with the last navigation step, as a bit mask
+static uint8_t step_pages(void (*step)(void), int *regions)
+{
+    uint8_t before[SSD1306_BUFFER_SIZE];
+    uint8_t after[SSD1306_BUFFER_SIZE];
+    uint8_t pages = 0;
+    
+    ssd1306_mem_get_frame(s_transport, before);
+    step();
+    *regions = menu_system_display(s_dev, false);
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_get_frame(s_transport, after);
+    for (int i = 0; i < SSD1306_BUFFER_SIZE; i++) {
+        if (before[i] != after[i]) {
+            pages |= 1 << (i / SSD1306_WIDTH);
+        }
+    }
+    return pages;
+}
+
+static void test_step_redraws_two_rows(void)
+{
+    int regions;
+    
+    setup();
+    menu_system_push(&s_menus[1]);
+    render(true);
+    
+    // Rows 0 and 1 span pages 2-4, the position hint pages 0-1
+    uint8_t pages = step_pages(menu_system_navigate_down, &regions);
+    TEST_CHECK_EQ(0, pages & ~0x1F);
+    TEST_CHECK_EQ(0x0C, pages & 0x0C);
+    TEST_CHECK_EQ(3, regions);
+    TEST_CHECK_EQ(1, selected_row());
+    
+    // Rows 2 and 3 span pages 5-7, both ways
+    move_down(1);
+    render(false);
+    pages = step_pages(menu_system_navigate_down, &regions);
+    TEST_CHECK_EQ(0, pages & ~0xE3);
+    TEST_CHECK_EQ(0xE0, pages & 0xE0);
+    TEST_CHECK_EQ(3, regions);
+    TEST_CHECK_EQ(3, selected_row());
+    pages = step_pages(menu_system_navigate_up, &regions);
+    TEST_CHECK_EQ(0, pages & ~0xE3);
+    TEST_CHECK_EQ(3, regions);
+    TEST_CHECK_EQ(2, selected_row());
+    
+    // Scrolling relabels every row
+    move_down(1);
+    render(false);
+    step_pages(menu_system_navigate_down, &regions);
+    TEST_CHECK_EQ(5, regions);
+    teardown();
+}
+
+static void test_scan_results_are_information(void)
+{
+    wifi_status_t status = { .scan_count = 3 };
+    int scans = host_wifi_scan_count();
+    
+    for (int i = 0; i < status.scan_count; i++) {
+        snprintf(status.scan_results[i].ssid, sizeof(status.scan_results[i].ssid), "net%d", i);
+        status.scan_results[i].rssi = -40 - i * 10;
+    }
+    host_wifi_set_status(&status);
+    
+    // Main menu > Network Settings > WiFi Scan
+    setup();
+    menu_system_navigate_down();
+    menu_system_select();
+    menu_system_select();
+    TEST_CHECK_EQ(3, menu_system_depth());
+    TEST_CHECK_EQ(scans + 1, host_wifi_scan_count());
+    render(true);
+    
+    // The cursor on a network is an outline, and selecting it does nothing
+    TEST_CHECK_EQ(-1, selected_row());
+    TEST_CHECK(ssd1306_mem_get_pixel(s_transport, 0, ROW_Y(0) + 6));
+    TEST_CHECK(ssd1306_mem_get_pixel(s_transport, BAR_PROBE_X, ROW_Y(0)));
+    TEST_CHECK(ssd1306_mem_get_pixel(s_transport, BAR_PROBE_X, ROW_Y(0) + 11));
+    menu_system_select();
+    TEST_CHECK_EQ(3, menu_system_depth());
+    TEST_CHECK_EQ(scans + 1, host_wifi_scan_count());
+    
+    // The static items after the networks keep the bar and their actions
+    move_down(status.scan_count);
+    render(false);
+    TEST_CHECK_EQ(3, selected_row());
+    menu_system_select();
+    TEST_CHECK_EQ(scans + 2, host_wifi_scan_count());
+    teardown();
+}
+
+int main(void)
+{
+    RUN_TEST(test_back_restores_selection);
+    RUN_TEST(test_step_redraws_two_rows);
+    RUN_TEST(test_scan_results_are_information);
+    return test_summary();
+}
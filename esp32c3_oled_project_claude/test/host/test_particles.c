@@ -0,0 +1,155 @@
+#include "test_common.h"
+#include "particles.h"
+
+// Structure-of-arrays particle pool against a plain array-of-structs model
+// stepped the same way, and point rendering against the emulated panel
+
+#define CAPACITY    200
+#define STEPS       400
+
+typedef struct {
+    int16_t x, y, vx, vy;
+    uint8_t life, glyph;
+} model_particle_t;
+
+static model_particle_t s_model[CAPACITY];
+static int s_model_count;
+
+static int compare_particles(const void *a, const void *b)
+{
+    return memcmp(a, b, sizeof(model_particle_t));
+}
+
+static void model_step(int16_t ax, int16_t ay)
+{
+    int16_t max_x = (SSD1306_WIDTH + PARTICLE_MARGIN) * PARTICLE_ONE;
+    int16_t max_y = (SSD1306_HEIGHT + PARTICLE_MARGIN) * PARTICLE_ONE;
+    int16_t min = -PARTICLE_MARGIN * PARTICLE_ONE;
+    int live = 0;
+    
+    for (int i = 0; i < s_model_count; i++) {
+        model_particle_t p = s_model[i];
+        p.vx += ax;
+        p.vy += ay;
+        p.x += p.vx;
+        p.y += p.vy;
+        if (p.life != PARTICLE_LIFE_FOREVER && --p.life == 0) continue;
+        if (p.x < min || p.x >= max_x || p.y >= max_y || (ay <= 0 && p.y < min)) continue;
+        s_model[live++] = p;
+    }
+    s_model_count = live;
+}
+
+// The pool as a sorted list, to compare regardless of slot order
+static int pool_sorted(const particle_pool_t *pool, model_particle_t *out)
+{
+    for (int i = 0; i < pool->count; i++) {
+        out[i] = (model_particle_t) {
+            particles_x(pool)[i], particles_y(pool)[i], particles_vx(pool)[i], particles_vy(pool)[i],
+            particles_life(pool)[i], particles_glyph(pool)[i],
+        };
+    }
+    qsort(out, pool->count, sizeof(out[0]), compare_particles);
+    return pool->count;
+}
+
+static void test_pool_matches_model(void)
+{
+    static uint8_t storage[PARTICLE_POOL_SIZE(CAPACITY)] __attribute__((aligned(4)));
+    particle_pool_t *pool = (particle_pool_t *)storage;
+    model_particle_t sorted[CAPACITY];
+    
+    particles_init(pool, CAPACITY, 1234);
+    pool->ay = 2;
+    s_model_count = 0;
+    
+    particle_emitter_t emitter = {
+        .x = 64 * PARTICLE_ONE, .y = 50 * PARTICLE_ONE, .spread_x = 40, .spread_y = 20,
+        .vx = 0, .vy = -40, .spread_vx = 30, .spread_vy = 20,
+        .life = 60, .spread_life = 40,
+    };
+    
+    for (int step = 0; step < STEPS; step++) {
+        // Emit more than fits now and then; the pool must stop at capacity
+        uint16_t want = (step % 50 == 0) ? CAPACITY : 3;
+        uint16_t before = pool->count;
+        emitter.glyph = step & 0xFF;
+        uint16_t got = particles_emit(pool, &emitter, want);
+        TEST_CHECK_EQ(want < CAPACITY - before ? want : CAPACITY - before, got);
+        for (int i = before; i < pool->count; i++) {
+            s_model[s_model_count++] = (model_particle_t) {
+                particles_x(pool)[i], particles_y(pool)[i], particles_vx(pool)[i], particles_vy(pool)[i],
+                particles_life(pool)[i], particles_glyph(pool)[i],
+            };
+        }
+        
+        particles_step(pool);
+        model_step(pool->ax, pool->ay);
+        
+        TEST_CHECK_EQ(s_model_count, pool->count);
+        int n = pool_sorted(pool, sorted);
+        qsort(s_model, s_model_count, sizeof(s_model[0]), compare_particles);
+        if (n != s_model_count || memcmp(sorted, s_model, n * sizeof(sorted[0])) != 0) {
+            fprintf(stderr, "  pool differs from model after step %d\n", step);
+            TEST_CHECK(!"pool differs from model");
+            break;
+        }
+    }
+    TEST_CHECK(pool->count > 0);
+}
+
+static void test_spawn_until_full(void)
+{
+    static uint8_t storage[PARTICLE_POOL_SIZE(8)] __attribute__((aligned(4)));
+    particle_pool_t *pool = (particle_pool_t *)storage;
+    
+    particles_init(pool, 8, 0);
+    for (int i = 0; i < 8; i++) {
+        TEST_CHECK_EQ(i, particles_spawn(pool));
+    }
+    TEST_CHECK_EQ(-1, particles_spawn(pool));
+    
+    // Killed particles are swapped out, so the live ones stay at the front
+    particles_life(pool)[2] = 1;
+    particles_life(pool)[5] = 1;
+    particles_x(pool)[7] = 7 * PARTICLE_ONE;
+    particles_step(pool);
+    TEST_CHECK_EQ(6, pool->count);
+    TEST_CHECK_EQ(7 * PARTICLE_ONE, particles_x(pool)[2]);
+    TEST_CHECK(particles_spawn(pool) == 6);
+}
+
+static void test_render_points(void)
+{
+    static uint8_t storage[PARTICLE_POOL_SIZE(CAPACITY)] __attribute__((aligned(4)));
+    particle_pool_t *pool = (particle_pool_t *)storage;
+    ssd1306_transport_t *transport;
+    ssd1306_handle_t dev = test_panel_create(&transport);
+    test_image_t model = { 0 };
+    
+    particles_init(pool, CAPACITY, 99);
+    particle_emitter_t emitter = {
+        .x = 64 * PARTICLE_ONE, .y = 32 * PARTICLE_ONE, .spread_x = 70 * PARTICLE_ONE, .spread_y = 40 * PARTICLE_ONE,
+        .vx = 0, .vy = 0, .spread_vx = 64, .spread_vy = 64,
+    };
+    particles_emit(pool, &emitter, CAPACITY);
+    
+    // Halfway through the last step, in whole pixels
+    particles_render_points(pool, dev, 128);
+    for (int i = 0; i < pool->count; i++) {
+        int x = particles_x(pool)[i] - ((particles_vx(pool)[i] * 128) >> 8);
+        int y = particles_y(pool)[i] - ((particles_vy(pool)[i] * 128) >> 8);
+        test_image_set(&model, x >> PARTICLE_FRAC_BITS, y >> PARTICLE_FRAC_BITS, true);
+    }
+    ssd1306_refresh_gram(dev);
+    TEST_CHECK_EQ(0, test_panel_diff(transport, &model));
+    ssd1306_delete(dev);
+}
+
+int main(void)
+{
+    RUN_TEST(test_pool_matches_model);
+    RUN_TEST(test_spawn_until_full);
+    RUN_TEST(test_render_points);
+    return test_summary();
+}
@@ -0,0 +1,161 @@
+#include <math.h>
+#include "test_common.h"
+#include "sensor_history.h"
+
+// Every tier of the history against buckets recomputed from the full list of
+// readings, over a long run with gaps, failed readings and negative values
+
+#define READINGS    60000
+
+typedef struct {
+    uint32_t time_s;
+    int16_t value;
+} reading_t;
+
+static reading_t s_readings[READINGS];
+static int s_count;
+
+// The bucket of period period_s and index index, rolled up the slow way
+static sensor_bucket_t reference_bucket(uint32_t period_s, uint32_t index)
+{
+    int32_t sum = 0;
+    int n = 0;
+    int16_t lo = INT16_MAX, hi = INT16_MIN;
+    
+    for (int i = 0; i < s_count; i++) {
+        int16_t v = s_readings[i].value;
+        if (s_readings[i].time_s / period_s != index || v == SENSOR_HISTORY_NO_DATA) continue;
+        sum += v;
+        n++;
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    if (n == 0) {
+        return (sensor_bucket_t){ SENSOR_HISTORY_NO_DATA, SENSOR_HISTORY_NO_DATA, SENSOR_HISTORY_NO_DATA };
+    }
+    
+    // Rounded to nearest, halves away from zero
+    int32_t avg = (sum >= 0 ? sum + n / 2 : sum - n / 2) / n;
+    return (sensor_bucket_t){ lo, hi, (int16_t)avg };
+}
+
+static bool check_history(sensor_quantity_t quantity)
+{
+    static const uint32_t periods[] = { 60, 900 };
+    static const int lens[] = { SENSOR_HISTORY_MINUTE_LEN, SENSOR_HISTORY_QUARTER_LEN };
+    sensor_bucket_t got[SENSOR_HISTORY_RAW_LEN + 1];
+    
+    // Raw: the newest readings as they were recorded
+    int n = sensor_history_read(quantity, SENSOR_TIER_RAW, got, SENSOR_HISTORY_RAW_LEN + 1);
+    int want = s_count < SENSOR_HISTORY_RAW_LEN ? s_count : SENSOR_HISTORY_RAW_LEN;
+    TEST_CHECK_EQ(want, n);
+    for (int i = 0; i < n && n == want; i++) {
+        int16_t v = s_readings[s_count - n + i].value;
+        if (got[i].min != v || got[i].max != v || got[i].avg != v) {
+            fprintf(stderr, "  raw entry %d differs\n", i);
+            return false;
+        }
+    }
+    
+    // Closed buckets plus the open one, every bucket index in the span present
+    for (int t = 0; t < 2; t++) {
+        n = sensor_history_read(quantity, SENSOR_TIER_MINUTE + t, got, SENSOR_HISTORY_RAW_LEN + 1);
+        uint32_t last = s_readings[s_count - 1].time_s / periods[t];
+        uint32_t first = s_readings[0].time_s / periods[t];
+        int span = last - first + 1;
+        want = span < lens[t] + 1 ? span : lens[t] + 1;
+        if (n != want) {
+            fprintf(stderr, "  tier %d holds %d entries, want %d\n", t + 1, n, want);
+            return false;
+        }
+        for (int i = 0; i < n; i++) {
+            sensor_bucket_t ref = reference_bucket(periods[t], last - (n - 1 - i));
+            if (ref.min != got[i].min || ref.max != got[i].max || ref.avg != got[i].avg) {
+                fprintf(stderr, "  tier %d entry %d: got %d/%d/%d, want %d/%d/%d\n", t + 1, i,
+                        got[i].min, got[i].max, got[i].avg, ref.min, ref.max, ref.avg);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void test_rollups_match_reference(void)
+{
+    sensor_quantity_t quantity = SENSOR_TEMPERATURE;
+    uint32_t time_s = 1000;
+    
+    srand(7);
+    TEST_CHECK_EQ(ESP_OK, sensor_history_init());
+    for (int i = 0; i < READINGS; i++) {
+        int r = rand() % 1000;
+        
+        // Occasional gaps, some longer than a whole bucket; failed readings; a negative now and then
+        time_s += (r < 5) ? 60 + rand() % 2000 : 1;
+        float value = 22.0f + 3.0f * sinf(i * 0.001f) + (rand() % 200 - 100) * 0.01f;
+        if (r < 20) value = NAN;
+        if (r == 999) value = -40.0f;
+        
+        sensor_history_add(quantity, value, time_s);
+        s_readings[s_count++] = (reading_t){ time_s, sensor_history_from_float(quantity, value) };
+        
+        if (i % 5000 == 4999 && !check_history(quantity)) {
+            TEST_CHECK(!"history differs from reference");
+            return;
+        }
+    }
+}
+
+static void test_stats_cover_last_hour(void)
+{
+    sensor_stats_t stats;
+    sensor_bucket_t buckets[SENSOR_HISTORY_MINUTE_LEN + 1];
+    float lo = INFINITY, hi = -INFINITY;
+    
+    TEST_CHECK_EQ(ESP_OK, sensor_history_stats(SENSOR_TEMPERATURE, SENSOR_TIER_MINUTE, 60, &stats));
+    int n = sensor_history_read(SENSOR_TEMPERATURE, SENSOR_TIER_MINUTE, buckets, 60);
+    int entries = 0;
+    for (int i = 0; i < n; i++) {
+        if (buckets[i].avg == SENSOR_HISTORY_NO_DATA) continue;
+        entries++;
+        if (sensor_history_to_float(SENSOR_TEMPERATURE, buckets[i].min) < lo) lo = sensor_history_to_float(SENSOR_TEMPERATURE, buckets[i].min);
+        if (sensor_history_to_float(SENSOR_TEMPERATURE, buckets[i].max) > hi) hi = sensor_history_to_float(SENSOR_TEMPERATURE, buckets[i].max);
+    }
+    TEST_CHECK_EQ(entries, stats.entries);
+    TEST_CHECK(stats.min == lo);
+    TEST_CHECK(stats.max == hi);
+    TEST_CHECK(stats.avg >= lo && stats.avg <= hi);
+    
+    // A quantity never recorded has nothing to summarize
+    TEST_CHECK_EQ(ESP_ERR_NOT_FOUND, sensor_history_stats(SENSOR_PRESSURE, SENSOR_TIER_MINUTE, 60, &stats));
+}
+
+static void test_read_since(void)
+{
+    sensor_bucket_t got[SENSOR_HISTORY_RAW_LEN];
+    uint32_t seq = 0;
+    
+    sensor_history_init();
+    for (int i = 0; i < 10; i++) {
+        sensor_history_add(SENSOR_HUMIDITY, 40.0f + i, i);
+    }
+    TEST_CHECK_EQ(10, sensor_history_read_since(SENSOR_HUMIDITY, &seq, got, SENSOR_HISTORY_RAW_LEN));
+    TEST_CHECK_EQ(0, sensor_history_read_since(SENSOR_HUMIDITY, &seq, got, SENSOR_HISTORY_RAW_LEN));
+    
+    // More new readings than the ring holds: only the newest are left
+    for (int i = 0; i < SENSOR_HISTORY_RAW_LEN + 30; i++) {
+        sensor_history_add(SENSOR_HUMIDITY, 50.0f, 10 + i);
+    }
+    sensor_history_add(SENSOR_HUMIDITY, 60.0f, 500);
+    int n = sensor_history_read_since(SENSOR_HUMIDITY, &seq, got, 5);
+    TEST_CHECK_EQ(5, n);
+    TEST_CHECK_EQ(sensor_history_from_float(SENSOR_HUMIDITY, 60.0f), got[n - 1].avg);
+}
+
+int main(void)
+{
+    RUN_TEST(test_rollups_match_reference);
+    RUN_TEST(test_stats_cover_last_hour);
+    RUN_TEST(test_read_since);
+    return test_summary();
+}
@@ -0,0 +1,172 @@
+#include "test_common.h"
+#include "app_config.h"
+#include "esp_timer.h"
+#include "sensor_history.h"
+#include "sensor_manager.h"
+#include "sensor_sim.h"
+
+// Sensor updates on simulated sensors: the conversions overlap so an update
+// lasts about as long as the slowest one, and a sensor that never becomes
+// ready fails the update at SENSOR_CONVERSION_TIMEOUT_MS
+
+#define RUNS        3       // Upper bounds use the fastest run, lower bounds every run
+
+static sensor_sim_t s_sims[SENSOR_QUANTITY_MAX];
+static uint32_t s_seq[SENSOR_QUANTITY_MAX];
+
+// Duration of one update in microseconds, its result in *ret
+static int64_t timed_update(esp_err_t *ret)
+{
+    int64_t start = esp_timer_get_time();
+    *ret = sensor_manager_update();
+    return esp_timer_get_time() - start;
+}
+
+// Fastest of RUNS updates, all of which must succeed and last at least min_us
+static int64_t fastest_update(int64_t min_us)
+{
+    int64_t fastest = INT64_MAX;
+    esp_err_t ret;
+    
+    for (int run = 0; run < RUNS; run++) {
+        int64_t us = timed_update(&ret);
+        TEST_CHECK_EQ(ESP_OK, ret);
+        TEST_CHECK(us >= min_us);
+        if (us < fastest) fastest = us;
+    }
+    return fastest;
+}
+
+// The newest raw reading of quantity recorded since the last call
+static int16_t newest_reading(sensor_quantity_t quantity)
+{
+    sensor_bucket_t raw[SENSOR_HISTORY_RAW_LEN];
+    int n = sensor_history_read_since(quantity, &s_seq[quantity], raw, SENSOR_HISTORY_RAW_LEN);
+    return n > 0 ? raw[n - 1].avg : SENSOR_HISTORY_NO_DATA;
+}
+
+static void test_requires_init(void)
+{
+    sensor_data_t data;
+    
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, sensor_manager_update());
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, sensor_manager_get_data(&data));
+    TEST_CHECK(!sensor_manager_is_data_valid());
+}
+
+static void test_default_sensors_overlap(void)
+{
+    static const uint32_t sim_us[] = {
+        SENSOR_SIM_TEMPERATURE_US, SENSOR_SIM_HUMIDITY_US, SENSOR_SIM_PRESSURE_US, SENSOR_SIM_LIGHT_US,
+    };
+    uint32_t longest = 0, sum = 0;
+    sensor_data_t data;
+    
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        sum += sim_us[i];
+        if (sim_us[i] > longest) longest = sim_us[i];
+    }
+    
+    TEST_CHECK_EQ(ESP_OK, sensor_manager_init());
+    TEST_CHECK_EQ(ESP_OK, sensor_manager_get_data(&data));
+    TEST_CHECK(!data.data_valid);
+    
+    int64_t us = fastest_update(longest);
+    TEST_CHECK(us < (longest + sum) / 2);
+    TEST_CHECK(sensor_manager_is_data_valid());
+    TEST_CHECK_EQ(ESP_OK, sensor_manager_get_data(&data));
+    TEST_CHECK(data.temperature >= 18.0f && data.temperature <= 27.0f);
+    TEST_CHECK(data.pressure >= 1000.0f && data.pressure <= 1030.0f);
+    TEST_CHECK(data.light_level <= 1000);
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        TEST_CHECK(newest_reading(i) != SENSOR_HISTORY_NO_DATA);
+    }
+}
+
+// Registered sensors of 5, 10, 15 and 40 ms: about 40 ms, far from the 70 ms sum
+static void test_registered_sensors_overlap(void)
+{
+    static const uint32_t latency_us[SENSOR_QUANTITY_MAX] = { 5000, 10000, 15000, 40000 };
+    sensor_driver_t driver;
+    
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        sensor_sim_init(&s_sims[i], i, latency_us[i], &driver);
+        TEST_CHECK_EQ(ESP_OK, sensor_manager_register(&driver));
+    }
+    
+    int64_t us = fastest_update(40000);
+    TEST_CHECK(us < 55000);
+    TEST_CHECK(sensor_manager_is_data_valid());
+}
+
+static int s_stuck_polls;
+
+static esp_err_t stuck_start(void *ctx, uint32_t *conversion_us)
+{
+    *conversion_us = 2000;
+    return ESP_OK;
+}
+
+static esp_err_t stuck_poll(void *ctx, bool *ready)
+{
+    s_stuck_polls++;
+    *ready = false;
+    return ESP_OK;
+}
+
+static esp_err_t stuck_fetch(void *ctx, float *value)
+{
+    return ESP_ERR_INVALID_STATE;
+}
+
+static const sensor_driver_ops_t s_stuck_ops = {
+    .start = stuck_start,
+    .poll = stuck_poll,
+    .fetch = stuck_fetch,
+};
+
+static void test_stuck_sensor_times_out(void)
+{
+    const sensor_driver_t stuck = {
+        .name = "stuck", .quantity = SENSOR_PRESSURE, .ops = &s_stuck_ops,
+    };
+    sensor_driver_t driver;
+    sensor_data_t data;
+    esp_err_t ret;
+    
+    TEST_CHECK_EQ(ESP_OK, sensor_manager_register(&stuck));
+    for (int i = 0; i < SENSOR_QUANTITY_MAX; i++) {
+        newest_reading(i);
+    }
+    
+    // Polled every tick until the timeout, then given up on
+    int64_t us = timed_update(&ret);
+    TEST_CHECK_EQ(ESP_ERR_TIMEOUT, ret);
+    TEST_CHECK(us >= SENSOR_CONVERSION_TIMEOUT_MS * 1000);
+    TEST_CHECK(us < SENSOR_CONVERSION_TIMEOUT_MS * 1000 + 50000);
+    TEST_CHECK(s_stuck_polls > 10);
+    TEST_CHECK(!sensor_manager_is_data_valid());
+    TEST_CHECK_EQ(ESP_OK, sensor_manager_get_data(&data));
+    TEST_CHECK(!data.data_valid);
+    
+    // The stuck reading is a gap; the others were still recorded
+    TEST_CHECK_EQ(SENSOR_HISTORY_NO_DATA, newest_reading(SENSOR_PRESSURE));
+    TEST_CHECK(newest_reading(SENSOR_TEMPERATURE) != SENSOR_HISTORY_NO_DATA);
+    TEST_CHECK(newest_reading(SENSOR_LIGHT) != SENSOR_HISTORY_NO_DATA);
+    
+    // A working sensor in its place recovers
+    sensor_sim_init(&s_sims[SENSOR_PRESSURE], SENSOR_PRESSURE, 15000, &driver);
+    TEST_CHECK_EQ(ESP_OK, sensor_manager_register(&driver));
+    TEST_CHECK_EQ(ESP_OK, sensor_manager_update());
+    TEST_CHECK(sensor_manager_is_data_valid());
+    TEST_CHECK(newest_reading(SENSOR_PRESSURE) != SENSOR_HISTORY_NO_DATA);
+}
+
+int main(void)
+{
+    RUN_TEST(test_requires_init);
+    RUN_TEST(test_default_sensors_overlap);
+    RUN_TEST(test_registered_sensors_overlap);
+    RUN_TEST(test_stuck_sensor_times_out);
+    return test_summary();
+}
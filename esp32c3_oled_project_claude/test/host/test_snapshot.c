@@ -0,0 +1,92 @@
+#include <pthread.h>
+#include "test_common.h"
+#include "snapshot.h"
+
+// One writer publishing as fast as it can while readers check that every value
+// they get is complete and that values never go backwards
+
+#define WRITES      500000
+#define READERS     3
+#define WORDS       256
+
+typedef struct {
+    uint32_t seq;
+    uint32_t words[WORDS];      // All equal to seq in a complete value
+} value_t;
+
+static value_t s_copies[2];
+static snapshot_t s_snap = SNAPSHOT_INIT(s_copies);
+static volatile bool s_done;
+
+typedef struct {
+    uint32_t reads;
+    uint32_t torn;
+    uint32_t backwards;
+} reader_result_t;
+
+static void *writer(void *arg)
+{
+    value_t value;
+    
+    for (uint32_t seq = 1; seq <= WRITES; seq++) {
+        value.seq = seq;
+        for (int i = 0; i < WORDS; i++) {
+            value.words[i] = seq;
+        }
+        snapshot_write(&s_snap, &value);
+    }
+    s_done = true;
+    return NULL;
+}
+
+static void *reader(void *arg)
+{
+    reader_result_t *result = arg;
+    uint32_t last = 0;
+    value_t value;
+    
+    while (!s_done) {
+        snapshot_read(&s_snap, &value);
+        result->reads++;
+        for (int i = 0; i < WORDS; i++) {
+            if (value.words[i] != value.seq) {
+                result->torn++;
+                break;
+            }
+        }
+        if (value.seq < last) {
+            result->backwards++;
+        }
+        last = value.seq;
+    }
+    return NULL;
+}
+
+static void test_readers_see_whole_values(void)
+{
+    pthread_t writer_thread, reader_threads[READERS];
+    reader_result_t results[READERS] = { 0 };
+    
+    for (int i = 0; i < READERS; i++) {
+        pthread_create(&reader_threads[i], NULL, reader, &results[i]);
+    }
+    pthread_create(&writer_thread, NULL, writer, NULL);
+    pthread_join(writer_thread, NULL);
+    
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(reader_threads[i], NULL);
+        TEST_CHECK(results[i].reads > 0);
+        TEST_CHECK_EQ(0, results[i].torn);
+        TEST_CHECK_EQ(0, results[i].backwards);
+    }
+    
+    value_t last;
+    snapshot_read(&s_snap, &last);
+    TEST_CHECK_EQ(WRITES, last.seq);
+}
+
+int main(void)
+{
+    RUN_TEST(test_readers_see_whole_values);
+    return test_summary();
+}
@@ -0,0 +1,121 @@
+#include "test_common.h"
+#include "sparkline.h"
+
+// Scrolled plots against a full redraw of the same samples, and every column
+// kept inside the plot area whatever the sample before the window holds
+
+#define PUSHES      4000
+
+#define PLOT_X      10
+#define PLOT_Y      20
+#define PLOT_W      64
+#define PLOT_H      16
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+
+static int16_t random_sample(int16_t *walk)
+{
+    if (rand() % 40 == 0) {
+        return SPARKLINE_GAP;
+    }
+    // Mostly small steps with the odd jump that forces a new axis
+    *walk += (rand() % 100 == 0) ? rand() % 2000 - 1000 : rand() % 11 - 5;
+    return *walk;
+}
+
+static int pixels_outside_plot(void)
+{
+    int outside = 0;
+    
+    for (int y = 0; y < SSD1306_HEIGHT; y++) {
+        for (int x = 0; x < SSD1306_WIDTH; x++) {
+            bool inside = x >= PLOT_X && x < PLOT_X + PLOT_W && y >= PLOT_Y && y < PLOT_Y + PLOT_H;
+            if (!inside && ssd1306_mem_get_pixel(s_transport, x, y)) {
+                outside++;
+            }
+        }
+    }
+    return outside;
+}
+
+static void check_scrolling(sparkline_style_t style)
+{
+    sparkline_t spark;
+    test_image_t scrolled;
+    int16_t walk = 0;
+    
+    ssd1306_clear_screen(s_dev, 0x00);
+    sparkline_init(&spark, PLOT_X, PLOT_Y, PLOT_W, PLOT_H, style, 20);
+    for (int i = 0; i < PUSHES; ) {
+        int n = rand() % 3 + 1;
+        for (int k = 0; k < n; k++, i++) {
+            sparkline_push(&spark, random_sample(&walk));
+        }
+        sparkline_render(&spark, s_dev);
+        ssd1306_refresh_gram(s_dev);
+        ssd1306_mem_get_frame(s_transport, scrolled.bytes);
+        
+        // Same samples and axis drawn from scratch
+        sparkline_invalidate(&spark);
+        TEST_CHECK_EQ(PLOT_W, sparkline_render(&spark, s_dev));
+        ssd1306_refresh_gram(s_dev);
+        if (test_panel_diff(s_transport, &scrolled) != 0 || pixels_outside_plot() != 0) {
+            fprintf(stderr, "  after %d samples, style %d, axis %d..%d\n", i, style, spark.lo, spark.hi);
+            TEST_CHECK(!"scrolled plot differs from full redraw");
+            return;
+        }
+    }
+}
+
+static void test_line_scrolling(void)
+{
+    srand(14);
+    check_scrolling(SPARKLINE_LINE);
+}
+
+static void test_bars_scrolling(void)
+{
+    srand(15);
+    check_scrolling(SPARKLINE_BARS);
+}
+
+// The sample before the leftmost column is not part of the axis fit; a line
+// joining it must stop at the plot edge
+static void test_line_clamped_to_plot(void)
+{
+    static const int16_t outliers[] = { INT16_MAX, 30000, -30000, INT16_MIN + 1 };
+    sparkline_t spark;
+    
+    for (size_t i = 0; i < sizeof(outliers) / sizeof(outliers[0]); i++) {
+        ssd1306_clear_screen(s_dev, 0x00);
+        sparkline_init(&spark, PLOT_X, PLOT_Y, PLOT_W, PLOT_H, SPARKLINE_LINE, 20);
+        sparkline_push(&spark, outliers[i]);
+        for (int k = 0; k < PLOT_W; k++) {
+            sparkline_push(&spark, k % 7);
+        }
+        sparkline_render(&spark, s_dev);
+        ssd1306_refresh_gram(s_dev);
+        
+        TEST_CHECK_EQ(0, pixels_outside_plot());
+        // Column 0 runs all the way to the edge facing the outlier
+        int edge = outliers[i] > 0 ? PLOT_Y : PLOT_Y + PLOT_H - 1;
+        TEST_CHECK(ssd1306_mem_get_pixel(s_transport, PLOT_X, edge));
+    }
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    if (s_dev == NULL) {
+        fprintf(stderr, "panel setup failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    RUN_TEST(test_line_scrolling);
+    RUN_TEST(test_bars_scrolling);
+    RUN_TEST(test_line_clamped_to_plot);
+    
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
@@ -0,0 +1,128 @@
+#include "test_common.h"
+#include "ssd1306_gfx.h"
+
+// Shifted-byte blits against a per-pixel model for every raster op, with and
+// without a mask, at positions that straddle every panel edge.
+
+#define ITERATIONS  3000
+#define MAX_W       40
+#define MAX_H       30
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+static test_image_t s_model;
+
+static bool bitmap_bit(const uint8_t *bytes, int width, int col, int row)
+{
+    return (bytes[(row / 8) * width + col] >> (row % 8)) & 1;
+}
+
+static void model_blit(int x, int y, const ssd1306_bitmap_t *bmp, ssd1306_rop_t rop)
+{
+    for (int row = 0; row < bmp->height; row++) {
+        for (int col = 0; col < bmp->width; col++) {
+            int px = x + col, py = y + row;
+            if (px < 0 || py < 0 || px >= SSD1306_WIDTH || py >= SSD1306_HEIGHT) continue;
+            if (bmp->mask && !bitmap_bit(bmp->mask, bmp->width, col, row)) continue;
+            
+            bool src = bitmap_bit(bmp->data, bmp->width, col, row);
+            bool dst = test_image_get(&s_model, px, py);
+            switch (rop) {
+                case SSD1306_ROP_COPY:    dst = src; break;
+                case SSD1306_ROP_OR:      dst = dst || src; break;
+                case SSD1306_ROP_AND_NOT: dst = dst && !src; break;
+                case SSD1306_ROP_XOR:     dst = dst != src; break;
+            }
+            test_image_set(&s_model, px, py, dst);
+        }
+    }
+}
+
+static void random_bytes(uint8_t *bytes, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        bytes[i] = rand();
+    }
+}
+
+// Random background in both the driver buffer and the model
+static void random_background(void)
+{
+    ssd1306_clear_screen(s_dev, 0x00);
+    memset(&s_model, 0, sizeof(s_model));
+    for (int i = 0; i < 6; i++) {
+        int x = rand() % SSD1306_WIDTH, y = rand() % SSD1306_HEIGHT;
+        int w = rand() % 60 + 1, h = rand() % 40 + 1;
+        ssd1306_fill_rect(s_dev, x, y, w, h, 1);
+        for (int py = y; py < y + h; py++) {
+            for (int px = x; px < x + w; px++) {
+                test_image_set(&s_model, px, py, true);
+            }
+        }
+    }
+}
+
+static void test_blit_matches_model(void)
+{
+    uint8_t data[MAX_W * ((MAX_H + 7) / 8)];
+    uint8_t mask[sizeof(data)];
+    
+    srand(12);
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_bitmap_t bmp = {
+            .width = rand() % MAX_W + 1,
+            .height = rand() % MAX_H + 1,
+            .data = data,
+            .mask = (rand() & 1) ? mask : NULL,
+        };
+        random_bytes(data, sizeof(data));
+        random_bytes(mask, sizeof(mask));
+        int x = rand() % (SSD1306_WIDTH + 2 * MAX_W) - MAX_W;
+        int y = rand() % (SSD1306_HEIGHT + 2 * MAX_H) - MAX_H;
+        ssd1306_rop_t rop = rand() % 4;
+        
+        if (i % 50 == 0) {
+            random_background();
+        }
+        ssd1306_blit(s_dev, x, y, &bmp, rop);
+        model_blit(x, y, &bmp, rop);
+        ssd1306_refresh_gram(s_dev);
+        if (test_panel_diff(s_transport, &s_model) != 0) {
+            fprintf(stderr, "  after blit %dx%d at %d,%d rop %d%s\n",
+                    bmp.width, bmp.height, x, y, rop, bmp.mask ? " masked" : "");
+            TEST_CHECK(!"blit differs from model");
+            break;
+        }
+    }
+}
+
+static void test_xor_twice_restores(void)
+{
+    uint8_t data[MAX_W * ((MAX_H + 7) / 8)];
+    
+    srand(13);
+    random_background();
+    ssd1306_refresh_gram(s_dev);
+    random_bytes(data, sizeof(data));
+    ssd1306_bitmap_t bmp = { .width = MAX_W, .height = MAX_H, .data = data };
+    
+    ssd1306_blit(s_dev, 50, 21, &bmp, SSD1306_ROP_XOR);
+    ssd1306_blit(s_dev, 50, 21, &bmp, SSD1306_ROP_XOR);
+    ssd1306_refresh_gram(s_dev);
+    TEST_CHECK_EQ(0, test_panel_diff(s_transport, &s_model));
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    if (s_dev == NULL) {
+        fprintf(stderr, "panel setup failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    RUN_TEST(test_blit_matches_model);
+    RUN_TEST(test_xor_twice_restores);
+    
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
@@ -0,0 +1,164 @@
+#include <unistd.h>
+#include "test_common.h"
+#include "esp_timer.h"
+#include "ssd1306_bus.h"
+
+// Shared-bus scheduler with two emulated panels, frame timing across failed
+// transfers and statistics read while a slow frame is in flight
+
+#define FRAMES      200
+
+// Memory transport that can be told to fail or stall every transfer
+typedef struct {
+    ssd1306_transport_t base;
+    ssd1306_transport_t *panel;
+    volatile bool fail;
+    volatile uint32_t stall_us;
+} flaky_transport_t;
+
+static esp_err_t flaky_transmit(ssd1306_transport_t *transport, const uint8_t *data, size_t len)
+{
+    flaky_transport_t *flaky = (flaky_transport_t *)transport;
+    
+    if (flaky->fail) {
+        return ESP_FAIL;
+    }
+    if (flaky->stall_us) {
+        usleep(flaky->stall_us);
+    }
+    return flaky->panel->transmit(flaky->panel, data, len);
+}
+
+static void flaky_del(ssd1306_transport_t *transport)
+{
+    flaky_transport_t *flaky = (flaky_transport_t *)transport;
+    
+    flaky->panel->del(flaky->panel);
+    free(flaky);
+}
+
+static ssd1306_handle_t flaky_panel_create(flaky_transport_t **ret_flaky)
+{
+    flaky_transport_t *flaky = calloc(1, sizeof(*flaky));
+    
+    ssd1306_new_transport_mem(400000, &flaky->panel);
+    flaky->base.transmit = flaky_transmit;
+    flaky->base.del = flaky_del;
+    
+    ssd1306_handle_t dev = ssd1306_create_with_transport(&flaky->base);
+    ssd1306_init(dev);
+    ssd1306_refresh_gram(dev);
+    *ret_flaky = flaky;
+    return dev;
+}
+
+static void draw_random_points(ssd1306_handle_t dev, test_image_t *model, int count)
+{
+    for (int i = 0; i < count; i++) {
+        int x = rand() % SSD1306_WIDTH;
+        int y = rand() % SSD1306_HEIGHT;
+        bool on = rand() & 1;
+        ssd1306_draw_point(dev, x, y, on);
+        test_image_set(model, x, y, on);
+    }
+}
+
+static void test_two_panels_share_bus(void)
+{
+    ssd1306_bus_handle_t bus;
+    flaky_transport_t *flaky[2];
+    ssd1306_handle_t dev[2];
+    test_image_t model[2] = { 0 };
+    ssd1306_bus_stats_t stats;
+    
+    TEST_CHECK_EQ(ESP_OK, ssd1306_bus_create(5, &bus));
+    for (int i = 0; i < 2; i++) {
+        dev[i] = flaky_panel_create(&flaky[i]);
+        TEST_CHECK_EQ(ESP_OK, ssd1306_bus_add_panel(bus, dev[i]));
+    }
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, ssd1306_bus_add_panel(bus, dev[0]));
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, ssd1306_enable_async(dev[0], 5));
+    
+    // Panel 0 redraws everything every frame, panel 1 changes a few pixels
+    srand(10);
+    for (int frame = 0; frame < FRAMES; frame++) {
+        ssd1306_invalidate(dev[0]);
+        draw_random_points(dev[0], &model[0], 30);
+        draw_random_points(dev[1], &model[1], 3);
+        TEST_CHECK_EQ(ESP_OK, ssd1306_refresh_gram_async(dev[0]));
+        TEST_CHECK_EQ(ESP_OK, ssd1306_refresh_gram_async(dev[1]));
+    }
+    for (int i = 0; i < 2; i++) {
+        TEST_CHECK_EQ(ESP_OK, ssd1306_wait_flush(dev[i], 1000));
+        TEST_CHECK_EQ(0, test_panel_diff(flaky[i]->panel, &model[i]));
+        
+        TEST_CHECK_EQ(ESP_OK, ssd1306_bus_get_stats(dev[i], &stats));
+        TEST_CHECK(stats.frames > 0 && stats.frames <= FRAMES);
+        TEST_CHECK(stats.last_latency_us <= stats.max_latency_us);
+        TEST_CHECK(stats.avg_latency_us <= stats.max_latency_us);
+    }
+    
+    TEST_CHECK_EQ(ESP_OK, ssd1306_bus_remove_panel(bus, dev[1]));
+    TEST_CHECK_EQ(ESP_ERR_INVALID_ARG, ssd1306_bus_get_stats(dev[1], &stats));
+    ssd1306_delete(dev[1]);
+    ssd1306_bus_delete(bus);
+    ssd1306_delete(dev[0]);
+}
+
+static void test_failed_frame_is_retried(void)
+{
+    flaky_transport_t *flaky;
+    ssd1306_handle_t dev = flaky_panel_create(&flaky);
+    test_image_t model = { 0 };
+    ssd1306_flush_stats_t flush;
+    
+    // The failed pages stay dirty and go out with the next frame
+    draw_random_points(dev, &model, 50);
+    flaky->fail = true;
+    ssd1306_refresh_gram(dev);
+    flaky->fail = false;
+    usleep(30000);
+    draw_random_points(dev, &model, 5);
+    ssd1306_refresh_gram(dev);
+    TEST_CHECK_EQ(0, test_panel_diff(flaky->panel, &model));
+    
+    // That frame is timed from its own first transfer, not from the failed one
+    TEST_CHECK_EQ(ESP_OK, ssd1306_get_flush_stats(dev, &flush));
+    TEST_CHECK(flush.flush_us < 20000);
+    ssd1306_delete(dev);
+}
+
+static void test_flush_stats_do_not_wait(void)
+{
+    flaky_transport_t *flaky;
+    ssd1306_handle_t dev = flaky_panel_create(&flaky);
+    test_image_t model = { 0 };
+    ssd1306_flush_stats_t before, flush;
+    
+    TEST_CHECK_EQ(ESP_OK, ssd1306_enable_async(dev, 5));
+    TEST_CHECK_EQ(ESP_OK, ssd1306_get_flush_stats(dev, &before));
+    flaky->stall_us = 100000;
+    draw_random_points(dev, &model, 20);
+    TEST_CHECK_EQ(ESP_OK, ssd1306_refresh_gram_async(dev));
+    usleep(10000);
+    
+    // The frame in flight is not waited for; the last complete one is reported
+    int64_t start = esp_timer_get_time();
+    TEST_CHECK_EQ(ESP_OK, ssd1306_get_flush_stats(dev, &flush));
+    TEST_CHECK(esp_timer_get_time() - start < 20000);
+    TEST_CHECK_EQ(before.frames, flush.frames);
+    
+    flaky->stall_us = 0;
+    TEST_CHECK_EQ(ESP_OK, ssd1306_wait_flush(dev, 1000));
+    TEST_CHECK_EQ(ESP_OK, ssd1306_get_flush_stats(dev, &flush));
+    TEST_CHECK_EQ(before.frames + 1, flush.frames);
+    ssd1306_delete(dev);
+}
+
+int main(void)
+{
+    RUN_TEST(test_two_panels_share_bus);
+    RUN_TEST(test_failed_frame_is_retried);
+    RUN_TEST(test_flush_stats_do_not_wait);
+    return test_summary();
+}
@@ -0,0 +1,128 @@
+#include "test_common.h"
+
+// Page-packed rectangle primitives against a per-pixel model. Every frame is
+// refreshed and compared on the emulated panel, so missing dirty columns
+// show up as differences too.
+
+#define ITERATIONS  3000
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+static test_image_t s_model;
+
+// Random origin on the panel and a size that may run past its edge
+static void random_rect(int *x, int *y, int *w, int *h)
+{
+    *x = rand() % SSD1306_WIDTH;
+    *y = rand() % SSD1306_HEIGHT;
+    *w = rand() % 140;
+    *h = rand() % 70;
+}
+
+static void model_fill(int x, int y, int w, int h, bool on)
+{
+    for (int py = y; py < y + h; py++) {
+        for (int px = x; px < x + w; px++) {
+            test_image_set(&s_model, px, py, on);
+        }
+    }
+}
+
+static bool frame_matches(void)
+{
+    ssd1306_refresh_gram(s_dev);
+    return test_panel_diff(s_transport, &s_model) == 0;
+}
+
+static void test_fill_rect(void)
+{
+    int x, y, w, h;
+    
+    srand(4);
+    for (int i = 0; i < ITERATIONS; i++) {
+        random_rect(&x, &y, &w, &h);
+        bool on = rand() & 1;
+        ssd1306_fill_rect(s_dev, x, y, w, h, on);
+        model_fill(x, y, w, h, on);
+        if (!frame_matches()) {
+            fprintf(stderr, "  after fill_rect(%d, %d, %d, %d, %d)\n", x, y, w, h, on);
+            TEST_CHECK(!"fill_rect differs from model");
+            break;
+        }
+    }
+}
+
+static void test_lines(void)
+{
+    int x, y, w, h;
+    
+    srand(5);
+    for (int i = 0; i < ITERATIONS; i++) {
+        random_rect(&x, &y, &w, &h);
+        bool on = rand() & 1;
+        if (i & 1) {
+            ssd1306_draw_hline(s_dev, x, y, w, on);
+            model_fill(x, y, w, 1, on);
+        } else {
+            ssd1306_draw_vline(s_dev, x, y, h, on);
+            model_fill(x, y, 1, h, on);
+        }
+        if (!frame_matches()) {
+            fprintf(stderr, "  after %s(%d, %d, %d, %d)\n", (i & 1) ? "hline" : "vline", x, y, (i & 1) ? w : h, on);
+            TEST_CHECK(!"line differs from model");
+            break;
+        }
+    }
+}
+
+static void test_invert_rect(void)
+{
+    int x, y, w, h;
+    
+    srand(6);
+    for (int i = 0; i < ITERATIONS; i++) {
+        random_rect(&x, &y, &w, &h);
+        ssd1306_invert_rect(s_dev, x, y, w, h);
+        for (int py = y; py < y + h && py < SSD1306_HEIGHT; py++) {
+            for (int px = x; px < x + w && px < SSD1306_WIDTH; px++) {
+                test_image_set(&s_model, px, py, !test_image_get(&s_model, px, py));
+            }
+        }
+        if (!frame_matches()) {
+            fprintf(stderr, "  after invert_rect(%d, %d, %d, %d)\n", x, y, w, h);
+            TEST_CHECK(!"invert_rect differs from model");
+            break;
+        }
+    }
+}
+
+static void test_unchanged_fill_sends_nothing(void)
+{
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_fill_rect(s_dev, 3, 5, 60, 30, 1);
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_reset_stats(s_transport);
+    ssd1306_fill_rect(s_dev, 10, 9, 20, 10, 1);
+    ssd1306_draw_hline(s_dev, 3, 5, 60, 1);
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_get_stats(s_transport, &stats);
+    TEST_CHECK_EQ(0, stats.transfers);
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    if (s_dev == NULL) {
+        fprintf(stderr, "panel setup failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    RUN_TEST(test_fill_rect);
+    RUN_TEST(test_lines);
+    RUN_TEST(test_invert_rect);
+    RUN_TEST(test_unchanged_fill_sends_nothing);
+    
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
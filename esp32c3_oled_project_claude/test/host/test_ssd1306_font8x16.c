@@ -0,0 +1,77 @@
+#include "test_common.h"
+#include "font8x16_rows.h"
+
+// The 8x16 font as drawn by the driver against the row-major table it was
+// transposed from, pixel by pixel, so a transposition error in the
+// column-major atlas shows up here
+
+#define FIRST_CHAR  32
+#define CHAR_COUNT  (int)(sizeof(font8x16_rows) / sizeof(font8x16_rows[0]))
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+
+static void model_char(test_image_t *img, int x, int y, int index)
+{
+    for (int row = 0; row < 16; row++) {
+        for (int col = 0; col < 8; col++) {
+            if (font8x16_rows[index][row] & (0x80 >> col)) {
+                test_image_set(img, x + col, y + row, true);
+            }
+        }
+    }
+}
+
+// Every character alone on a cleared panel, page aligned and not
+static void test_chars_match_rows(void)
+{
+    static const int ys[] = { 8, 13, 48 };
+    
+    TEST_CHECK_EQ(95, CHAR_COUNT);
+    for (int index = 0; index < CHAR_COUNT; index++) {
+        for (size_t i = 0; i < sizeof(ys) / sizeof(ys[0]); i++) {
+            test_image_t model = {0};
+            int x = 17 + index % 7;
+            
+            ssd1306_clear_screen(s_dev, 0);
+            ssd1306_show_char(s_dev, x, ys[i], FIRST_CHAR + index, 16, 1);
+            ssd1306_refresh_gram(s_dev);
+            model_char(&model, x, ys[i], index);
+            if (test_panel_diff(s_transport, &model) != 0) {
+                fprintf(stderr, "  character '%c' at %d,%d\n", FIRST_CHAR + index, x, ys[i]);
+                TEST_CHECK(!"glyph differs from the row-major font");
+            }
+        }
+    }
+}
+
+// A whole string, the way the display modes draw their large text
+static void test_string_matches_rows(void)
+{
+    const char *text = "Az09 %&@{|}~";
+    test_image_t model = {0};
+    int x = 3;
+    
+    ssd1306_clear_screen(s_dev, 0);
+    ssd1306_show_string(s_dev, x, 21, text, 16, 1);
+    ssd1306_refresh_gram(s_dev);
+    for (const char *p = text; *p; p++, x += 8) {
+        model_char(&model, x, 21, *p - FIRST_CHAR);
+    }
+    TEST_CHECK_EQ(0, test_panel_diff(s_transport, &model));
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    if (s_dev == NULL) {
+        fprintf(stderr, "panel setup failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    RUN_TEST(test_chars_match_rows);
+    RUN_TEST(test_string_matches_rows);
+    
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
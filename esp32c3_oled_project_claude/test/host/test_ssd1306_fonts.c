@@ -0,0 +1,139 @@
+#include "test_common.h"
+
+// Glyph blits against a reference renderer that reads the font descriptors
+// pixel by pixel, at page-aligned and unaligned positions and at the edges
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+static test_image_t s_model;
+
+static const ssd1306_font_t *const s_fonts[] = {
+    &ssd1306_font_6x8,
+    &ssd1306_font_8x16,
+    &ssd1306_font_prop8,
+};
+
+static uint8_t glyph_width(const ssd1306_font_t *font, uint8_t index)
+{
+    return font->widths ? font->widths[index] : font->width;
+}
+
+static bool glyph_pixel(const ssd1306_font_t *font, uint8_t index, int col, int row)
+{
+    uint8_t width = glyph_width(font, index);
+    const uint8_t *glyph = font->widths ? &font->bitmap[font->offsets[index]]
+                                        : &font->bitmap[index * width * (font->height / 8)];
+    return (glyph[(row / 8) * width + col] >> (row % 8)) & 1;
+}
+
+static void model_glyph(const ssd1306_font_t *font, int x, int y, uint8_t chr, bool draw)
+{
+    if (chr < font->first_char || chr > font->last_char) {
+        chr = ' ';
+    }
+    uint8_t index = chr - font->first_char;
+    uint8_t width = glyph_width(font, index);
+    int columns = draw ? width : width + font->spacing;
+    
+    for (int row = 0; row < font->height; row++) {
+        for (int col = 0; col < columns; col++) {
+            if (!draw) {
+                test_image_set(&s_model, x + col, y + row, false);
+            } else if (glyph_pixel(font, index, col, row)) {
+                test_image_set(&s_model, x + col, y + row, true);
+            }
+        }
+    }
+}
+
+static void test_glyphs_match_reference(void)
+{
+    srand(6);
+    for (int i = 0; i < 4000; i++) {
+        const ssd1306_font_t *font = s_fonts[rand() % 3];
+        int x = rand() % SSD1306_WIDTH;
+        int y = rand() % SSD1306_HEIGHT;
+        uint8_t chr = font->first_char + rand() % (font->last_char - font->first_char + 1);
+        bool draw = rand() % 4 != 0;
+        
+        // Random background, so both the OR and the cell clear are visible
+        if (i % 50 == 0) {
+            for (int k = 0; k < 200; k++) {
+                int bx = rand() % SSD1306_WIDTH;
+                int by = rand() % SSD1306_HEIGHT;
+                ssd1306_fill_rect(s_dev, bx, by, 8, 3, 1);
+                for (int py = by; py < by + 3; py++) {
+                    for (int px = bx; px < bx + 8; px++) {
+                        test_image_set(&s_model, px, py, true);
+                    }
+                }
+            }
+        }
+        
+        uint8_t advance = ssd1306_draw_glyph(s_dev, x, y, chr, font, draw);
+        model_glyph(font, x, y, chr, draw);
+        TEST_CHECK_EQ(glyph_width(font, chr - font->first_char) + font->spacing, advance);
+        
+        ssd1306_refresh_gram(s_dev);
+        if (test_panel_diff(s_transport, &s_model) != 0) {
+            fprintf(stderr, "  after glyph '%c' (font height %d) at %d,%d mode %d\n", chr, font->height, x, y, draw);
+            TEST_CHECK(!"glyph differs from reference");
+            break;
+        }
+    }
+}
+
+static void test_unknown_character_is_space(void)
+{
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_clear_screen(s_dev, 0);
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_reset_stats(s_transport);
+    TEST_CHECK_EQ(ssd1306_font_6x8.width + ssd1306_font_6x8.spacing,
+                  ssd1306_draw_glyph(s_dev, 10, 10, 0x80, &ssd1306_font_6x8, 1));
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_get_stats(s_transport, &stats);
+    TEST_CHECK_EQ(0, stats.transfers);
+    memset(&s_model, 0, sizeof(s_model));
+}
+
+static void test_text_width(void)
+{
+    const char *text = "Temp 23.4C";
+    
+    for (int f = 0; f < 3; f++) {
+        const ssd1306_font_t *font = s_fonts[f];
+        int expected = 0;
+        for (const char *p = text; *p; p++) {
+            expected += glyph_width(font, *p - font->first_char) + font->spacing;
+        }
+        TEST_CHECK_EQ(expected, ssd1306_text_width(font, text));
+    }
+    TEST_CHECK_EQ(60, ssd1306_text_width(&ssd1306_font_6x8, text));
+    TEST_CHECK_EQ(0, ssd1306_text_width(&ssd1306_font_8x16, ""));
+}
+
+static void test_legacy_sizes(void)
+{
+    TEST_CHECK(ssd1306_font_for_size(SSD1306_FONT_SIZE_8) == &ssd1306_font_6x8);
+    TEST_CHECK(ssd1306_font_for_size(SSD1306_FONT_SIZE_16) == &ssd1306_font_8x16);
+    TEST_CHECK(ssd1306_font_for_size(12) == NULL);
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    if (s_dev == NULL) {
+        fprintf(stderr, "panel setup failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    RUN_TEST(test_glyphs_match_reference);
+    RUN_TEST(test_unknown_character_is_space);
+    RUN_TEST(test_text_width);
+    RUN_TEST(test_legacy_sizes);
+    
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
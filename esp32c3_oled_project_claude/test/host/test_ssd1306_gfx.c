@@ -0,0 +1,185 @@
+#include "test_common.h"
+#include "ssd1306_gfx.h"
+
+// Shape primitives on the emulated panel: clipped lines against the
+// unclipped reference line, round-rect outlines and vertex-order independence.
+
+#define ITERATIONS  2000
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+static test_image_t s_model;
+
+static void reset(void)
+{
+    ssd1306_clear_screen(s_dev, 0x00);
+    memset(&s_model, 0, sizeof(s_model));
+}
+
+static bool frame_matches(void)
+{
+    ssd1306_refresh_gram(s_dev);
+    return test_panel_diff(s_transport, &s_model) == 0;
+}
+
+// Every pixel of the unclipped line, plotted only where it lands on the panel
+static void model_line(int x0, int y0, int x1, int y1)
+{
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+    bool steep = dy > dx;
+    int big_d = steep ? dy : dx;
+    int small_d = steep ? dx : dy;
+    int sa = steep ? ((y1 > y0) ? 1 : -1) : ((x1 > x0) ? 1 : -1);
+    int sb = steep ? ((x1 > x0) ? 1 : -1) : ((y1 > y0) ? 1 : -1);
+    
+    if (big_d == 0) {
+        test_image_set(&s_model, x0, y0, true);
+        return;
+    }
+    for (int i = 0; i <= big_d; i++) {
+        int a = (steep ? y0 : x0) + sa * i;
+        int b = (steep ? x0 : y0) + sb * (int)((2LL * small_d * i + big_d) / (2LL * big_d));
+        if (steep) {
+            test_image_set(&s_model, b, a, true);
+        } else {
+            test_image_set(&s_model, a, b, true);
+        }
+    }
+}
+
+static void test_lines_match_reference(void)
+{
+    srand(11);
+    for (int i = 0; i < ITERATIONS; i++) {
+        // Endpoints well outside the panel exercise the clipping
+        int x0 = rand() % 400 - 136, y0 = rand() % 200 - 68;
+        int x1 = rand() % 400 - 136, y1 = rand() % 200 - 68;
+        if (i % 4 == 0) y1 = y0;
+        if (i % 4 == 1) x1 = x0;
+        
+        reset();
+        ssd1306_gfx_line(s_dev, x0, y0, x1, y1, 1);
+        model_line(x0, y0, x1, y1);
+        if (!frame_matches()) {
+            fprintf(stderr, "  after line(%d, %d, %d, %d)\n", x0, y0, x1, y1);
+            TEST_CHECK(!"line differs from reference");
+            break;
+        }
+    }
+}
+
+// w == 2r + 1 leaves no straight top/bottom edge; the empty span must stay empty
+static void test_round_rect_narrow(void)
+{
+    static const int8_t lit[][2] = {
+        {11, 10}, {10, 11}, {12, 11}, {10, 12}, {12, 12}, {10, 13}, {12, 13}, {11, 14},
+    };
+    
+    reset();
+    ssd1306_gfx_round_rect(s_dev, 10, 10, 3, 5, 1, 1);
+    for (size_t i = 0; i < sizeof(lit) / sizeof(lit[0]); i++) {
+        test_image_set(&s_model, lit[i][0], lit[i][1], true);
+    }
+    TEST_CHECK(frame_matches());
+    
+    // Same on the other axis
+    reset();
+    ssd1306_gfx_round_rect(s_dev, 10, 10, 5, 3, 1, 1);
+    ssd1306_refresh_gram(s_dev);
+    TEST_CHECK(!ssd1306_mem_get_pixel(s_transport, 10, 10));
+    TEST_CHECK(!ssd1306_mem_get_pixel(s_transport, 14, 10));
+    TEST_CHECK(!ssd1306_mem_get_pixel(s_transport, 10, 12));
+    TEST_CHECK(!ssd1306_mem_get_pixel(s_transport, 14, 12));
+}
+
+// The outline never leaves the filled shape and never lights a corner pixel
+static void test_round_rect_inside_fill(void)
+{
+    test_image_t fill;
+    
+    srand(12);
+    for (int i = 0; i < ITERATIONS; i++) {
+        int x = rand() % 140 - 6, y = rand() % 76 - 6;
+        int w = rand() % 40 + 1, h = rand() % 30 + 1;
+        int r = rand() % 12 + 1;
+        
+        reset();
+        ssd1306_gfx_fill_round_rect(s_dev, x, y, w, h, r, 1);
+        ssd1306_refresh_gram(s_dev);
+        ssd1306_mem_get_frame(s_transport, fill.bytes);
+        
+        reset();
+        ssd1306_gfx_round_rect(s_dev, x, y, w, h, r, 1);
+        ssd1306_refresh_gram(s_dev);
+        
+        int outside = 0;
+        for (int py = 0; py < SSD1306_HEIGHT; py++) {
+            for (int px = 0; px < SSD1306_WIDTH; px++) {
+                if (ssd1306_mem_get_pixel(s_transport, px, py) && !test_image_get(&fill, px, py)) {
+                    outside++;
+                }
+            }
+        }
+        bool corner = w > 2 && h > 2 &&
+                      (ssd1306_mem_get_pixel(s_transport, x, y) ||
+                       ssd1306_mem_get_pixel(s_transport, x + w - 1, y) ||
+                       ssd1306_mem_get_pixel(s_transport, x, y + h - 1) ||
+                       ssd1306_mem_get_pixel(s_transport, x + w - 1, y + h - 1));
+        if (outside || corner) {
+            fprintf(stderr, "  round_rect(%d, %d, %d, %d, r=%d)\n", x, y, w, h, r);
+            TEST_CHECK_EQ(0, outside);
+            TEST_CHECK(!corner);
+            break;
+        }
+    }
+}
+
+static void test_fill_triangle_vertex_order(void)
+{
+    test_image_t first;
+    
+    srand(13);
+    for (int i = 0; i < 300; i++) {
+        int xs[3], ys[3];
+        for (int v = 0; v < 3; v++) {
+            xs[v] = rand() % 180 - 26;
+            ys[v] = rand() % 100 - 18;
+        }
+        
+        static const int order[6][3] = {
+            {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0},
+        };
+        for (int p = 0; p < 6; p++) {
+            const int *o = order[p];
+            reset();
+            ssd1306_gfx_fill_triangle(s_dev, xs[o[0]], ys[o[0]], xs[o[1]], ys[o[1]], xs[o[2]], ys[o[2]], 1);
+            ssd1306_refresh_gram(s_dev);
+            if (p == 0) {
+                ssd1306_mem_get_frame(s_transport, first.bytes);
+            } else if (test_panel_diff(s_transport, &first) != 0) {
+                fprintf(stderr, "  triangle (%d,%d) (%d,%d) (%d,%d), order %d\n",
+                        xs[0], ys[0], xs[1], ys[1], xs[2], ys[2], p);
+                TEST_CHECK(!"fill_triangle depends on vertex order");
+                return;
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    if (s_dev == NULL) {
+        fprintf(stderr, "panel setup failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    RUN_TEST(test_lines_match_reference);
+    RUN_TEST(test_round_rect_narrow);
+    RUN_TEST(test_round_rect_inside_fill);
+    RUN_TEST(test_fill_triangle_vertex_order);
+    
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
@@ -0,0 +1,148 @@
+#include "test_common.h"
+
+// The panel emulator itself, driven with raw command and data streams
+
+static esp_err_t send(ssd1306_transport_t *transport, const uint8_t *data, size_t len)
+{
+    return transport->transmit(transport, data, len);
+}
+
+static ssd1306_transport_t *new_panel(void)
+{
+    ssd1306_transport_t *transport;
+    static const uint8_t display_on[] = { SSD1306_CONTROL_CMD_STREAM, 0xAF };
+    
+    if (ssd1306_new_transport_mem(400000, &transport) != ESP_OK) {
+        return NULL;
+    }
+    send(transport, display_on, sizeof(display_on));
+    return transport;
+}
+
+static void test_window_wraps_within_ranges(void)
+{
+    ssd1306_transport_t *transport = new_panel();
+    static const uint8_t window[] = { SSD1306_CONTROL_CMD_STREAM, 0x21, 10, 12, 0x22, 1, 2 };
+    static const uint8_t data[] = { SSD1306_CONTROL_DATA_STREAM, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x80 };
+    uint8_t frame[SSD1306_BUFFER_SIZE];
+    
+    TEST_CHECK_EQ(ESP_OK, send(transport, window, sizeof(window)));
+    TEST_CHECK_EQ(ESP_OK, send(transport, data, sizeof(data)));
+    ssd1306_mem_get_frame(transport, frame);
+    
+    // Columns 10..12 of page 1, then of page 2, then back to the start
+    TEST_CHECK_EQ(0x80, frame[1 * SSD1306_WIDTH + 10]);
+    TEST_CHECK_EQ(0x02, frame[1 * SSD1306_WIDTH + 11]);
+    TEST_CHECK_EQ(0x04, frame[1 * SSD1306_WIDTH + 12]);
+    TEST_CHECK_EQ(0x08, frame[2 * SSD1306_WIDTH + 10]);
+    TEST_CHECK_EQ(0x20, frame[2 * SSD1306_WIDTH + 12]);
+    TEST_CHECK_EQ(0, frame[1 * SSD1306_WIDTH + 13]);
+    TEST_CHECK_EQ(0, frame[3 * SSD1306_WIDTH + 10]);
+    TEST_CHECK(ssd1306_mem_get_pixel(transport, 10, 15));
+    TEST_CHECK(!ssd1306_mem_get_pixel(transport, 10, 14));
+    transport->del(transport);
+}
+
+static void test_display_state_commands(void)
+{
+    ssd1306_transport_t *transport = new_panel();
+    static const uint8_t window[] = { SSD1306_CONTROL_CMD_STREAM, 0x21, 0, 127, 0x22, 0, 7 };
+    static const uint8_t pixel[] = { SSD1306_CONTROL_DATA_STREAM, 0x01 };
+    static const uint8_t start_line[] = { SSD1306_CONTROL_CMD_STREAM, 0x40 | 60 };
+    static const uint8_t invert[] = { SSD1306_CONTROL_CMD_STREAM, 0xA7 };
+    static const uint8_t normal_off[] = { SSD1306_CONTROL_CMD_STREAM, 0xA6, 0xAE };
+    
+    send(transport, window, sizeof(window));
+    send(transport, pixel, sizeof(pixel));
+    TEST_CHECK(ssd1306_mem_get_pixel(transport, 0, 0));
+    
+    // Screen row y shows GRAM row y + start line
+    send(transport, start_line, sizeof(start_line));
+    TEST_CHECK(!ssd1306_mem_get_pixel(transport, 0, 0));
+    TEST_CHECK(ssd1306_mem_get_pixel(transport, 0, 4));
+    
+    send(transport, invert, sizeof(invert));
+    TEST_CHECK(!ssd1306_mem_get_pixel(transport, 0, 4));
+    TEST_CHECK(ssd1306_mem_get_pixel(transport, 1, 4));
+    
+    send(transport, normal_off, sizeof(normal_off));
+    TEST_CHECK(!ssd1306_mem_get_pixel(transport, 0, 4));
+    transport->del(transport);
+}
+
+static void test_bad_control_byte(void)
+{
+    ssd1306_transport_t *transport = new_panel();
+    static const uint8_t bad[] = { 0x80, 0xAF };
+    
+    TEST_CHECK_EQ(ESP_ERR_INVALID_ARG, send(transport, bad, sizeof(bad)));
+    TEST_CHECK_EQ(ESP_ERR_INVALID_ARG, send(transport, bad, 0));
+    transport->del(transport);
+}
+
+static void test_bus_statistics(void)
+{
+    ssd1306_transport_t *transport;
+    ssd1306_handle_t dev = test_panel_create(&transport);
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_invalidate(dev);
+    ssd1306_refresh_gram(dev);
+    ssd1306_mem_get_stats(transport, &stats);
+    
+    // Window command (7 bytes) and a full frame (1025 bytes), 9 clocks per byte at 400 kHz
+    TEST_CHECK_EQ(2, stats.transfers);
+    TEST_CHECK_EQ(7 + 1 + SSD1306_BUFFER_SIZE, stats.bytes);
+    TEST_CHECK_EQ(SSD1306_BUFFER_SIZE, stats.data_bytes);
+    TEST_CHECK_EQ((8 * 9 + 2) * 5 / 2 + (1026 * 9 + 2) * 5 / 2, stats.bus_time_us);
+    
+    ssd1306_mem_reset_stats(transport);
+    ssd1306_mem_get_stats(transport, &stats);
+    TEST_CHECK_EQ(0, stats.bytes);
+    ssd1306_delete(dev);
+}
+
+static void test_pbm_output(void)
+{
+    ssd1306_transport_t *transport;
+    ssd1306_handle_t dev = test_panel_create(&transport);
+    char path[] = "/tmp/ssd1306_mem_XXXXXX";
+    uint8_t header[16];
+    uint8_t row[SSD1306_WIDTH / 8];
+    
+    ssd1306_draw_point(dev, 0, 0, 1);
+    ssd1306_draw_point(dev, 9, 1, 1);
+    ssd1306_refresh_gram(dev);
+    
+    int fd = mkstemp(path);
+    TEST_CHECK(fd >= 0);
+    TEST_CHECK_EQ(ESP_OK, ssd1306_mem_write_pbm(transport, path));
+    
+    FILE *f = fopen(path, "rb");
+    TEST_CHECK(f != NULL);
+    if (f) {
+        const char *expected = "P4\n128 64\n";
+        TEST_CHECK_EQ(strlen(expected), fread(header, 1, strlen(expected), f));
+        TEST_CHECK(memcmp(header, expected, strlen(expected)) == 0);
+        
+        // Lit pixels are white, i.e. 0 bits
+        TEST_CHECK_EQ(sizeof(row), fread(row, 1, sizeof(row), f));
+        TEST_CHECK_EQ(0x7F, row[0]);
+        TEST_CHECK_EQ(0xFF, row[1]);
+        TEST_CHECK_EQ(sizeof(row), fread(row, 1, sizeof(row), f));
+        TEST_CHECK_EQ(0xBF, row[1]);
+        fclose(f);
+    }
+    remove(path);
+    ssd1306_delete(dev);
+}
+
+int main(void)
+{
+    RUN_TEST(test_window_wraps_within_ranges);
+    RUN_TEST(test_display_state_commands);
+    RUN_TEST(test_bad_control_byte);
+    RUN_TEST(test_bus_statistics);
+    RUN_TEST(test_pbm_output);
+    return test_summary();
+}
@@ -0,0 +1,192 @@
+#include "test_common.h"
+
+// Dirty tracking, batched transfers, asynchronous refresh and sleep, checked
+// against the emulated panel
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+
+static ssd1306_mem_stats_t refresh_and_count(void)
+{
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_mem_reset_stats(s_transport);
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_get_stats(s_transport, &stats);
+    return stats;
+}
+
+static void test_init_is_one_transfer(void)
+{
+    ssd1306_transport_t *transport;
+    ssd1306_mem_stats_t stats;
+    
+    TEST_CHECK_EQ(ESP_OK, ssd1306_new_transport_mem(400000, &transport));
+    ssd1306_handle_t dev = ssd1306_create_with_transport(transport);
+    TEST_CHECK(dev != NULL);
+    TEST_CHECK_EQ(ESP_OK, ssd1306_init(dev));
+    ssd1306_mem_get_stats(transport, &stats);
+    TEST_CHECK_EQ(1, stats.transfers);
+    TEST_CHECK_EQ(0, stats.data_bytes);
+    
+    // The panel content is unknown after init, so the first refresh sends it all
+    ssd1306_mem_reset_stats(transport);
+    ssd1306_refresh_gram(dev);
+    ssd1306_mem_get_stats(transport, &stats);
+    TEST_CHECK_EQ(SSD1306_BUFFER_SIZE, stats.data_bytes);
+    TEST_CHECK_EQ(2, stats.transfers);
+    ssd1306_delete(dev);
+}
+
+static void test_only_changed_columns_are_sent(void)
+{
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_clear_screen(s_dev, 0);
+    refresh_and_count();
+    
+    // One pixel: a window command and one data byte
+    ssd1306_draw_point(s_dev, 17, 3, 1);
+    stats = refresh_and_count();
+    TEST_CHECK_EQ(2, stats.transfers);
+    TEST_CHECK_EQ(1, stats.data_bytes);
+    TEST_CHECK_EQ(9, stats.bytes);
+    TEST_CHECK(ssd1306_mem_get_pixel(s_transport, 17, 3));
+    
+    // Drawing what is already there changes nothing
+    ssd1306_draw_point(s_dev, 17, 3, 1);
+    stats = refresh_and_count();
+    TEST_CHECK_EQ(0, stats.transfers);
+    
+    // Clearing only sends the columns that were lit
+    ssd1306_clear_screen(s_dev, 0);
+    stats = refresh_and_count();
+    TEST_CHECK_EQ(1, stats.data_bytes);
+    ssd1306_clear_screen(s_dev, 0);
+    stats = refresh_and_count();
+    TEST_CHECK_EQ(0, stats.transfers);
+    
+    // Pages with the same dirty columns merge into one window
+    ssd1306_draw_point(s_dev, 40, 8, 1);
+    ssd1306_draw_point(s_dev, 41, 17, 1);
+    ssd1306_draw_point(s_dev, 40, 16, 1);
+    ssd1306_draw_point(s_dev, 41, 9, 1);
+    stats = refresh_and_count();
+    TEST_CHECK_EQ(2, stats.transfers);
+    TEST_CHECK_EQ(4, stats.data_bytes);
+    
+    // Different ranges are separate windows covering only their columns
+    ssd1306_draw_point(s_dev, 0, 0, 1);
+    ssd1306_draw_point(s_dev, 127, 63, 1);
+    ssd1306_draw_point(s_dev, 100, 63, 1);
+    stats = refresh_and_count();
+    TEST_CHECK_EQ(4, stats.transfers);
+    TEST_CHECK_EQ(1 + 28, stats.data_bytes);
+    
+    ssd1306_invalidate(s_dev);
+    stats = refresh_and_count();
+    TEST_CHECK_EQ(SSD1306_BUFFER_SIZE, stats.data_bytes);
+}
+
+static void test_random_frames_match_model(void)
+{
+    test_image_t model = { 0 };
+    
+    srand(1);
+    ssd1306_clear_screen(s_dev, 0);
+    for (int frame = 0; frame < 500; frame++) {
+        int points = 1 + rand() % 40;
+        for (int i = 0; i < points; i++) {
+            int x = rand() % SSD1306_WIDTH;
+            int y = rand() % SSD1306_HEIGHT;
+            bool on = rand() % 3 != 0;
+            ssd1306_draw_point(s_dev, x, y, on);
+            test_image_set(&model, x, y, on);
+        }
+        ssd1306_refresh_gram(s_dev);
+        if (test_panel_diff(s_transport, &model) != 0) {
+            TEST_CHECK(!"panel differs from model");
+            break;
+        }
+    }
+}
+
+static void test_async_refresh(void)
+{
+    ssd1306_transport_t *transport;
+    ssd1306_handle_t dev = test_panel_create(&transport);
+    test_image_t model = { 0 };
+    ssd1306_flush_stats_t flush;
+    ssd1306_mem_stats_t stats;
+    
+    TEST_CHECK_EQ(ESP_OK, ssd1306_enable_async(dev, 5));
+    
+    // Frames are rendered while the previous one may still be on the wire
+    srand(2);
+    for (int frame = 0; frame < 300; frame++) {
+        for (int i = 0; i < 20; i++) {
+            int x = rand() % SSD1306_WIDTH;
+            int y = rand() % SSD1306_HEIGHT;
+            bool on = rand() & 1;
+            ssd1306_draw_point(dev, x, y, on);
+            test_image_set(&model, x, y, on);
+        }
+        TEST_CHECK_EQ(ESP_OK, ssd1306_refresh_gram_async(dev));
+    }
+    TEST_CHECK_EQ(ESP_OK, ssd1306_wait_flush(dev, 1000));
+    TEST_CHECK_EQ(0, test_panel_diff(transport, &model));
+    
+    // The driver's own count of the last frame matches the bus
+    ssd1306_mem_reset_stats(transport);
+    ssd1306_fill_rect(dev, 10, 8, 20, 16, 1);
+    TEST_CHECK_EQ(ESP_OK, ssd1306_refresh_gram_async(dev));
+    TEST_CHECK_EQ(ESP_OK, ssd1306_wait_flush(dev, 1000));
+    ssd1306_mem_get_stats(transport, &stats);
+    TEST_CHECK_EQ(ESP_OK, ssd1306_get_flush_stats(dev, &flush));
+    TEST_CHECK_EQ(stats.bytes, flush.bytes);
+    TEST_CHECK_EQ(40, flush.dirty_columns);
+    
+    ssd1306_delete(dev);
+}
+
+static void test_sleep_holds_changes(void)
+{
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_clear_screen(s_dev, 0);
+    refresh_and_count();
+    TEST_CHECK_EQ(ESP_OK, ssd1306_set_sleep(s_dev, true));
+    TEST_CHECK(ssd1306_is_sleeping(s_dev));
+    
+    ssd1306_mem_reset_stats(s_transport);
+    for (int i = 0; i < 100; i++) {
+        ssd1306_draw_point(s_dev, i, i % SSD1306_HEIGHT, 1);
+        ssd1306_refresh_gram(s_dev);
+    }
+    ssd1306_mem_get_stats(s_transport, &stats);
+    TEST_CHECK_EQ(0, stats.transfers);
+    
+    // Wake-up sends what changed meanwhile
+    TEST_CHECK_EQ(ESP_OK, ssd1306_set_sleep(s_dev, false));
+    TEST_CHECK(ssd1306_mem_get_pixel(s_transport, 99, 99 % SSD1306_HEIGHT));
+    ssd1306_mem_get_stats(s_transport, &stats);
+    TEST_CHECK(stats.data_bytes >= 100);
+}
+
+int main(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    if (s_dev == NULL) {
+        fprintf(stderr, "panel setup failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    RUN_TEST(test_init_is_one_transfer);
+    RUN_TEST(test_only_changed_columns_are_sent);
+    RUN_TEST(test_random_frames_match_model);
+    RUN_TEST(test_async_refresh);
+    RUN_TEST(test_sleep_holds_changes);
+    
+    ssd1306_delete(s_dev);
+    return test_summary();
+}
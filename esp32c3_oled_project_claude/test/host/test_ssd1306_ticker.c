@@ -0,0 +1,192 @@
+#include "test_common.h"
+
+// Start-line ticker and hardware scroll, checked transfer by transfer on the
+// emulated panel
+
+#define MAX_TRANSFERS   16
+
+// Memory transport that keeps a copy of each transfer since the last reset
+typedef struct {
+    ssd1306_transport_t base;
+    ssd1306_transport_t *panel;
+    int count;
+    size_t len[MAX_TRANSFERS];
+    uint8_t data[MAX_TRANSFERS][SSD1306_BUFFER_SIZE + 1];
+} recording_transport_t;
+
+static recording_transport_t *s_rec;
+static ssd1306_handle_t s_dev;
+
+static esp_err_t recording_transmit(ssd1306_transport_t *transport, const uint8_t *data, size_t len)
+{
+    recording_transport_t *rec = (recording_transport_t *)transport;
+    
+    if (rec->count < MAX_TRANSFERS) {
+        rec->len[rec->count] = len;
+        memcpy(rec->data[rec->count], data, len);
+    }
+    rec->count++;
+    return rec->panel->transmit(rec->panel, data, len);
+}
+
+static void recording_del(ssd1306_transport_t *transport)
+{
+    recording_transport_t *rec = (recording_transport_t *)transport;
+    
+    rec->panel->del(rec->panel);
+    free(rec);
+}
+
+static void setup(void)
+{
+    s_rec = calloc(1, sizeof(*s_rec));
+    ssd1306_new_transport_mem(400000, &s_rec->panel);
+    s_rec->base.transmit = recording_transmit;
+    s_rec->base.del = recording_del;
+    s_dev = ssd1306_create_with_transport(&s_rec->base);
+    ssd1306_init(s_dev);
+    ssd1306_refresh_gram(s_dev);
+    s_rec->count = 0;
+}
+
+static void teardown(void)
+{
+    ssd1306_delete(s_dev);
+}
+
+// Ticker content: page seq of an endless stream, hashed so no row repeats the one it replaces
+static uint8_t content_byte(uint32_t seq, int x)
+{
+    uint32_t hash = (x + 1) * 2654435761u + (seq + 1) * 40503u;
+    
+    hash ^= hash >> 15;
+    return (hash * 2246822519u) >> 24;
+}
+
+static void content_fill(uint8_t page[SSD1306_WIDTH], uint32_t seq, void *arg)
+{
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        page[x] = content_byte(seq, x);
+    }
+}
+
+static bool content_pixel(uint32_t row, int x)
+{
+    return (content_byte(row / 8, x) >> (row % 8)) & 1;
+}
+
+// After steps steps the bottom screen row shows content row steps - 1
+static int screen_diff(uint32_t steps)
+{
+    test_image_t model = { 0 };
+    
+    for (int y = 0; y < SSD1306_HEIGHT; y++) {
+        int64_t row = (int64_t)steps - SSD1306_HEIGHT + y;
+        for (int x = 0; x < SSD1306_WIDTH && row >= 0; x++) {
+            test_image_set(&model, x, y, content_pixel(row, x));
+        }
+    }
+    return test_panel_diff(s_rec->panel, &model);
+}
+
+static void test_step_sends_one_row(void)
+{
+    setup();
+    TEST_CHECK_EQ(ESP_OK, ssd1306_ticker_start(s_dev, content_fill, NULL));
+    
+    for (int step = 0; step < 3 * SSD1306_HEIGHT; step++) {
+        s_rec->count = 0;
+        TEST_CHECK_EQ(ESP_OK, ssd1306_ticker_step(s_dev));
+        
+        // Page window, the changed columns of that page, then the start line
+        TEST_CHECK_EQ(3, s_rec->count);
+        if (s_rec->count != 3) {
+            break;
+        }
+        const uint8_t *window = s_rec->data[0];
+        TEST_CHECK_EQ(7, s_rec->len[0]);
+        TEST_CHECK_EQ(SSD1306_CONTROL_CMD_STREAM, window[0]);
+        TEST_CHECK_EQ(0x22, window[4]);
+        TEST_CHECK_EQ(step % SSD1306_HEIGHT / 8, window[5]);
+        TEST_CHECK_EQ(window[5], window[6]);
+        TEST_CHECK_EQ(SSD1306_CONTROL_DATA_STREAM, s_rec->data[1][0]);
+        TEST_CHECK(s_rec->len[1] <= 1 + SSD1306_WIDTH);
+        
+        // The start line wraps at the panel height
+        TEST_CHECK_EQ(2, s_rec->len[2]);
+        TEST_CHECK_EQ(SSD1306_CONTROL_CMD_STREAM, s_rec->data[2][0]);
+        TEST_CHECK_EQ(0x40 | ((step + 1) % SSD1306_HEIGHT), s_rec->data[2][1]);
+    }
+    TEST_CHECK_EQ(0, screen_diff(3 * SSD1306_HEIGHT));
+    teardown();
+}
+
+static void test_stop_keeps_image(void)
+{
+    const uint32_t steps = SSD1306_HEIGHT + 21;
+    uint8_t scrolled[SSD1306_BUFFER_SIZE];
+    uint8_t stopped[SSD1306_BUFFER_SIZE];
+    
+    setup();
+    ssd1306_ticker_start(s_dev, content_fill, NULL);
+    for (uint32_t step = 0; step < steps; step++) {
+        ssd1306_ticker_step(s_dev);
+    }
+    TEST_CHECK_EQ(0, screen_diff(steps));
+    ssd1306_mem_get_frame(s_rec->panel, scrolled);
+    
+    // The start line goes back to 0 and the rotated buffer is sent in full
+    s_rec->count = 0;
+    TEST_CHECK_EQ(ESP_OK, ssd1306_ticker_stop(s_dev));
+    TEST_CHECK_EQ(1, s_rec->count);
+    TEST_CHECK_EQ(0x40, s_rec->data[0][1]);
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_get_frame(s_rec->panel, stopped);
+    TEST_CHECK(memcmp(scrolled, stopped, sizeof(stopped)) == 0);
+    
+    // Drawing works in screen coordinates again
+    ssd1306_draw_point(s_dev, 5, 0, !ssd1306_mem_get_pixel(s_rec->panel, 5, 0));
+    bool before = ssd1306_mem_get_pixel(s_rec->panel, 5, 0);
+    ssd1306_refresh_gram(s_dev);
+    TEST_CHECK(before != ssd1306_mem_get_pixel(s_rec->panel, 5, 0));
+    teardown();
+}
+
+static void test_hardware_scroll(void)
+{
+    static const uint8_t horizontal[] = {
+        SSD1306_CONTROL_CMD_STREAM, 0x2E, 0x27, 0x00, 2, 5, 4, 0x00, 0xFF, 0x2F,
+    };
+    
+    setup();
+    TEST_CHECK_EQ(ESP_OK, ssd1306_start_scroll(s_dev, SSD1306_SCROLL_LEFT, 2, 4, 5, 0));
+    TEST_CHECK_EQ(1, s_rec->count);
+    TEST_CHECK_EQ(sizeof(horizontal), s_rec->len[0]);
+    TEST_CHECK(memcmp(horizontal, s_rec->data[0], sizeof(horizontal)) == 0);
+    
+    // GRAM is not written while the panel scrolls, and no ticker can start
+    s_rec->count = 0;
+    ssd1306_fill_rect(s_dev, 0, 0, 10, 10, 1);
+    ssd1306_refresh_gram(s_dev);
+    TEST_CHECK_EQ(0, s_rec->count);
+    TEST_CHECK_EQ(ESP_ERR_INVALID_STATE, ssd1306_ticker_start(s_dev, content_fill, NULL));
+    
+    // Stopping resends the whole frame
+    TEST_CHECK_EQ(ESP_OK, ssd1306_stop_scroll(s_dev));
+    TEST_CHECK_EQ(1, s_rec->count);
+    TEST_CHECK_EQ(0x2E, s_rec->data[0][1]);
+    s_rec->count = 0;
+    ssd1306_refresh_gram(s_dev);
+    TEST_CHECK_EQ(2, s_rec->count);
+    TEST_CHECK_EQ(1 + SSD1306_BUFFER_SIZE, s_rec->len[1]);
+    TEST_CHECK(ssd1306_mem_get_pixel(s_rec->panel, 9, 9));
+    teardown();
+}
+
+int main(void)
+{
+    RUN_TEST(test_step_sends_one_row);
+    RUN_TEST(test_stop_keeps_image);
+    RUN_TEST(test_hardware_scroll);
+    return test_summary();
+}
@@ -0,0 +1,77 @@
+#include <math.h>
+#include "test_common.h"
+#include "trig.h"
+
+// Table trigonometry against libm over every binary angle
+
+static void test_sin_error_bound(void)
+{
+    double worst = 0;
+    int worst_angle = 0;
+    
+    for (int angle = 0; angle < 65536; angle++) {
+        double exact = sin(angle / TRIG_ANGLE_PER_RAD) * TRIG_ONE;
+        double error = fabs(trig_sin(angle) - exact);
+        if (error > worst) {
+            worst = error;
+            worst_angle = angle;
+        }
+    }
+    
+    // The header promises 4 LSB
+    if (worst > 4.0) {
+        fprintf(stderr, "  worst error %.2f LSB at angle %d\n", worst, worst_angle);
+    }
+    TEST_CHECK(worst <= 4.0);
+}
+
+static void test_exact_points_and_range(void)
+{
+    TEST_CHECK_EQ(0, trig_sin(0));
+    TEST_CHECK_EQ(TRIG_ONE, trig_sin(16384));
+    TEST_CHECK_EQ(0, trig_sin(32768));
+    TEST_CHECK_EQ(-TRIG_ONE, trig_sin(49152));
+    
+    for (int angle = 0; angle < 65536; angle++) {
+        int16_t s = trig_sin(angle);
+        TEST_CHECK(s >= -TRIG_ONE && s <= TRIG_ONE);
+        TEST_CHECK_EQ(trig_sin((uint16_t)(angle + 16384)), trig_cos(angle));
+        // Odd symmetry
+        TEST_CHECK_EQ(-s, trig_sin((uint16_t)-angle));
+    }
+}
+
+static void test_mul_rounds_down(void)
+{
+    TEST_CHECK_EQ(99, trig_mul(100, TRIG_ONE));
+    TEST_CHECK_EQ(-100, trig_mul(-100, TRIG_ONE));
+    TEST_CHECK_EQ(50, trig_mul(100, 16384));
+    TEST_CHECK_EQ(-1, trig_mul(1, -1));
+    TEST_CHECK_EQ(0, trig_mul(1, 1));
+}
+
+// n steps of TRIG_PHASE(x) land where n * x radians does
+static void test_phase_accumulates(void)
+{
+    uint32_t step = TRIG_PHASE(0.1);
+    uint32_t phase = 0;
+    
+    for (int n = 1; n <= 10000; n++) {
+        phase += step;
+        double exact = sin(n * 0.1) * TRIG_ONE;
+        if (fabs(trig_sin(phase >> 16) - exact) > 8.0) {
+            fprintf(stderr, "  step %d drifted\n", n);
+            TEST_CHECK(!"phase drift");
+            break;
+        }
+    }
+}
+
+int main(void)
+{
+    RUN_TEST(test_sin_error_bound);
+    RUN_TEST(test_exact_points_and_range);
+    RUN_TEST(test_mul_rounds_down);
+    RUN_TEST(test_phase_accumulates);
+    return test_summary();
+}
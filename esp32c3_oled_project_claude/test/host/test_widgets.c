@@ -0,0 +1,169 @@
+#include "test_common.h"
+#include "widgets.h"
+
+// Retained widgets: unchanged bindings draw nothing, a changed binding redraws
+// only its own box, and bars and icons draw the expected pixels
+
+static ssd1306_transport_t *s_transport;
+static ssd1306_handle_t s_dev;
+
+static ssd1306_mem_stats_t refresh_and_count(void)
+{
+    ssd1306_mem_stats_t stats;
+    
+    ssd1306_mem_reset_stats(s_transport);
+    ssd1306_refresh_gram(s_dev);
+    ssd1306_mem_get_stats(s_transport, &stats);
+    return stats;
+}
+
+static void setup(void)
+{
+    s_dev = test_panel_create(&s_transport);
+    ssd1306_clear_screen(s_dev, 0);
+    refresh_and_count();
+}
+
+static void teardown(void)
+{
+    ssd1306_delete(s_dev);
+}
+
+static void test_same_binding_draws_nothing(void)
+{
+    widget_t widgets[] = {
+        { .type = WIDGET_LABEL, .x = 0, .y = 0, .width = 64 },
+        { .type = WIDGET_VALUE, .x = 0, .y = 16, .width = 64, .fmt = "%ld C" },
+        { .type = WIDGET_BAR, .x = 0, .y = 40, .width = 64, .height = 8, .min = 0, .max = 100 },
+    };
+    widget_scene_t scene = { widgets, 3 };
+    
+    setup();
+    widget_set_text(&widgets[0], "Hello");
+    widget_set_value(&widgets[1], 23);
+    widget_set_value(&widgets[2], 40);
+    TEST_CHECK_EQ(3, widget_scene_render(s_dev, &scene));
+    TEST_CHECK(refresh_and_count().data_bytes > 0);
+    
+    TEST_CHECK(!widget_set_text(&widgets[0], "Hello"));
+    TEST_CHECK(!widget_set_value(&widgets[1], 23));
+    TEST_CHECK(!widget_set_value(&widgets[2], 40));
+    TEST_CHECK_EQ(0, widget_scene_render(s_dev, &scene));
+    TEST_CHECK_EQ(0, refresh_and_count().transfers);
+    
+    // Text past WIDGET_TEXT_MAX - 1 compares on the part that is kept
+    widget_set_text(&widgets[0], "0123456789012345678901234567");
+    widget_scene_render(s_dev, &scene);
+    TEST_CHECK(!widget_set_text(&widgets[0], "01234567890123456789012XYZ"));
+    teardown();
+}
+
+static void test_change_redraws_own_box(void)
+{
+    widget_t widgets[] = {
+        { .type = WIDGET_VALUE, .x = 8, .y = 20, .width = 40 },
+        { .type = WIDGET_VALUE, .x = 64, .y = 20, .width = 40 },
+    };
+    widget_scene_t scene = { widgets, 2 };
+    uint8_t before[SSD1306_BUFFER_SIZE];
+    uint8_t after[SSD1306_BUFFER_SIZE];
+    
+    setup();
+    widget_set_value(&widgets[0], 88);
+    widget_set_value(&widgets[1], 88);
+    widget_scene_render(s_dev, &scene);
+    
+    // Pixels right above and below the box share its pages and must survive the clear
+    ssd1306_draw_hline(s_dev, 0, 19, SSD1306_WIDTH, 1);
+    ssd1306_draw_hline(s_dev, 0, 36, SSD1306_WIDTH, 1);
+    refresh_and_count();
+    ssd1306_mem_get_frame(s_transport, before);
+    
+    TEST_CHECK(widget_set_value(&widgets[0], 11));
+    TEST_CHECK_EQ(1, widget_scene_render(s_dev, &scene));
+    ssd1306_mem_stats_t stats = refresh_and_count();
+    ssd1306_mem_get_frame(s_transport, after);
+    
+    // Only columns 8..47 of pages 2..4 may change
+    int changed = 0;
+    for (int i = 0; i < SSD1306_BUFFER_SIZE; i++) {
+        int page = i / SSD1306_WIDTH, x = i % SSD1306_WIDTH;
+        if (before[i] != after[i]) {
+            changed++;
+            TEST_CHECK(page >= 2 && page <= 4 && x >= 8 && x < 48);
+        }
+    }
+    TEST_CHECK(changed > 0);
+    TEST_CHECK(stats.data_bytes <= 3 * 40);
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        TEST_CHECK(ssd1306_mem_get_pixel(s_transport, x, 19));
+        TEST_CHECK(ssd1306_mem_get_pixel(s_transport, x, 36));
+    }
+    teardown();
+}
+
+static void test_bar_fill(void)
+{
+    static const int32_t values[] = { 0, 50, 100, -20, 130 };
+    static const int fills[] = { 0, 25, 50, 0, 50 };
+    widget_t bar = { .type = WIDGET_BAR, .x = 10, .y = 21, .width = 52, .height = 9, .min = 0, .max = 100 };
+    widget_scene_t scene = { &bar, 1 };
+    
+    setup();
+    bar.value = -1;
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        test_image_t model = { 0 };
+        
+        widget_set_value(&bar, values[i]);
+        TEST_CHECK_EQ(1, widget_scene_render(s_dev, &scene));
+        refresh_and_count();
+        
+        // Outline, then the inner 50 columns filled from the left
+        for (int x = 10; x < 62; x++) {
+            for (int y = 21; y < 30; y++) {
+                bool edge = x == 10 || x == 61 || y == 21 || y == 29;
+                test_image_set(&model, x, y, edge || x - 11 < fills[i]);
+            }
+        }
+        TEST_CHECK_EQ(0, test_panel_diff(s_transport, &model));
+    }
+    teardown();
+}
+
+static void test_icon_by_value(void)
+{
+    static const uint8_t empty[8] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    static const uint8_t full[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    static const ssd1306_bitmap_t icons[] = {
+        { .width = 8, .height = 8, .data = empty },
+        { .width = 8, .height = 8, .data = full },
+    };
+    widget_t icon = { .type = WIDGET_ICON, .x = 40, .y = 12, .width = 8, .height = 8,
+                      .icons = icons, .icon_count = 2 };
+    widget_scene_t scene = { &icon, 1 };
+    
+    setup();
+    widget_set_value(&icon, 1);
+    widget_scene_render(s_dev, &scene);
+    refresh_and_count();
+    TEST_CHECK(ssd1306_mem_get_pixel(s_transport, 40, 12));
+    TEST_CHECK(ssd1306_mem_get_pixel(s_transport, 47, 19));
+    TEST_CHECK(!ssd1306_mem_get_pixel(s_transport, 48, 12));
+    
+    // An index past the table clears the box and draws nothing
+    widget_set_value(&icon, 2);
+    widget_scene_render(s_dev, &scene);
+    refresh_and_count();
+    TEST_CHECK(!ssd1306_mem_get_pixel(s_transport, 40, 12));
+    TEST_CHECK(!ssd1306_mem_get_pixel(s_transport, 47, 19));
+    teardown();
+}
+
+int main(void)
+{
+    RUN_TEST(test_same_binding_draws_nothing);
+    RUN_TEST(test_change_redraws_own_box);
+    RUN_TEST(test_bar_fill);
+    RUN_TEST(test_icon_by_value);
+    return test_summary();
+}